@@ -0,0 +1,40 @@
+/*! @file arena.h
+    @brief 
+    Contains declarations of the bump allocating arena used for
+    allocating all the nodes of a container with O(1) bulk release
+*/
+#pragma once
+
+#include <stddef.h>
+
+#define ARENA_CHUNK_SIZE	(64 * 1024)	///< Default arena chunk size
+#define ARENA_ALIGN		16		///< Alignment of every arena alloc
+
+/// Arena chunk, memory is bump allocated from data
+typedef struct arena_chunk {
+	struct arena_chunk *nxt;	///< Previously filled chunk
+	size_t size;			///< Usable bytes in chunk
+	size_t used;			///< Bytes handed out of chunk
+} t_arena_chunk;
+
+/// Arena struct defn
+typedef struct arena {
+	char *name;			///< Arena instance name
+	size_t chunk_size;		///< Size of each new chunk
+	size_t total;			///< Total bytes handed out
+	t_arena_chunk *chunk;		///< Current chunk (head of chunk list)
+	t_arena_chunk *tail;		///< First chunk made (end of chunk list), lets arenas merge in O(1)
+} t_arena;
+
+/// Alloc from arena when one is given else from tagged memory
+#define arena_get_mem(a, nmemb, size) \
+	((a) != NULL ? arena_alloc((a), (nmemb), (size)) : get_mem((nmemb), (size)))
+
+/// Free tagged memory, arena memory is only released with the arena
+#define arena_free_mem(a, mem_addr) \
+	do { if ((a) == NULL) free_mem(mem_addr); } while (0)
+
+t_arena *create_arena(char *name, size_t chunk_size);
+void *arena_alloc(t_arena *a, size_t nmemb, size_t size);
+void arena_merge(t_arena *dst, t_arena *src);
+void destroy_arena(t_arena *a);
@@ -8,7 +8,9 @@
 #include "typedefs.h"
 #include "logger.h"
 #include "memory_manager.h"
+#include "arena.h"
 #include "fault_manager.h"
+#include "profiler.h"
 #include "generic_def.h"
 
 /*! data params struct to be passed to all data structures
@@ -31,8 +33,17 @@ typedef struct data_params {
 
 	f_get_idx get_idx;              ///< Routine used for getting elem in given array index
 	f_print print_data;		///< Routine used for printing elem data
+	f_hash hash;			///< Routine used for hashing elem data (hash based containers)
+
+	size_t elem_size;		///< Bytes of an elem stored inline in the container (0 stores t_gen pointers)
+
+	// capacity policy of array based containers (heap, stack, queue), growing x2 when
+	// full and halving at 1/shrink_div occupancy (>= 4) keeps insert/remove amortised O(1)
+	bool auto_grow;			///< Array doubles when full instead of dropping data
+	int shrink_div;			///< Array halves when count drops to capacity/shrink_div (below 2 never shrinks)
 } t_dparams;
 
 void init_data_params(t_dparams*, e_data_types);
 void dummy_free(void *mem_addr, char *file, int line);
+void swap_bytes(t_gen x, t_gen y, size_t size);
 
@@ -112,6 +112,25 @@
 						return tmp;\
 					}
 
+/// Three way compare of numeric keys, used as CMP of the type specialised
+/// containers (DEFINE_HEAP, DEFINE_SORT, DEFINE_AVL) which expand it inline
+#define CMP_NUM(x, y)	(((x) > (y)) - ((x) < (y)))
+
+/// Three way compare of string keys for the type specialised containers
+#define CMP_STR(x, y)	strcmp((x), (y))
+
+/// Final mix of a hash (murmur3 fmix64), spreads every input bit over all
+/// the output bits so both the low and the high bits can be used
+static inline uint64_t hash_mix(uint64_t h)
+{
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ULL;
+	h ^= h >> 33;
+	return h;
+}
+
 /// Below routines defined as reference for basic datatypes
 e_cmpr compare_char(t_gen,t_gen);
 e_cmpr compare_int(t_gen,t_gen);
@@ -157,6 +176,10 @@ t_gen get_idx_char_cpy(t_gen,int);
 t_gen get_idx_int_cpy(t_gen,int);
 t_gen get_idx_float_cpy(t_gen,int);
 
+uint64_t hash_int(t_gen);
+uint64_t hash_float(t_gen);
+uint64_t hash_string(t_gen);
+
 e_cmpr gen_cmpr_idx(t_gen x, int idx1, int idx2);
 void gen_swp_idx(t_gen x, int idx1, int idx2);
 void gen_cpy_idx(t_gen x, int idx1, t_gen data);
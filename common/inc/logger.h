@@ -11,16 +11,137 @@
 #define __LOG_TRACE__		4		///< log level Trace
 
 #define MAX_LOG_LEVELS		5
-#define MAX_MODULES		4
+#define MAX_MODULES		32		///< Modules with their own level mask, the rest share slot 0
 #define	COMMON_MODULE		1
 
-#define LOG_ERROR(mod,fmt, args...)			app_log(mod, __LOG_ERROR__, NULL, fmt, ##args)
-#define LOG_WARN(mod, fmt, args...)			app_log(mod, __LOG_WARN__, NULL, fmt, ##args)
-#define LOG_INFO(mod, fmt, args...)			app_log(mod, __LOG_INFO__, NULL, fmt, ##args)
-#define LOG_DEBUG(mod, fmt, args...)			app_log(mod, __LOG_DEBUG__, NULL, fmt, ##args)
-#define LOG_TRACE_IN(mod, fmt, args...)		app_log(mod, __LOG_TRACE__, NULL, "[++%s:%4d]" fmt"\n", __func__, __LINE__, ##args)
-#define LOG_TRACE_OUT(mod, fmt, args...)		app_log(mod, __LOG_TRACE__, NULL, "[--%s:%4d]" fmt"\n", __func__, __LINE__, ##args)
+/// Most verbose level compiled in, calls above it are compiled out
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL	__LOG_TRACE__
+#endif
+
+/// Log a message if its module has the level on, args are only evaluated then
+/// the module id and site id (binary mode) are looked up once per call site and cached in statics
+#define LOG_AT(mod, level, fmt, args...)	do {							\
+	static int log_mod_ = -1, log_site_ = -1;							\
+	if (log_enabled(&log_mod_, mod, level)) {							\
+		app_log_site(&log_site_, mod, level, fmt, ##args);					\
+	}												\
+} while (0)
+
+/// Compiled out log call, args are still type checked but never evaluated
+#define LOG_NOP(mod, level, fmt, args...)	do {							\
+	if (0) {											\
+		app_log(mod, level, NULL, fmt, ##args);							\
+	}												\
+} while (0)
+
+#define LOG_ERROR(mod,fmt, args...)			LOG_AT(mod, __LOG_ERROR__, fmt, ##args)
+
+#if LOG_COMPILE_LEVEL >= __LOG_WARN__
+#define LOG_WARN(mod, fmt, args...)			LOG_AT(mod, __LOG_WARN__, fmt, ##args)
+#else
+#define LOG_WARN(mod, fmt, args...)			LOG_NOP(mod, __LOG_WARN__, fmt, ##args)
+#endif
+
+#if LOG_COMPILE_LEVEL >= __LOG_INFO__
+#define LOG_INFO(mod, fmt, args...)			LOG_AT(mod, __LOG_INFO__, fmt, ##args)
+#else
+#define LOG_INFO(mod, fmt, args...)			LOG_NOP(mod, __LOG_INFO__, fmt, ##args)
+#endif
+
+#if LOG_COMPILE_LEVEL >= __LOG_DEBUG__
+#define LOG_DEBUG(mod, fmt, args...)			LOG_AT(mod, __LOG_DEBUG__, fmt, ##args)
+#else
+#define LOG_DEBUG(mod, fmt, args...)			LOG_NOP(mod, __LOG_DEBUG__, fmt, ##args)
+#endif
+
+#if LOG_COMPILE_LEVEL >= __LOG_TRACE__
+#define LOG_TRACE_IN(mod, fmt, args...)		LOG_AT(mod, __LOG_TRACE__, "[++%s:%4d]" fmt"\n", __func__, __LINE__, ##args)
+#define LOG_TRACE_OUT(mod, fmt, args...)		LOG_AT(mod, __LOG_TRACE__, "[--%s:%4d]" fmt"\n", __func__, __LINE__, ##args)
+#else
+#define LOG_TRACE_IN(mod, fmt, args...)		LOG_NOP(mod, __LOG_TRACE__, "[++%s:%4d]" fmt"\n", __func__, __LINE__, ##args)
+#define LOG_TRACE_OUT(mod, fmt, args...)		LOG_NOP(mod, __LOG_TRACE__, "[--%s:%4d]" fmt"\n", __func__, __LINE__, ##args)
+#endif
+
+#define LOG_RING_SLOTS		512		///< Records in the ring of each thread (power of 2)
+#define LOG_REC_SIZE		256		///< Bytes of a record, args beyond this are cut
+#define LOG_NAME_LEN		16		///< Module and prefix are copied up to this length
+#define LOG_POLL_NS		1000000		///< Background thread sleep when all rings are empty
+
+#define LOG_SITE_MAX		4096		///< Call sites that can be registered for binary mode
+#define LOG_BIN_MAGIC		"CEVLOG01"	///< Magic at the start of a binary log file
+#define LOG_BIN_SIZE		(64UL << 20)	///< Default size of a binary log file
+#define LOG_BIN_FILE		"log.bin"	///< Binary log file used when built with LOG_BINARY
+#define LOG_BIN_SITE_DEF	0x80000000U	///< Set in site of an entry defining the site
+
+/// Header at the start of a binary log file
+typedef struct log_bin_hdr {
+	char magic[8];				///< LOG_BIN_MAGIC
+	uint64_t size;				///< Bytes of the file
+	uint64_t used;				///< Bytes reserved (header included), bumped atomically by writers
+	uint64_t dropped;			///< Messages lost as the file was full
+} t_log_bin_hdr;
+
+/// Entry of a binary log file (8 byte aligned), the payload follows it
+/// site definition: int32 level, char module[LOG_NAME_LEN], NUL terminated format
+/// message: uint64 time stamp in ns, args packed in format order
+typedef struct log_bin_entry {
+	uint32_t len;				///< Bytes of entry and payload (0 ends the log)
+	uint32_t site;				///< Site id, LOG_BIN_SITE_DEF set if entry defines the site
+} t_log_bin_entry;
+
+/// Log message queued in async mode, args are kept raw and formatted by the background thread
+typedef struct log_rec {
+	uint64_t ts_ns;				///< Wall clock time of the call
+	const char *format;			///< Format string (string literal at the call site)
+	int level;				///< Log level
+	int args_len;				///< Bytes used in args
+	char module[LOG_NAME_LEN];		///< Module name
+	char prefix[LOG_NAME_LEN];		///< Prefix (empty if none)
+	char args[LOG_REC_SIZE - 2 * LOG_NAME_LEN - 24];	///< Args packed in format order
+} t_log_rec;
+
+/// Single producer single consumer ring of a thread, only the owner thread writes head
+typedef struct log_ring {
+	size_t head;				///< Next slot written by owner thread
+	size_t tail;				///< Next slot read by background thread
+	size_t dropped;				///< Records lost as ring was full
+	size_t reported;			///< Drops already reported by background thread
+	bool owned;				///< Ring is held by a live thread
+	struct log_ring *nxt;			///< Next ring, rings are never freed but reused
+	t_log_rec rec[LOG_RING_SLOTS];		///< Records
+} t_log_ring;
+
+extern uint8_t module_logs[MAX_MODULES];
 
 void logger_init();
+void logger_finit(void);
+int log_module_id(char *module);
+void logger_set_level(char *module, int level, bool on);
+int logger_start_async(void);
+void logger_fault_drain(void);
+void logger_set_file(FILE *fp);
+size_t logger_dropped(void);
+int logger_start_binary(char *path, size_t size);
+int logger_decode(char *path, FILE *fp);
 int app_log(char *module, int level, char *prefix, const char *format, ...);
+int app_log_site(int *site, char *module, int level, const char *format, ...);
+
+/*! @brief  
+ *   Check if a module logs at a level, inline so that a disabled call
+ *   costs a load and a test
+ *  @param mod_id - cached module id of the call site (-1 till looked up)
+ *  @param module - module name
+ *  @param level  - log level
+ *  @return 	- true if enabled
+ * */
+static inline bool log_enabled(int *mod_id, char *module, int level)
+{
+	int id = __atomic_load_n(mod_id, __ATOMIC_RELAXED);
 
+	if (id < 0) {
+		id = log_module_id(module);
+		__atomic_store_n(mod_id, id, __ATOMIC_RELAXED);
+	}
+	return (__atomic_load_n(&module_logs[id], __ATOMIC_RELAXED) >> level) & 1;
+}
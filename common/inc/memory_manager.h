@@ -5,26 +5,129 @@
 
 #pragma once 
 
+#ifndef MEM_RELEASE
 #define get_mem(nmemb, size) tag_alloc(nmemb, size,  __FILE__, __LINE__)
 #define free_mem(mem_addr) untag_alloc(mem_addr, __FILE__, __LINE__) 
+#else
+/// Release mode, straight to the allocator with sampled tracking
+#define get_mem(nmemb, size) mem_release_alloc(nmemb, size, __FILE__, __LINE__)
+#define free_mem(mem_addr) mem_release_free(mem_addr)
+#endif
 #define FREE_MEM untag_alloc
 
+#define MEM_SITE_MAX		1024	///< Max call sites (file:line) profiled (power of 2)
+#define MEM_HIST_MIN_SHIFT	4	///< First histogram bin holds allocs <= 16 Bytes
+#define MEM_HIST_BINS		12	///< Bins <=16B, <=32B ... <=16KB and >16KB
+
+/// Memory profile of a call site (file:line), counters are updated atomically
+typedef struct mem_site
+{
+	char *file;			///< File where the alloc was made (NULL marks an empty slot)
+	int line;			///< Line where the alloc was made
+	size_t free_count;		///< Allocations of the site freed
+	size_t live_bytes;		///< Bytes allocated at the site not yet freed
+	size_t peak_bytes;		///< High water mark of live bytes
+	size_t hist[MEM_HIST_BINS];	///< Allocation count by size, power of 2 bins (sums to allocs)
+}t_mem_site;
+
+#ifndef MEM_LARGE_THRESHOLD
+#define MEM_LARGE_THRESHOLD	(1UL << 21)	///< Allocs this big get their own huge page backed mapping
+#endif
+#define MEM_LARGE_ALIGN		(1UL << 21)	///< Large mappings start on a huge page boundary
+#define MEM_LARGE_MAX		256		///< Max large mappings live at once
+#define MEM_PAGE_SIZE		4096		///< Large mapping length is rounded to this
+
+/// Formats of the per call site profile dump
+typedef enum {
+	eMEM_DUMP_TABLE,		///< Text table
+	eMEM_DUMP_JSON,			///< JSON array
+} e_mem_dump;
+
+#ifdef MEM_RELEASE
+#ifndef MEM_SAMPLE_RATE
+#define MEM_SAMPLE_RATE		1024	///< On average 1 in N allocations is tracked
+#endif
+#define MEM_FILTER_BITS		14	///< log2 of slots in sampled address filter
+#define MEM_SAMPLE_INIT_SIZE	256	///< Initial slots of the sampled allocation table
+
+/// Sampled allocation, stored in open addressing table keyed by address
+typedef struct mem_sample
+{
+	void *mem;			///< Address handed out (NULL marks an empty slot)
+	size_t bytes;			///< Bytes requested
+	t_mem_site *site;		///< Call site of the alloc
+}t_mem_sample;
+
+/// Memory manager, in release mode only sampled allocations are tracked
+typedef struct mem_mamnager{
+	pthread_mutex_t lock;		///< Serializes the sampled (slow) path
+	t_mem_sample *sample;		///< Open addressing table of live samples
+	size_t size;			///< Total slots in the sample table (power of 2)
+	size_t used;			///< Slots holding a live sample
+}t_mem_manager;
+
+#else
+#define MEM_SHARD_BITS		4			///< log2 of shard count
+#define MEM_SHARDS		(1 << MEM_SHARD_BITS)	///< Number of tracking shards
+#define MEM_SHARD_ALIGN		64			///< Keeps each shard on its own cache line
+
+#ifdef MEM_HDR_TRACKING
+/// Magic stamped in the header of every tagged block
+#define MEM_HDR_MAGIC		0xC0FFEE11
+
+/// Allocation header placed just before the block handed out
+typedef struct memory_header
+{
+	struct memory_header *nxt;	///< Next tagged block in leak list
+	struct memory_header *prv;	///< Prev tagged block in leak list
+	t_mem_site *site;		///< Call site (file:line) of the alloc
+	unsigned int magic;		///< Used to detect untagged or double frees
+	size_t nmemb;			///< Number of members requested
+	size_t block_size;		///< Size of each member
+}t_mem_header;
+
+/// Header space kept in front of each block, preserves 16 byte alignment
+#define MEM_HDR_SIZE		((sizeof(t_mem_header) + 15) & ~((size_t)15))
+
+/// Shard of the memory manager, tracks blocks in an intrusive doubly linked list
+typedef struct mem_shard{
+	pthread_mutex_t lock;		///< Serializes access to this shard
+	t_mem_header head;		///< Sentinel of the circular list of tagged blocks
+	int alloc_count;
+	int free_count;
+} __attribute__((aligned(MEM_SHARD_ALIGN))) t_mem_shard;
+
+#else
+/// Initial slot count of the allocation record table of each shard (power of 2)
+#define MEM_RECORD_INIT_SIZE	256
+
+/// Allocation record stored in the open addressing table
 typedef struct memory_record 
 {
-	void *mem;
-	size_t nmemb;
-	size_t block_size;
-	char *file;
-	int line;
-	struct memory_record *next;
+	void *mem;			///< Address handed out (NULL marks an empty slot)
+	size_t nmemb;			///< Number of members requested
+	size_t block_size;		///< Size of each member
+	t_mem_site *site;		///< Call site (file:line) of the alloc
 }t_mem_record;
 
 
-typedef struct mem_mamnager{
-	t_mem_record *mem_record;
+/// Shard of the memory manager, tracks allocations in a hash table keyed by address
+typedef struct mem_shard{
+	pthread_mutex_t lock;		///< Serializes access to this shard
+	t_mem_record *mem_record;	///< Open addressing (linear probe) table
+	size_t size;			///< Total slots in the table (power of 2)
+	size_t used;			///< Slots holding a live allocation
 	int alloc_count;
 	int free_count;
+} __attribute__((aligned(MEM_SHARD_ALIGN))) t_mem_shard;
+#endif
+
+/// Memory manager, tracking is split over shards picked by block address
+/// so that threads allocating at the same time rarely share a lock
+typedef struct mem_mamnager{
+	t_mem_shard shard[MEM_SHARDS];	///< Independently locked shards
 }t_mem_manager;
+#endif
 
 
 void mem_init(void);
@@ -34,4 +137,90 @@ void *tag_alloc(size_t nmemb, size_t size, char *file, int line);
 void untag_alloc(void *mem_addr, char *file, int line);
 
 void mem_alloc_report(void);
+void mem_profile_dump(FILE *fp, e_mem_dump fmt);
+
+void *mem_large_alloc(size_t bytes);
+bool mem_large_free(void *mem_addr);
+
+/*! @brief  
+ *   Get memory from the os, big arrays are mapped on their own
+ *   (huge page aligned and prefaulted) the rest comes from os_alloc
+ *  @param nmemb - number of members
+ *  @param size  - size of each member
+ *  @return      - zeroed memory address
+ * */
+static inline void *mem_os_alloc(size_t nmemb, size_t size)
+{
+	size_t bytes;
+	void *mem;
+
+	if (!__builtin_mul_overflow(nmemb, size, &bytes) && bytes >= MEM_LARGE_THRESHOLD) {
+		mem = mem_large_alloc(bytes);
+		if (mem != NULL) {
+			return mem;
+		}
+	}
+	return os_alloc(nmemb, size);
+}
 
+/*! @brief  
+ *   Give memory got from mem_os_alloc back to the os, only huge page
+ *   aligned addresses need the lookup of large mappings
+ *  @param mem_addr - memory address
+ *  @return         - NA
+ * */
+static inline void mem_os_free(void *mem_addr)
+{
+	if (((uintptr_t)mem_addr & (MEM_LARGE_ALIGN - 1)) == 0 && mem_addr != NULL &&
+			mem_large_free(mem_addr)) {
+		return;
+	}
+	os_free(mem_addr);
+}
+
+#ifdef MEM_RELEASE
+extern __thread long mem_sample_countdown;
+extern uint16_t mem_sample_filter[1 << MEM_FILTER_BITS];
+
+void *mem_sample_alloc(size_t nmemb, size_t size, char *file, int line);
+void mem_sample_free(void *mem_addr);
+
+/*! @brief  
+ *   Slot of an address in the sampled address filter
+ *  @param mem_addr - address
+ *  @return 	    - filter slot
+ * */
+static inline size_t mem_filter_slot(void *mem_addr)
+{
+	return (size_t)(((uint64_t)(uintptr_t)mem_addr * 0x9E3779B97F4A7C15ULL)
+			>> (64 - MEM_FILTER_BITS));
+}
+
+/*! @brief  
+ *   Release mode alloc, only every ~MEM_SAMPLE_RATE th call leaves
+ *   the inline path to get recorded against its call site
+ *  @return - memory address
+ * */
+static inline void *mem_release_alloc(size_t nmemb, size_t size, char *file, int line)
+{
+	if (--mem_sample_countdown > 0) {
+		return mem_os_alloc(nmemb, size);
+	}
+	return mem_sample_alloc(nmemb, size, file, line);
+}
+
+/*! @brief  
+ *   Release mode free, the filter is non zero for any slot a live
+ *   sample hashes to, so unsampled blocks mostly skip the lookup
+ *  @return - NA
+ * */
+static inline void mem_release_free(void *mem_addr)
+{
+	if (__atomic_load_n(&mem_sample_filter[mem_filter_slot(mem_addr)],
+				__ATOMIC_RELAXED) != 0) {
+		mem_sample_free(mem_addr);
+		return;
+	}
+	mem_os_free(mem_addr);
+}
+#endif
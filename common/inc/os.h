@@ -15,10 +15,20 @@
 #include <pthread.h>
 #include <signal.h>
 #include <sys/time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <time.h>
 #include <limits.h>
+#include <errno.h>
 
 /// Custom malloc if not defined use calloc and free
 #ifndef CUSTOM_MALLOC
 	#define os_alloc(nmemb, size)				calloc((nmemb), (size))
 	#define os_free(mem_addr)						free((mem_addr))
+#else
+	/// Size class slab allocator
+	#include "slab_allocator.h"
+	#define os_alloc(nmemb, size)				slab_alloc((nmemb), (size))
+	#define os_free(mem_addr)						slab_free((mem_addr))
 #endif
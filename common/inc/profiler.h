@@ -0,0 +1,36 @@
+/*! @file profiler.h
+    @brief 
+    Contains declarations of the sampling profiler, a cpu time timer
+    raises SIGPROF and the handler records a backtrace, samples are
+    written as folded stacks (flamegraph input) when profiling stops
+*/
+
+#pragma once
+
+#include <os.h>
+
+#define PROF_HZ			997		///< Default samples per second of cpu time
+#define PROF_DEPTH		32		///< Max frames kept per sample
+#define PROF_MAX_SAMPLES	32768		///< Samples kept, later ones are counted as dropped
+#define PROF_SKIP		2		///< Frames of the handler and the signal trampoline
+#define PROF_FILE		"prof.folded"	///< Output used when built with PROFILER
+
+/// Backtrace taken on a tick
+typedef struct prof_sample {
+	int depth;				///< Frames in pc
+	void *pc[PROF_DEPTH];			///< Return addresses, innermost first
+} t_prof_sample;
+
+/// Sampling profiler
+typedef struct profiler {
+	t_prof_sample *samples;			///< Preallocated sample buffer
+	size_t count;				///< Ticks so far, bumped atomically by the handler
+	timer_t timer;				///< Process cpu time timer raising SIGPROF
+	struct sigaction old;			///< SIGPROF action before profiling started
+	char path[PATH_MAX];			///< File folded stacks are written to
+	bool running;				///< Profiling in progress
+} t_profiler;
+
+int profiler_start(char *path, int hz);
+void profiler_stop(void);
+void profiler_disarm(void);
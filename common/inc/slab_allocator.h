@@ -0,0 +1,33 @@
+/*! @file slab_allocator.h
+    @brief 
+    Contains declarations of the size class slab allocator
+    used as os_alloc/os_free backend when CUSTOM_MALLOC is defined
+*/
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define SLAB_PAGE_SIZE		4096		///< Size (and alignment) of each slab
+#define SLAB_MAX_BLOCK		512		///< Largest block served from slabs
+#define SLAB_ALIGN		16		///< Alignment of every block handed out
+#define SLAB_MAGIC		0x51AB51AB	///< Marks a valid slab header
+#define SLAB_LARGE		0xFFFF		///< Class id of blocks bigger than SLAB_MAX_BLOCK
+#define SLAB_CACHE_BATCH	32		///< Blocks moved between a thread cache and the depot at once
+
+/// Slab header kept at the start of every slab page
+typedef struct slab {
+	uint32_t magic;			///< SLAB_MAGIC
+	uint32_t class_id;		///< Size class of the blocks, SLAB_LARGE for a large block
+	size_t block_size;		///< Size of each block in slab (or size of large block)
+	struct slab *nxt;		///< Next slab in list of all slabs
+	struct slab *prv;		///< Prev slab in list of all slabs
+} t_slab;
+
+/// Offset of the first block from the slab page start
+#define SLAB_HDR_SIZE		((sizeof(t_slab) + SLAB_ALIGN - 1) & ~((size_t)SLAB_ALIGN - 1))
+
+void *slab_alloc(size_t nmemb, size_t size);
+void slab_free(void *mem_addr);
+void slab_finit(void);
+void slab_report(void);
@@ -67,6 +67,7 @@ typedef e_cmpr (*f_cmpr)(t_gen,t_gen);
 typedef void(*f_free)(t_gen, char*, int);
 typedef f_vgen2 f_assign;
 typedef f_vgen2 f_swap;
+typedef uint64_t (*f_hash)(t_gen);		///< fn type of hash of an elem
 
 typedef e_cmpr (*f_cmp_idx)(t_gen,int, int);
 typedef void (*f_swp_idx)(t_gen,int, int);
@@ -0,0 +1,127 @@
+/*! @file arena.c
+    @brief 
+    Contains definitions of the bump allocating arena
+    Memory is handed out of big chunks and never freed individually,
+    destroying the arena releases all chunks in one go
+*/
+#include "common.h"
+
+/// Space kept for chunk header, keeps chunk data aligned
+#define ARENA_HDR_SIZE	((sizeof(t_arena_chunk) + ARENA_ALIGN - 1) & ~((size_t)ARENA_ALIGN - 1))
+
+/*! @brief  
+ *  Create an instance of arena
+ *  @param name       - Name of arena instance
+ *  @param chunk_size - Bytes per chunk, 0 for ARENA_CHUNK_SIZE
+ *  @return           - Pointer to instance of arena
+ * */
+t_arena *create_arena(char *name, size_t chunk_size)
+{
+	t_arena *a = get_mem(1, sizeof(t_arena));
+
+	a->name       = name;
+	a->chunk_size = chunk_size ? chunk_size : ARENA_CHUNK_SIZE;
+	a->total      = 0;
+	a->chunk      = NULL;
+	a->tail       = NULL;
+
+	return a;
+}
+
+/*! @brief  
+ *  Allocate zeroed memory from arena
+ *  @param a     - Pointer to instance of arena
+ *  @param nmemb - number of members
+ *  @param size  - size of each member
+ *  @return      - memory address, NULL if nmemb * size overflows
+ * */
+void *arena_alloc(t_arena *a, size_t nmemb, size_t size)
+{
+	t_arena_chunk *chunk = a->chunk;
+	size_t len;
+	void *mem;
+
+	// A wrapped len would hand out an undersized block, keep room
+	// for the round up and for the header of a chunk of its own
+	if ((size && nmemb > SIZE_MAX / size) ||
+			nmemb * size > SIZE_MAX - ARENA_HDR_SIZE - ARENA_ALIGN) {
+		LOG_ERROR("ARENA", "%s: alloc of %zu x %zu bytes overflows\n", a->name, nmemb, size);
+		return NULL;
+	}
+	len = (nmemb * size + ARENA_ALIGN - 1) & ~((size_t)ARENA_ALIGN - 1);
+
+	// Current chunk full, start a new one
+	// allocs bigger than a chunk get a chunk of their own
+	if (chunk == NULL || chunk->used + len > chunk->size) {
+		size_t csize = (len > a->chunk_size) ? len : a->chunk_size;
+
+		chunk = get_mem(1, ARENA_HDR_SIZE + csize);
+		if (chunk == NULL) {
+			LOG_ERROR("ARENA", "%s: chunk allocation failed\n", a->name);
+			return NULL;
+		}
+		chunk->size = csize;
+		chunk->used = 0;
+		chunk->nxt  = a->chunk;
+		a->chunk    = chunk;
+		if (chunk->nxt == NULL) {
+			a->tail = chunk;
+		}
+	}
+
+	// Bump allocate, chunk memory is zeroed by get_mem
+	mem = (char*)chunk + ARENA_HDR_SIZE + chunk->used;
+	chunk->used += len;
+	a->total += len;
+
+	return mem;
+}
+
+/*! @brief  
+ *  Move all chunks of src arena to dst arena in O(1), memory handed
+ *  out by src is released with dst from then on and src is left empty
+ *  @param dst   - Pointer to arena taking the chunks
+ *  @param src   - Pointer to arena giving up its chunks
+ *  @return      - NA
+ * */
+void arena_merge(t_arena *dst, t_arena *src)
+{
+	if (src->chunk == NULL) {
+		return;
+	}
+
+	// chunks of src go after the current chunk of dst so bump allocs
+	// carry on from the dst chunk
+	if (dst->chunk == NULL) {
+		dst->chunk = src->chunk;
+		dst->tail = src->tail;
+	} else {
+		src->tail->nxt = dst->chunk->nxt;
+		if (dst->chunk->nxt == NULL) {
+			dst->tail = src->tail;
+		}
+		dst->chunk->nxt = src->chunk;
+	}
+	dst->total += src->total;
+
+	src->chunk = NULL;
+	src->tail = NULL;
+	src->total = 0;
+}
+
+/*! @brief  
+ *  Destroy arena and release all memory allocated from it
+ *  @param a     - Pointer to instance of arena
+ *  @return      - NA
+ * */
+void destroy_arena(t_arena *a)
+{
+	t_arena_chunk *chunk, *nxt;
+
+	for (chunk = a->chunk; chunk != NULL; chunk = nxt) {
+		nxt = chunk->nxt;
+		free_mem(chunk);
+	}
+
+	free_mem(a);
+}
@@ -14,6 +14,14 @@
  * */
 void init_data_params(t_dparams *prms, e_data_types data_type)
 {
+	// elems are boxed unless the user asks for inline storage
+	prms->elem_size = 0;
+	prms->hash = NULL;
+
+	// fixed size array containers unless the user asks for growth
+	prms->auto_grow = false;
+	prms->shrink_div = 0;
+
 	switch(data_type)
 	{
 		case eINT8:
@@ -36,6 +44,7 @@ void init_data_params(t_dparams *prms, e_data_types data_type)
 			prms->copy_idx = copy_idx_int;
 			prms->get_idx  = get_idx_int;
 			prms->print_data = print_int;
+			prms->hash = hash_int;
 			prms->free = FREE_MEM;
 			break;
 		case eFLOAT:
@@ -47,6 +56,7 @@ void init_data_params(t_dparams *prms, e_data_types data_type)
 			prms->copy_idx = copy_idx_float;
 			prms->get_idx  = get_idx_float;
 			prms->print_data = print_float;
+			prms->hash = hash_float;
 			prms->free = FREE_MEM;
 			break;
 		case eSTRING:
@@ -54,6 +64,7 @@ void init_data_params(t_dparams *prms, e_data_types data_type)
 			prms->cmpr = compare_string;
 			prms->swap = swap_string;
 			prms->print_data = print_str;
+			prms->hash = hash_string;
 			prms->free = FREE_MEM;
 			break;
 #if 0
@@ -76,3 +87,26 @@ void dummy_free(void *mem_addr, char *file, int line)
 {
 
 }
+
+/*! @brief  
+ *   Swap two elems of given size in place, used by containers
+ *   that store elems inline
+ *  @param x    - Pointer to first elem
+ *  @param y    - Pointer to second elem
+ *  @param size - Bytes of an elem
+ *  @return 	- NA
+ */
+void swap_bytes(t_gen x, t_gen y, size_t size)
+{
+	char *a = (char*)x, *b = (char*)y, tmp[64];
+	size_t n;
+
+	// swap in chunks of the tmp buffer
+	while (size) {
+		n = (size < sizeof(tmp))? size : sizeof(tmp);
+		memcpy(tmp, a, n);
+		memcpy(a, b, n);
+		memcpy(b, tmp, n);
+		a += n; b += n; size -= n;
+	}
+}
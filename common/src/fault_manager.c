@@ -20,7 +20,11 @@ void dummy_fault_handler()
 	// print out all the frames to stderr
 	backtrace_symbols_fd(array, size, STDERR_FILENO);
 	// gracefulexit
-	// closing_logger_manager
+	// closing_profiler, only the timer is stopped here as writing the
+	// folded stacks is not signal safe, they are written at exit
+	profiler_disarm();
+	// closing_logger_manager, records still queued in async mode
+	logger_fault_drain();
 	
 	// closing_memory_manager
 	mem_finit();
@@ -87,6 +91,11 @@ void fault_manager_init(f_fault_handle handler)
 		perror("sigterm: sigaction");
 		exit(1);
 	}
+
+#ifdef PROFILER
+	// sample whole run, folded stacks are written at exit
+	profiler_start(PROF_FILE, PROF_HZ);
+#endif
 }
 
 /* TODO enchancment:
@@ -65,6 +65,36 @@ void print_str(t_gen str)
 	printf("%s", (char*)str);
 }
 
+uint64_t hash_int(t_gen x)
+{
+	return hash_mix((uint32_t)*(int*)x);
+}
+
+uint64_t hash_float(t_gen x)
+{
+	float f = *(float*)x;
+	uint32_t bits;
+
+	// -0.0 compares equal to 0.0 so it has to hash the same
+	if (f == 0.0f) {
+		f = 0.0f;
+	}
+	memcpy(&bits, &f, sizeof(bits));
+	return hash_mix(bits);
+}
+
+uint64_t hash_string(t_gen x)
+{
+	uint64_t h = 0xcbf29ce484222325ULL;
+	unsigned char *c = (unsigned char*)x;
+
+	// FNV-1a
+	while (*c) {
+		h = (h ^ *c++) * 0x100000001b3ULL;
+	}
+	return hash_mix(h);
+}
+
 t_gen gen_get_idx(t_gen x, int idx1)
 {
 	t_gen *arr = ((t_gen*)(x));
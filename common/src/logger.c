@@ -1,14 +1,68 @@
 /*! @file logger.c
     @brief 
     Contains definitions of routines for logger module
+    In async mode app_log only copies the call into a lock free ring of
+    the calling thread, a background thread formats and flushes them
+    In binary mode each call site is written once and calls only append
+    site id, time stamp and raw args to a mapped file, logger_decode
+    renders the file offline
 */
 
 #include "common.h"
 #include "logger.h"
 
-//Array to maintain current log levels to be used
+//Array to maintain current log levels to be used, new modules start with these
 static bool log_level[MAX_LOG_LEVELS] = {false};
-static bool module_logs[MAX_MODULES] = {false};
+//Mask of levels on for each module (bit n for level n), slot 0 is shared by modules past MAX_MODULES
+uint8_t module_logs[MAX_MODULES] = {0};
+//Names of the modules in module_logs
+static char module_names[MAX_MODULES][LOG_NAME_LEN] = {"(other)"};
+static int module_count = 1;
+
+/// Kind of argument consumed by a conversion spec
+typedef enum {
+	eLOG_ARG_NONE,				///< "%%" consumes nothing
+	eLOG_ARG_INT,				///< int or smaller
+	eLOG_ARG_LONG,				///< long, long long, size_t ...
+	eLOG_ARG_DOUBLE,			///< float or double
+	eLOG_ARG_LDOUBLE,			///< long double
+	eLOG_ARG_STR,				///< string, copied into the record
+	eLOG_ARG_PTR,				///< pointer printed as is
+	eLOG_ARG_SKIP,				///< "%n" pointer, not written
+} e_log_arg;
+
+/// Call site registered for binary mode
+typedef struct log_site {
+	const char *format;			///< Format string of the site
+	char module[LOG_NAME_LEN];		///< Module name
+	int level;				///< Log level
+	unsigned int gen;			///< Binary file the site was last defined in
+} t_log_site;
+
+static t_log_site log_sites[LOG_SITE_MAX];
+static int log_site_count;
+
+/// Logger state
+static struct {
+	FILE *fp;				///< Output stream (NULL for stdout)
+	bool async;				///< Async mode running
+	t_log_bin_hdr *bin;			///< Mapped binary log file (NULL if not in binary mode)
+	int bin_fd;				///< File descriptor of binary log file
+	unsigned int bin_gen;			///< Bumped for every binary log file started
+	bool stop;				///< Asks background thread to drain and exit
+	pthread_t thread;			///< Background thread
+	pthread_key_t key;			///< Hands the ring back on thread exit
+	pthread_once_t once;			///< One time creation of key
+	pthread_mutex_t lock;			///< Serializes ring creation
+	t_log_ring *rings;			///< All rings, pushed at head
+	size_t dropped;				///< Drops reported so far
+} logger = {
+	.once = PTHREAD_ONCE_INIT,
+	.lock = PTHREAD_MUTEX_INITIALIZER,
+};
+
+/// Ring of the calling thread
+static __thread t_log_ring *log_ring;
 
 /*! @brief  
  *   Initailize logger module
@@ -17,65 +71,1075 @@ static bool module_logs[MAX_MODULES] = {false};
 void logger_init()
 {
 	int i;
-	
+
 	for (i = 0; i < MAX_LOG_LEVELS; i++) {
-		log_level[i] = true;
+		logger_set_level(NULL, i, true);
 	}
 
 	printf("Logger init\n");
 
+#ifdef LOG_ASYNC
+	logger_start_async();
+#endif
+#ifdef LOG_BINARY
+	logger_start_binary(LOG_BIN_FILE, LOG_BIN_SIZE);
+#endif
 }
 
 /*! @brief  
- *   Used for defining different logging modules such as warn, error, debug, trace ...
+ *   Get id of a module, a new module starts with the levels set for all modules
+ *  @param module - module name
+ *  @return 	- index in module_logs
+ * */
+int log_module_id(char *module)
+{
+	int i, id, lvl;
+	uint8_t mask;
+
+	pthread_mutex_lock(&logger.lock);
+	for (i = 1; i < module_count; i++) {
+		if (strncmp(module_names[i], module, LOG_NAME_LEN - 1) == 0) {
+			break;
+		}
+	}
+	if (i == module_count && module_count < MAX_MODULES) {
+		strncpy(module_names[i], module, LOG_NAME_LEN - 1);
+		for (lvl = 0, mask = 0; lvl < MAX_LOG_LEVELS; lvl++) {
+			mask |= log_level[lvl] << lvl;
+		}
+		__atomic_store_n(&module_logs[i], mask, __ATOMIC_RELAXED);
+		module_count++;
+	}
+	id = (i < module_count) ? i : 0;
+	pthread_mutex_unlock(&logger.lock);
+
+	return id;
+}
+
+/*! @brief  
+ *   Turn a log level on or off for a module
+ *  @param module - module name else NULL for all modules
+ *  @param level  - log level
+ *  @param on     - true to log at the level
  *  @return 	- NA
  * */
-int app_log(char *module, int level, char *prefix, const char *format, ...)
+void logger_set_level(char *module, int level, bool on)
 {
-	int len = 0;
-	va_list args;
+	int i, first, last;
+	uint8_t mask;
 
-	va_start(args, format);
+	if (level < 0 || level >= MAX_LOG_LEVELS) {
+		return;
+	}
+
+	if (module == NULL) {
+		first = 0;
+		last = MAX_MODULES - 1;
+	} else {
+		first = last = log_module_id(module);
+	}
+
+	pthread_mutex_lock(&logger.lock);
+	if (module == NULL) {
+		log_level[level] = on;
+	}
+	for (i = first; i <= last; i++) {
+		mask = module_logs[i];
+		mask = on ? (mask | (1 << level)) : (mask & ~(1 << level));
+		__atomic_store_n(&module_logs[i], mask, __ATOMIC_RELAXED);
+	}
+	pthread_mutex_unlock(&logger.lock);
+}
+
+/*! @brief  
+ *   Set stream logs are written to, NULL for stdout
+ *  @param fp - output stream
+ *  @return 	- NA
+ * */
+void logger_set_file(FILE *fp)
+{
+	logger.fp = fp;
+}
+
+/*! @brief  
+ *   Print time stamp, level and module of a log line
+ *  @param fp     - output stream
+ *  @param ts_ns  - wall clock time in nano seconds
+ *  @param level  - log level
+ *  @param module - module name
+ *  @param prefix - prefix else NULL
+ *  @return 	- NA
+ * */
+static void log_header(FILE *fp, uint64_t ts_ns, int level, char *module, char *prefix)
+{
+	static const char *tag[MAX_LOG_LEVELS] = {"ERR", "WRN", "INF", "DBG", "TRC"};
+	char time_buff[64];
+	time_t now = ts_ns / 1000000000ULL;
+	struct tm tm;
+
+	strftime(time_buff, 64, "%H:%M:%S", localtime_r(&now, &tm));
+	fprintf(fp, "%s.%03d ", time_buff, (int)(ts_ns / 1000000ULL % 1000));
+	fprintf(fp, "[%s:%s] ", (level >= 0 && level < MAX_LOG_LEVELS) ? tag[level] : "UDF", module);
+
+	if (prefix != NULL && prefix[0] != '\0') {
+		fprintf(fp, "{%s} ", prefix);
+	}
+}
+
+/*! @brief  
+ *   Wall clock time
+ *  @return 	- time in nano seconds
+ * */
+static uint64_t log_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_REALTIME, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/*! @brief  
+ *   Parse one conversion spec of a printf format
+ *  @param p     - points at the '%' starting the spec
+ *  @param spec  - gets the spec text (NUL terminated, LOG_NAME_LEN * 2 long)
+ *  @param stars - gets the count of '*' width/precision args
+ *  @param kind  - gets the kind of arg consumed
+ *  @return 	- pointer past the spec
+ * */
+static const char *log_parse_spec(const char *p, char *spec, int *stars, e_log_arg *kind)
+{
+	const char *start = p++;
+	int longs = 0;
+	bool ldouble = false;
+	size_t len;
+
+	*stars = 0;
+	while (*p != '\0' && strchr("-+ #0", *p) != NULL) {
+		p++;
+	}
+	while (*p == '*' || (*p >= '0' && *p <= '9') || *p == '.') {
+		*stars += (*p == '*');
+		p++;
+	}
+	while (*p != '\0' && strchr("hlLqjzt", *p) != NULL) {
+		longs += (*p == 'l' || *p == 'q' || *p == 'j' || *p == 'z' || *p == 't');
+		ldouble |= (*p == 'L');
+		p++;
+	}
+
+	switch (*p) {
+		case 'd': case 'i': case 'o': case 'u': case 'x': case 'X': case 'c':
+			*kind = longs ? eLOG_ARG_LONG : eLOG_ARG_INT;
+			break;
+		case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+			*kind = ldouble ? eLOG_ARG_LDOUBLE : eLOG_ARG_DOUBLE;
+			break;
+		case 's':
+			*kind = eLOG_ARG_STR;
+			break;
+		case 'p':
+			*kind = eLOG_ARG_PTR;
+			break;
+		case 'n':
+			*kind = eLOG_ARG_SKIP;
+			break;
+		default:
+			*kind = eLOG_ARG_NONE;
+			break;
+	}
+	if (*p != '\0') {
+		p++;
+	}
+
+	len = p - start;
+	len = (len < 2 * LOG_NAME_LEN - 1) ? len : 2 * LOG_NAME_LEN - 1;
+	memcpy(spec, start, len);
+	spec[len] = '\0';
+
+	return p;
+}
+
+/*! @brief  
+ *   Pack args of a call in format order, strings are copied as their
+ *   memory may be gone before the args are formatted
+ *  @param buf    - buffer args are packed in
+ *  @param size   - size of buffer, args that do not fit are cut
+ *  @param format - printf format
+ *  @param args   - args of the call
+ *  @return 	- bytes used in buf
+ * */
+static int log_pack(char *buf, size_t size, const char *format, va_list args)
+{
+	char spec[2 * LOG_NAME_LEN], *out = buf, *end = buf + size;
+	const char *p = format;
+	int i, stars;
+	e_log_arg kind;
+
+// copy a value if it fits, else stop packing
+#define LOG_PUT(type, val)	do { type v_ = (val); if (out + sizeof(v_) > end) goto done; \
+				     memcpy(out, &v_, sizeof(v_)); out += sizeof(v_); } while (0)
+
+	while ((p = strchr(p, '%')) != NULL) {
+		p = log_parse_spec(p, spec, &stars, &kind);
+		for (i = 0; i < stars; i++) {
+			LOG_PUT(int, va_arg(args, int));
+		}
+		switch (kind) {
+			case eLOG_ARG_INT:
+				LOG_PUT(int, va_arg(args, int));
+				break;
+			case eLOG_ARG_LONG:
+				LOG_PUT(long long, va_arg(args, long long));
+				break;
+			case eLOG_ARG_DOUBLE:
+				LOG_PUT(double, va_arg(args, double));
+				break;
+			case eLOG_ARG_LDOUBLE:
+				LOG_PUT(long double, va_arg(args, long double));
+				break;
+			case eLOG_ARG_PTR:
+				LOG_PUT(void*, va_arg(args, void*));
+				break;
+			case eLOG_ARG_SKIP:
+				(void)va_arg(args, void*);
+				break;
+			case eLOG_ARG_STR: {
+				const char *s = va_arg(args, const char*);
+				size_t len;
+
+				s = (s != NULL) ? s : "(null)";
+				if (out >= end) {
+					goto done;
+				}
+				// keep what fits, always NUL terminated
+				len = strnlen(s, end - out - 1);
+				memcpy(out, s, len);
+				out[len] = '\0';
+				out += len + 1;
+				break;
+			}
+			default:
+				break;
+		}
+	}
+#undef LOG_PUT
+done:
+	return out - buf;
+}
+
+/*! @brief  
+ *   Format args packed by log_pack, walks the format again and
+ *   prints each spec with its raw arg
+ *  @param fp       - output stream
+ *  @param format   - printf format
+ *  @param args     - packed args
+ *  @param args_len - bytes of packed args
+ *  @return 	- NA
+ * */
+static void log_render(FILE *fp, const char *format, const char *args, int args_len)
+{
+	char spec[2 * LOG_NAME_LEN], full[4 * LOG_NAME_LEN];
+	const char *p = format, *nxt, *in = args, *end = args + args_len;
+	int i, k, stars, star[2];
+	e_log_arg kind;
+	size_t n;
 
-	if (level < MAX_LOG_LEVELS && log_level[level] == true) {
-		char time_buff[64];
-		int millisec;
-		struct timeval tv;
-		time_t now = time(0);
+// take a value if it was packed, else the message was cut
+#define LOG_GET(var)	do { if (in + sizeof(var) > end) goto cut; \
+			     memcpy(&(var), in, sizeof(var)); in += sizeof(var); } while (0)
 
-		gettimeofday(&tv, NULL);
-		millisec = (tv.tv_usec/1000);
-		strftime(time_buff, 64, "%H:%M:%S", localtime(&now));
-		printf("%s.%03d ", time_buff, millisec);
-		switch (level) {
-			case __LOG_ERROR__:
-				printf("[ERR");
+	while ((nxt = strchr(p, '%')) != NULL) {
+		fwrite(p, 1, nxt - p, fp);
+		p = log_parse_spec(nxt, spec, &stars, &kind);
+		for (i = 0; i < stars && i < 2; i++) {
+			LOG_GET(star[i]);
+		}
+
+		// each '*' is replaced by its packed width/precision
+		for (i = 0, k = 0, n = 0; spec[i] != '\0' && n < sizeof(full) - 12; i++) {
+			if (spec[i] == '*' && k < 2) {
+				n += sprintf(full + n, "%d", star[k++]);
+			} else {
+				full[n++] = spec[i];
+			}
+		}
+		full[n] = '\0';
+
+		switch (kind) {
+			case eLOG_ARG_INT: {
+				int v;
+				LOG_GET(v);
+				fprintf(fp, full, v);
+				break;
+			}
+			case eLOG_ARG_LONG: {
+				long long v;
+				LOG_GET(v);
+				fprintf(fp, full, v);
+				break;
+			}
+			case eLOG_ARG_DOUBLE: {
+				double v;
+				LOG_GET(v);
+				fprintf(fp, full, v);
 				break;
-			case __LOG_WARN__:
-				printf("[WRN");
+			}
+			case eLOG_ARG_LDOUBLE: {
+				long double v;
+				LOG_GET(v);
+				fprintf(fp, full, v);
 				break;
-			case __LOG_INFO__:
-				printf("[INF");
+			}
+			case eLOG_ARG_PTR: {
+				void *v;
+				LOG_GET(v);
+				fprintf(fp, full, v);
 				break;
-			case __LOG_DEBUG__:
-				printf("[DBG");
+			}
+			case eLOG_ARG_STR:
+				if (in >= end) {
+					goto cut;
+				}
+				fprintf(fp, full, in);
+				in += strlen(in) + 1;
 				break;
-			case __LOG_TRACE__:
-				printf("[TRC");
+			case eLOG_ARG_SKIP:
 				break;
 			default:
-				printf("[UDF");
+				fputs(spec[1] == '%' ? "%" : spec, fp);
 				break;
 		}
+	}
+#undef LOG_GET
+	fputs(p, fp);
+	return;
+cut:
+	fputs("...\n", fp);
+}
 
-		printf(":%s] ",module);
+/*! @brief  
+ *   Thread exit hook, hands the ring of the thread to the next new thread
+ *  @param arg - ring of the exiting thread
+ *  @return 	- NA
+ * */
+static void log_ring_release(void *arg)
+{
+	t_log_ring *r = arg;
+
+	__atomic_store_n(&r->owned, false, __ATOMIC_RELEASE);
+}
 
-		if (prefix != NULL) {
-			printf("{%s} ", prefix);
+/*! @brief  
+ *   Create the thread exit hook, run once
+ *  @return 	- NA
+ * */
+static void log_key_init(void)
+{
+	pthread_key_create(&logger.key, log_ring_release);
+}
+
+/*! @brief  
+ *   Get ring for calling thread, a ring left by an exited thread is
+ *   reused before a new one is made
+ *  @return 	- ring else NULL
+ * */
+static t_log_ring *log_ring_get(void)
+{
+	t_log_ring *r;
+	bool unowned;
+
+	pthread_mutex_lock(&logger.lock);
+	for (r = logger.rings; r != NULL; r = r->nxt) {
+		unowned = false;
+		if (__atomic_compare_exchange_n(&r->owned, &unowned, true, false,
+					__ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+			break;
 		}
-		len = vprintf(format, args);
 	}
+	if (r == NULL) {
+		r = os_alloc(1, sizeof(t_log_ring));
+		if (r != NULL) {
+			r->owned = true;
+			r->nxt = logger.rings;
+			__atomic_store_n(&logger.rings, r, __ATOMIC_RELEASE);
+		}
+	}
+	pthread_mutex_unlock(&logger.lock);
 
+	if (r != NULL) {
+		pthread_setspecific(logger.key, r);
+	}
+	return r;
+}
+
+/*! @brief  
+ *   Queue a log call in the ring of calling thread, never blocks
+ *   the call is dropped (and counted) if the ring is full
+ *  @return 	- 0 if queued else -1
+ * */
+static int log_enqueue(char *module, int level, char *prefix, const char *format, va_list args)
+{
+	t_log_ring *r = log_ring;
+	t_log_rec *rec;
+	size_t head;
+
+	if (r == NULL) {
+		r = log_ring = log_ring_get();
+		if (r == NULL) {
+			return -1;
+		}
+	}
+
+	head = r->head;
+	if (head - __atomic_load_n(&r->tail, __ATOMIC_ACQUIRE) == LOG_RING_SLOTS) {
+		__atomic_store_n(&r->dropped, r->dropped + 1, __ATOMIC_RELAXED);
+		return -1;
+	}
+
+	rec = &r->rec[head & (LOG_RING_SLOTS - 1)];
+	rec->ts_ns = log_now_ns();
+	rec->format = format;
+	rec->level = level;
+	strncpy(rec->module, module, LOG_NAME_LEN - 1);
+	rec->module[LOG_NAME_LEN - 1] = '\0';
+	strncpy(rec->prefix, prefix != NULL ? prefix : "", LOG_NAME_LEN - 1);
+	rec->prefix[LOG_NAME_LEN - 1] = '\0';
+	rec->args_len = log_pack(rec->args, sizeof(rec->args), format, args);
+
+	__atomic_store_n(&r->head, head + 1, __ATOMIC_RELEASE);
+	return 0;
+}
+
+/*! @brief  
+ *   Format and write all queued records of all rings, report drops
+ *  @param fp - output stream
+ *  @return 	- records written
+ * */
+static size_t log_drain(FILE *fp)
+{
+	t_log_ring *r;
+	t_log_rec *rec;
+	size_t head, tail, dropped, count = 0;
+
+	for (r = __atomic_load_n(&logger.rings, __ATOMIC_ACQUIRE); r != NULL; r = r->nxt) {
+		head = __atomic_load_n(&r->head, __ATOMIC_ACQUIRE);
+		for (tail = r->tail; tail != head; tail++) {
+			rec = &r->rec[tail & (LOG_RING_SLOTS - 1)];
+			log_header(fp, rec->ts_ns, rec->level, rec->module, rec->prefix);
+			log_render(fp, rec->format, rec->args, rec->args_len);
+			count++;
+		}
+		__atomic_store_n(&r->tail, tail, __ATOMIC_RELEASE);
+
+		dropped = __atomic_load_n(&r->dropped, __ATOMIC_RELAXED);
+		if (dropped != r->reported) {
+			log_header(fp, log_now_ns(), __LOG_WARN__, "LOGGER", NULL);
+			fprintf(fp, "%lu message(s) dropped, ring full\n", dropped - r->reported);
+			__atomic_add_fetch(&logger.dropped, dropped - r->reported, __ATOMIC_RELAXED);
+			r->reported = dropped;
+			count++;
+		}
+	}
+	if (count != 0) {
+		fflush(fp);
+	}
+	return count;
+}
+
+/// Output of the fault path drain, filled and flushed with write(2)
+typedef struct log_fault_out {
+	int fd;					///< Output file descriptor
+	size_t len;				///< Bytes held in buf
+	char buf[512];				///< Pending bytes
+} t_log_fault_out;
+
+/*! @brief  
+ *   Add bytes to fault path output, written out when buf fills
+ *  @param w   - fault path output
+ *  @param s   - bytes
+ *  @param n   - count of bytes
+ *  @return 	- NA
+ * */
+static void log_fault_put(t_log_fault_out *w, const char *s, size_t n)
+{
+	size_t k;
+
+	while (n != 0) {
+		k = sizeof(w->buf) - w->len;
+		k = (n < k) ? n : k;
+		memcpy(w->buf + w->len, s, k);
+		w->len += k;
+		s += k;
+		n -= k;
+		if (w->len == sizeof(w->buf)) {
+			if (write(w->fd, w->buf, w->len) < 0) {
+				n = 0;
+			}
+			w->len = 0;
+		}
+	}
+}
+
+/*! @brief  
+ *   Add a number to fault path output without printf
+ *  @param w    - fault path output
+ *  @param v    - magnitude
+ *  @param neg  - true to put a minus sign
+ *  @param base - 8, 10 or 16
+ *  @return 	- NA
+ * */
+static void log_fault_num(t_log_fault_out *w, unsigned long long v, bool neg, int base)
+{
+	char tmp[24];
+	int n = sizeof(tmp);
+
+	do {
+		tmp[--n] = "0123456789abcdef"[v % base];
+		v /= base;
+	} while (v != 0);
+	if (neg) {
+		tmp[--n] = '-';
+	}
+	log_fault_put(w, tmp + n, sizeof(tmp) - n);
+}
+
+/*! @brief  
+ *   Add an int arg to fault path output by the conversion of its spec
+ *  @param w    - fault path output
+ *  @param v    - arg, sign extended
+ *  @param uv   - arg, zero extended
+ *  @param conv - conversion char of the spec
+ *  @return 	- NA
+ * */
+static void log_fault_int(t_log_fault_out *w, long long v, unsigned long long uv, char conv)
+{
+	char c = (char)v;
+
+	switch (conv) {
+		case 'c':
+			log_fault_put(w, &c, 1);
+			break;
+		case 'x': case 'X':
+			log_fault_num(w, uv, false, 16);
+			break;
+		case 'o':
+			log_fault_num(w, uv, false, 8);
+			break;
+		case 'u':
+			log_fault_num(w, uv, false, 10);
+			break;
+		default:
+			log_fault_num(w, (v < 0) ? 0ULL - (unsigned long long)v : (unsigned long long)v, v < 0, 10);
+			break;
+	}
+}
+
+/*! @brief  
+ *   Write one queued record in the fault path, like log_header and
+ *   log_render but without stdio, the time stamp is left out and
+ *   floating point args are shown as their spec
+ *  @param w    - fault path output
+ *  @param rec  - queued record
+ *  @return 	- NA
+ * */
+static void log_fault_rec(t_log_fault_out *w, t_log_rec *rec)
+{
+	static const char *tag[MAX_LOG_LEVELS] = {"ERR", "WRN", "INF", "DBG", "TRC"};
+	char spec[2 * LOG_NAME_LEN];
+	const char *p = rec->format, *nxt, *in = rec->args, *end = rec->args + rec->args_len;
+	int i, stars, star;
+	e_log_arg kind;
+	size_t n;
+
+// take a value if it was packed, else the message was cut
+#define LOG_GET(var)	do { if (in + sizeof(var) > end) goto cut; \
+			     memcpy(&(var), in, sizeof(var)); in += sizeof(var); } while (0)
+
+	log_fault_put(w, "[", 1);
+	p = (rec->level >= 0 && rec->level < MAX_LOG_LEVELS) ? tag[rec->level] : "UDF";
+	log_fault_put(w, p, strlen(p));
+	log_fault_put(w, ":", 1);
+	log_fault_put(w, rec->module, strlen(rec->module));
+	log_fault_put(w, "] ", 2);
+	if (rec->prefix[0] != '\0') {
+		log_fault_put(w, "{", 1);
+		log_fault_put(w, rec->prefix, strlen(rec->prefix));
+		log_fault_put(w, "} ", 2);
+	}
+
+	p = rec->format;
+	while ((nxt = strchr(p, '%')) != NULL) {
+		log_fault_put(w, p, nxt - p);
+		p = log_parse_spec(nxt, spec, &stars, &kind);
+		for (i = 0; i < stars && i < 2; i++) {
+			LOG_GET(star);
+		}
+		n = strlen(spec);
+
+		switch (kind) {
+			case eLOG_ARG_INT: {
+				int v;
+				LOG_GET(v);
+				log_fault_int(w, v, (unsigned int)v, spec[n - 1]);
+				break;
+			}
+			case eLOG_ARG_LONG: {
+				long long v;
+				LOG_GET(v);
+				log_fault_int(w, v, (unsigned long long)v, spec[n - 1]);
+				break;
+			}
+			case eLOG_ARG_DOUBLE: {
+				double v;
+				LOG_GET(v);
+				log_fault_put(w, spec, n);
+				break;
+			}
+			case eLOG_ARG_LDOUBLE: {
+				long double v;
+				LOG_GET(v);
+				log_fault_put(w, spec, n);
+				break;
+			}
+			case eLOG_ARG_PTR: {
+				void *v;
+				LOG_GET(v);
+				log_fault_put(w, "0x", 2);
+				log_fault_num(w, (uintptr_t)v, false, 16);
+				break;
+			}
+			case eLOG_ARG_STR:
+				if (in >= end) {
+					goto cut;
+				}
+				log_fault_put(w, in, strlen(in));
+				in += strlen(in) + 1;
+				break;
+			case eLOG_ARG_SKIP:
+				break;
+			default:
+				log_fault_put(w, spec[1] == '%' ? "%" : spec, spec[1] == '%' ? 1 : n);
+				break;
+		}
+	}
+#undef LOG_GET
+	log_fault_put(w, p, strlen(p));
+	return;
+cut:
+	log_fault_put(w, "...\n", 4);
+}
+
+/*! @brief  
+ *   Best effort drain of the async rings from a fault handler, records
+ *   queued before the fault are written with write(2) to the log fd
+ *   as stdio and the background thread can not be relied on. Output
+ *   still buffered in the stdio stream is lost, a record being drained
+ *   by the background thread at the same time may show up twice
+ *  @return 	- NA
+ * */
+void logger_fault_drain(void)
+{
+	t_log_fault_out w;
+	t_log_ring *r;
+	size_t head, tail;
+
+	if (__atomic_load_n(&logger.async, __ATOMIC_ACQUIRE) == false) {
+		return;
+	}
+
+	w.fd = (logger.fp != NULL) ? fileno(logger.fp) : STDOUT_FILENO;
+	w.len = 0;
+	for (r = __atomic_load_n(&logger.rings, __ATOMIC_ACQUIRE); r != NULL; r = r->nxt) {
+		head = __atomic_load_n(&r->head, __ATOMIC_ACQUIRE);
+		for (tail = __atomic_load_n(&r->tail, __ATOMIC_ACQUIRE); tail != head; tail++) {
+			log_fault_rec(&w, &r->rec[tail & (LOG_RING_SLOTS - 1)]);
+		}
+		__atomic_store_n(&r->tail, tail, __ATOMIC_RELEASE);
+	}
+	// nothing more can be done in a fault if the write fails
+	if (w.len != 0 && write(w.fd, w.buf, w.len) < 0) {
+		return;
+	}
+}
+
+/*! @brief  
+ *   Background thread of async mode, polls rings till asked to stop
+ *  @param arg - NA
+ *  @return 	- NULL
+ * */
+static void *log_thread(void *arg)
+{
+	struct timespec nap = {0, LOG_POLL_NS};
+	FILE *fp;
+	bool stop;
+
+	for (;;) {
+		// read stop before draining so nothing queued before it is lost
+		stop = __atomic_load_n(&logger.stop, __ATOMIC_ACQUIRE);
+		fp = (logger.fp != NULL) ? logger.fp : stdout;
+		if (log_drain(fp) == 0) {
+			if (stop) {
+				break;
+			}
+			nanosleep(&nap, NULL);
+		}
+	}
+
+	return NULL;
+}
+
+/*! @brief  
+ *   Switch to async mode, log calls are queued and written by a background thread
+ *  @return 	- 0 on success else -1
+ * */
+int logger_start_async(void)
+{
+	if (logger.async) {
+		return 0;
+	}
+
+	pthread_once(&logger.once, log_key_init);
+	logger.stop = false;
+	if (pthread_create(&logger.thread, NULL, log_thread, NULL) != 0) {
+		return -1;
+	}
+	__atomic_store_n(&logger.async, true, __ATOMIC_RELEASE);
+
+	return 0;
+}
+
+/*! @brief  
+ *   Switch to binary mode, log calls are appended raw to a mapped file
+ *   to be rendered offline by logger_decode
+ *  @param path - file to log to (truncated)
+ *  @param size - bytes of the file, messages past it are dropped
+ *  @return 	- 0 on success else -1
+ * */
+int logger_start_binary(char *path, size_t size)
+{
+	t_log_bin_hdr *hdr;
+	int fd;
+
+	if (logger.bin != NULL || size < sizeof(t_log_bin_hdr)) {
+		return -1;
+	}
+
+	fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0) {
+		return -1;
+	}
+	if (ftruncate(fd, size) != 0) {
+		close(fd);
+		return -1;
+	}
+	hdr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (hdr == MAP_FAILED) {
+		close(fd);
+		return -1;
+	}
+
+	memcpy(hdr->magic, LOG_BIN_MAGIC, sizeof(hdr->magic));
+	hdr->size = size;
+	hdr->used = sizeof(t_log_bin_hdr);
+	hdr->dropped = 0;
+
+	logger.bin_fd = fd;
+	// sites are defined again in the new file
+	__atomic_add_fetch(&logger.bin_gen, 1, __ATOMIC_RELEASE);
+	__atomic_store_n(&logger.bin, hdr, __ATOMIC_RELEASE);
+
+	return 0;
+}
+
+/*! @brief  
+ *   Reserve an entry in the binary log file, lock free
+ *  @param hdr  - header of mapped file
+ *  @param len  - bytes of entry and payload
+ *  @param site - site id of entry
+ *  @return 	- payload of entry else NULL if file is full
+ * */
+static char *log_bin_reserve(t_log_bin_hdr *hdr, size_t len, uint32_t site)
+{
+	t_log_bin_entry *e;
+	uint64_t off;
+
+	len = (len + sizeof(t_log_bin_entry) + 7) & ~(size_t)7;
+	off = __atomic_fetch_add(&hdr->used, len, __ATOMIC_RELAXED);
+	if (off + len > hdr->size) {
+		__atomic_add_fetch(&hdr->dropped, 1, __ATOMIC_RELAXED);
+		return NULL;
+	}
+
+	e = (t_log_bin_entry*)((char*)hdr + off);
+	e->len = len;
+	e->site = site;
+	return (char*)(e + 1);
+}
+
+/*! @brief  
+ *   Get id of a call site, a new site is added to the site table
+ *  @param site   - cached site id of the call site (-1 till registered)
+ *  @param module - module name
+ *  @param level  - log level
+ *  @param format - format string
+ *  @return 	- site id else -1 if site table is full
+ * */
+static int log_site_id(int *site, char *module, int level, const char *format)
+{
+	int id = __atomic_load_n(site, __ATOMIC_RELAXED);
+
+	if (id >= 0) {
+		return id;
+	}
+
+	pthread_mutex_lock(&logger.lock);
+	if (log_site_count < LOG_SITE_MAX) {
+		id = log_site_count++;
+		log_sites[id].format = format;
+		strncpy(log_sites[id].module, module, LOG_NAME_LEN - 1);
+		log_sites[id].level = level;
+		__atomic_store_n(site, id, __ATOMIC_RELAXED);
+	}
+	pthread_mutex_unlock(&logger.lock);
+
+	return id;
+}
+
+/*! @brief  
+ *   Write the definition of a site to the binary log file once per file
+ *  @param hdr - header of mapped file
+ *  @param id  - site id
+ *  @return 	- NA
+ * */
+static void log_site_define(t_log_bin_hdr *hdr, int id)
+{
+	t_log_site *st = &log_sites[id];
+	unsigned int gen = __atomic_load_n(&logger.bin_gen, __ATOMIC_ACQUIRE);
+	size_t flen;
+	char *out;
+
+	if (__atomic_load_n(&st->gen, __ATOMIC_ACQUIRE) == gen) {
+		return;
+	}
+
+	pthread_mutex_lock(&logger.lock);
+	if (st->gen != gen) {
+		flen = strlen(st->format) + 1;
+		out = log_bin_reserve(hdr, sizeof(int32_t) + LOG_NAME_LEN + flen, id | LOG_BIN_SITE_DEF);
+		if (out != NULL) {
+			memcpy(out, &st->level, sizeof(int32_t));
+			memcpy(out + sizeof(int32_t), st->module, LOG_NAME_LEN);
+			memcpy(out + sizeof(int32_t) + LOG_NAME_LEN, st->format, flen);
+			__atomic_store_n(&st->gen, gen, __ATOMIC_RELEASE);
+		}
+	}
+	pthread_mutex_unlock(&logger.lock);
+}
+
+/*! @brief  
+ *   Append a log call to the binary log file, only the site id, time
+ *   stamp and packed args are written
+ *  @return 	- 0 if written else -1
+ * */
+static int log_bin_write(t_log_bin_hdr *hdr, int *site, char *module, int level,
+		const char *format, va_list args)
+{
+	char buf[sizeof(((t_log_rec*)0)->args)];
+	uint64_t ts = log_now_ns();
+	int id, len;
+	char *out;
+
+	id = log_site_id(site, module, level, format);
+	if (id < 0) {
+		return -1;
+	}
+	log_site_define(hdr, id);
+
+	len = log_pack(buf, sizeof(buf), format, args);
+	out = log_bin_reserve(hdr, sizeof(ts) + len, id);
+	if (out == NULL) {
+		return -1;
+	}
+	memcpy(out, &ts, sizeof(ts));
+	memcpy(out + sizeof(ts), buf, len);
+
+	return 0;
+}
+
+/*! @brief  
+ *   Render a binary log file as text
+ *  @param path - binary log file
+ *  @param fp   - output stream
+ *  @return 	- messages rendered else -1 if file is not a binary log
+ * */
+int logger_decode(char *path, FILE *fp)
+{
+	static const char *site_fmt[LOG_SITE_MAX];
+	static char site_mod[LOG_SITE_MAX][LOG_NAME_LEN];
+	static int site_level[LOG_SITE_MAX];
+	t_log_bin_hdr *hdr;
+	t_log_bin_entry *e;
+	struct stat st;
+	uint64_t off, used, ts;
+	uint32_t id;
+	char *pay;
+	int fd, count = 0;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		return -1;
+	}
+	if (fstat(fd, &st) != 0 || st.st_size < sizeof(t_log_bin_hdr)) {
+		close(fd);
+		return -1;
+	}
+	hdr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (hdr == MAP_FAILED) {
+		return -1;
+	}
+	if (memcmp(hdr->magic, LOG_BIN_MAGIC, sizeof(hdr->magic)) != 0) {
+		munmap(hdr, st.st_size);
+		return -1;
+	}
+
+	memset(site_fmt, 0, sizeof(site_fmt));
+	used = (hdr->used < st.st_size) ? hdr->used : st.st_size;
+	for (off = sizeof(t_log_bin_hdr); off + sizeof(t_log_bin_entry) <= used; off += e->len) {
+		e = (t_log_bin_entry*)((char*)hdr + off);
+		if (e->len < sizeof(t_log_bin_entry) + sizeof(ts) || off + e->len > used) {
+			break;
+		}
+		pay = (char*)(e + 1);
+		id = e->site & ~LOG_BIN_SITE_DEF;
+		if (id >= LOG_SITE_MAX) {
+			continue;
+		}
+
+		if (e->site & LOG_BIN_SITE_DEF) {
+			// format must end within the entry
+			if (memchr(pay + sizeof(int32_t) + LOG_NAME_LEN, '\0', e->len - sizeof(*e) -
+					sizeof(int32_t) - LOG_NAME_LEN) == NULL) {
+				continue;
+			}
+			memcpy(&site_level[id], pay, sizeof(int32_t));
+			memcpy(site_mod[id], pay + sizeof(int32_t), LOG_NAME_LEN - 1);
+			site_fmt[id] = pay + sizeof(int32_t) + LOG_NAME_LEN;
+		} else if (site_fmt[id] != NULL) {
+			memcpy(&ts, pay, sizeof(ts));
+			log_header(fp, ts, site_level[id], site_mod[id], NULL);
+			log_render(fp, site_fmt[id], pay + sizeof(ts), e->len - sizeof(*e) - sizeof(ts));
+			count++;
+		}
+	}
+	if (hdr->dropped != 0) {
+		fprintf(fp, "log messages dropped = %lu\n", hdr->dropped);
+	}
+
+	munmap(hdr, st.st_size);
+	return count;
+}
+
+/*! @brief  
+ *   Stop async and binary modes, writes what is still queued, to be called
+ *   once other threads are done logging (rings are kept for a later
+ *   logger_start_async)
+ *  @return 	- NA
+ * */
+void logger_finit(void)
+{
+	t_log_bin_hdr *hdr = logger.bin;
+	uint64_t used;
+
+	if (logger.async) {
+		__atomic_store_n(&logger.async, false, __ATOMIC_RELEASE);
+		__atomic_store_n(&logger.stop, true, __ATOMIC_RELEASE);
+		pthread_join(logger.thread, NULL);
+	}
+
+	if (hdr != NULL) {
+		__atomic_store_n(&logger.bin, NULL, __ATOMIC_RELEASE);
+		__atomic_add_fetch(&logger.dropped, hdr->dropped, __ATOMIC_RELAXED);
+		// trim file to what was written
+		used = (hdr->used < hdr->size) ? hdr->used : hdr->size;
+		hdr->used = used;
+		munmap(hdr, hdr->size);
+		if (ftruncate(logger.bin_fd, used) != 0) {
+			LOG_WARN("LOGGER", "binary log not trimmed\n");
+		}
+		close(logger.bin_fd);
+	}
+
+	if (logger.dropped != 0) {
+		printf("log messages dropped = %lu\n", logger.dropped);
+	}
+}
+
+/*! @brief  
+ *   Log messages lost as a ring was full, counted once reported by background thread
+ *  @return 	- dropped messages
+ * */
+size_t logger_dropped(void)
+{
+	return __atomic_load_n(&logger.dropped, __ATOMIC_RELAXED);
+}
+
+/*! @brief  
+ *   Log a call in the mode the logger is in
+ *  @param site   - cached site id of call site else NULL (not logged in binary mode)
+ *  @return 	- chars printed (0 if queued or written raw, -1 if dropped)
+ * */
+static int log_vlog(int *site, char *module, int level, char *prefix, const char *format, va_list args)
+{
+	t_log_bin_hdr *hdr;
+
+	// level of module was already checked at the call site
+	if (level < 0 || level >= MAX_LOG_LEVELS) {
+		return 0;
+	}
+
+	hdr = __atomic_load_n(&logger.bin, __ATOMIC_ACQUIRE);
+	if (hdr != NULL && site != NULL) {
+		return log_bin_write(hdr, site, module, level, format, args);
+	}
+	if (__atomic_load_n(&logger.async, __ATOMIC_ACQUIRE)) {
+		return log_enqueue(module, level, prefix, format, args);
+	} else {
+		FILE *fp = (logger.fp != NULL) ? logger.fp : stdout;
+
+		log_header(fp, log_now_ns(), level, module, prefix);
+		return vfprintf(fp, format, args);
+	}
+}
+
+/*! @brief  
+ *   Used for defining different logging modules such as warn, error, debug, trace ...
+ *  @return 	- chars printed (0 if queued in async mode, -1 if dropped)
+ * */
+int app_log(char *module, int level, char *prefix, const char *format, ...)
+{
+	int len;
+	va_list args;
+
+	va_start(args, format);
+	len = log_vlog(NULL, module, level, prefix, format, args);
+	va_end(args);
+
+	return len;
+}
+
+/*! @brief  
+ *   Log from a LOG_* call site, the site is registered once for binary mode
+ *  @param site - cached site id of the call site
+ *  @return 	- chars printed (0 if queued or written raw, -1 if dropped)
+ * */
+int app_log_site(int *site, char *module, int level, const char *format, ...)
+{
+	int len;
+	va_list args;
+
+	va_start(args, format);
+	len = log_vlog(site, module, level, NULL, format, args);
 	va_end(args);
 
 	return len;
@@ -1,20 +1,283 @@
 /*! @file memory_manager.c
     @brief 
     Contains definitions of routines for managing memory allocs
+    Tracking is sharded by block address, each shard has its own lock
+    so that tag_alloc/untag_alloc can be called from many threads
+    In release mode (MEM_RELEASE) only a random sample of allocations
+    is tracked, per call site, to estimate live memory and spot leaks
+    Every mode keeps a profile (live, peak, counts and size histogram)
+    per call site that can be dumped as a table or JSON
 */
 #include "common.h"
 
-static t_mem_manager memer; 
+/// Open addressing table of call sites, slots are never freed till mem_finit
+static t_mem_site mem_site[MEM_SITE_MAX];
+static int mem_site_count;
+static pthread_mutex_t mem_site_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/// Call sites that do not fit in the table are accounted here
+static t_mem_site mem_site_other = { .file = "(other sites)" };
+
+/*! @brief  
+ *   Get the profile of a call site, creating it on first use
+ *   Lookup is lock free, a new site is published under mem_site_lock
+ *  @param file - File where the alloc was made
+ *  @param line - Line where the alloc was made
+ *  @return 	- Pointer to site
+ * */
+static t_mem_site *mem_site_get(char *file, int line)
+{
+	uint64_t key = ((uint64_t)(uintptr_t)file ^ (uint64_t)line) * 0x9E3779B97F4A7C15ULL;
+	size_t idx = (size_t)(key >> 32) & (MEM_SITE_MAX - 1);
+	t_mem_site *site;
+	char *f;
+
+	for (;; idx = (idx + 1) & (MEM_SITE_MAX - 1)) {
+		site = &mem_site[idx];
+		f = __atomic_load_n(&site->file, __ATOMIC_ACQUIRE);
+		if (f == NULL) {
+			break;
+		}
+		if (f == file && site->line == line) {
+			return site;
+		}
+	}
+
+	// slots only ever fill, so probing resumes where lookup stopped
+	pthread_mutex_lock(&mem_site_lock);
+	for (;; idx = (idx + 1) & (MEM_SITE_MAX - 1)) {
+		site = &mem_site[idx];
+		if (site->file == NULL) {
+			break;
+		}
+		if (site->file == file && site->line == line) {
+			pthread_mutex_unlock(&mem_site_lock);
+			return site;
+		}
+	}
+	// keep a free slot so that probing ends
+	if (mem_site_count + 1 >= MEM_SITE_MAX) {
+		pthread_mutex_unlock(&mem_site_lock);
+		return &mem_site_other;
+	}
+	site->line = line;
+	__atomic_store_n(&site->file, file, __ATOMIC_RELEASE);
+	mem_site_count++;
+	pthread_mutex_unlock(&mem_site_lock);
+
+	return site;
+}
+
+/*! @brief  
+ *   Account an alloc to its call site
+ *  @param site  - Pointer to site
+ *  @param bytes - Bytes allocated
+ *  @return 	 - NA
+ * */
+static void mem_site_alloc(t_mem_site *site, size_t bytes)
+{
+	size_t live, peak;
+	int bin = 0;
+
+	// power of 2 bin of the size
+	if (bytes > (1UL << MEM_HIST_MIN_SHIFT)) {
+		bin = (int)(sizeof(long) * 8) - __builtin_clzl(bytes - 1) - MEM_HIST_MIN_SHIFT;
+		bin = bin < MEM_HIST_BINS ? bin : MEM_HIST_BINS - 1;
+	}
+
+	__atomic_add_fetch(&site->hist[bin], 1, __ATOMIC_RELAXED);
+	live = __atomic_add_fetch(&site->live_bytes, bytes, __ATOMIC_RELAXED);
+
+	// raise the high water mark
+	peak = __atomic_load_n(&site->peak_bytes, __ATOMIC_RELAXED);
+	while (live > peak && !__atomic_compare_exchange_n(&site->peak_bytes, &peak,
+				live, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+}
+
+/*! @brief  
+ *   Account a free to its call site
+ *  @param site  - Pointer to site
+ *  @param bytes - Bytes freed
+ *  @return 	 - NA
+ * */
+static void mem_site_free(t_mem_site *site, size_t bytes)
+{
+	__atomic_add_fetch(&site->free_count, 1, __ATOMIC_RELAXED);
+	__atomic_sub_fetch(&site->live_bytes, bytes, __ATOMIC_RELAXED);
+}
+
+/*! @brief  
+ *   Forget all call sites, called once no block references them
+ *  @return 	 - NA
+ * */
+static void mem_site_reset(void)
+{
+	pthread_mutex_lock(&mem_site_lock);
+	memset(mem_site, 0, sizeof(mem_site));
+	mem_site_count = 0;
+	memset(&mem_site_other, 0, sizeof(mem_site_other));
+	mem_site_other.file = "(other sites)";
+	pthread_mutex_unlock(&mem_site_lock);
+}
+
+/// Live large mappings, these are few so a locked array is enough
+static struct {
+	void *mem;			///< Start of mapping (huge page aligned)
+	size_t len;			///< Length of mapping
+} mem_large[MEM_LARGE_MAX];
+static int mem_large_count;
+static size_t mem_large_bytes;
+static pthread_mutex_t mem_large_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/*! @brief  
+ *   Map a big zeroed block on a huge page boundary, advise transparent
+ *   huge pages and prefault it so that first touch takes no faults
+ *   MAP_POPULATE is not used as it would fault in small pages before
+ *   the advice, the range is populated after madvise instead
+ *  @param bytes - size of block
+ *  @return      - memory address else NULL (caller falls back to os_alloc)
+ * */
+void *mem_large_alloc(size_t bytes)
+{
+	size_t len = (bytes + MEM_PAGE_SIZE - 1) & ~((size_t)MEM_PAGE_SIZE - 1);
+	char *base, *mem, *end;
+	size_t off;
+
+	// over map and trim so that the block starts on a huge page
+	base = mmap(NULL, len + MEM_LARGE_ALIGN, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (base == MAP_FAILED) {
+		return NULL;
+	}
+	mem = (char*)(((uintptr_t)base + MEM_LARGE_ALIGN - 1) & ~((uintptr_t)MEM_LARGE_ALIGN - 1));
+	end = base + len + MEM_LARGE_ALIGN;
+	if (mem != base) {
+		munmap(base, mem - base);
+	}
+	if (mem + len != end) {
+		munmap(mem + len, end - (mem + len));
+	}
+
+	pthread_mutex_lock(&mem_large_lock);
+	if (mem_large_count == MEM_LARGE_MAX) {
+		pthread_mutex_unlock(&mem_large_lock);
+		munmap(mem, len);
+		return NULL;
+	}
+	mem_large[mem_large_count].mem = mem;
+	mem_large[mem_large_count].len = len;
+	mem_large_count++;
+	mem_large_bytes += len;
+	pthread_mutex_unlock(&mem_large_lock);
+
+	madvise(mem, len, MADV_HUGEPAGE);
+#ifdef MADV_POPULATE_WRITE
+	if (madvise(mem, len, MADV_POPULATE_WRITE) == 0) {
+		return mem;
+	}
+#endif
+	// older kernels, touch every page
+	for (off = 0; off < len; off += MEM_PAGE_SIZE) {
+		((volatile char*)mem)[off] = 0;
+	}
+
+	return mem;
+}
+
+/*! @brief  
+ *   Unmap a block got from mem_large_alloc
+ *  @param mem_addr - memory address
+ *  @return         - true if address was a large mapping
+ * */
+bool mem_large_free(void *mem_addr)
+{
+	size_t len;
+	int i;
+
+	pthread_mutex_lock(&mem_large_lock);
+	for (i = 0; i < mem_large_count; i++) {
+		if (mem_large[i].mem == mem_addr) {
+			break;
+		}
+	}
+	if (i == mem_large_count) {
+		pthread_mutex_unlock(&mem_large_lock);
+		return false;
+	}
+	len = mem_large[i].len;
+	mem_large[i] = mem_large[--mem_large_count];
+	mem_large_bytes -= len;
+	pthread_mutex_unlock(&mem_large_lock);
+
+	munmap(mem_addr, len);
+	return true;
+}
+
+/*! @brief  
+ *   Print live large mappings if there are any
+ *  @return         - NA
+ * */
+static void mem_large_report(void)
+{
+	pthread_mutex_lock(&mem_large_lock);
+	if (mem_large_count != 0) {
+		printf("large mappings = %4d [%lu Byte(s)]\n", mem_large_count, mem_large_bytes);
+	}
+	pthread_mutex_unlock(&mem_large_lock);
+}
+
+#ifndef MEM_RELEASE
+/// Initializer of a shard, the rest of the shard starts zeroed
+#define MEM_SHARD_INIT		{ .lock = PTHREAD_MUTEX_INITIALIZER }
+
+static t_mem_manager memer = {
+	.shard = { [0 ... MEM_SHARDS - 1] = MEM_SHARD_INIT }
+};
 
+/*! @brief  
+ *   Mix an address, low bits of heap addresses are mostly zero
+ *   due to alignment so the address is mixed with a fibonacci multiplier
+ *  @param mem_addr - address to hash
+ *  @return 	- hash of address
+ * */
+static inline uint64_t mem_hash(void *mem_addr)
+{
+	uint64_t key = (uint64_t)(uintptr_t)mem_addr;
+
+	key ^= key >> 32;
+	key *= 0x9E3779B97F4A7C15ULL;
+
+	return key;
+}
+
+/*! @brief  
+ *   Get the shard tracking an address, top bits of the hash are used
+ *  @param mem_addr - address
+ *  @return 	- Pointer to shard
+ * */
+static inline t_mem_shard *mem_shard(void *mem_addr)
+{
+	return &memer.shard[mem_hash(mem_addr) >> (64 - MEM_SHARD_BITS)];
+}
+
+#ifdef MEM_HDR_TRACKING
 /*! @brief  
  *   Initailize memory module
  *  @return 	- NA
  * */
 void mem_init() 
 { 
-	memer.mem_record = NULL;
-	memer.alloc_count = 0;
-	memer.free_count = 0;
+	t_mem_shard *sh;
+	int i;
+
+	for (i = 0; i < MEM_SHARDS; i++) {
+		sh = &memer.shard[i];
+		pthread_mutex_lock(&sh->lock);
+		sh->head.nxt = sh->head.prv = &sh->head;
+		sh->alloc_count = 0;
+		sh->free_count = 0;
+		pthread_mutex_unlock(&sh->lock);
+	}
 }
 
 /*! @brief  
@@ -23,92 +286,729 @@ void mem_init()
  * */
 void mem_finit(void) 
 {
-	t_mem_record *iter = NULL;
+	t_mem_header *iter, *nxt;
+	t_mem_shard *sh;
+	int i;
+
 	mem_alloc_report();
-	if (memer.mem_record != NULL) {
-		for (iter = memer.mem_record ; iter != NULL; iter = iter->next) {
+	for (i = 0; i < MEM_SHARDS; i++) {
+		sh = &memer.shard[i];
+		pthread_mutex_lock(&sh->lock);
+		for (iter = sh->head.nxt; iter != NULL && iter != &sh->head; iter = nxt) {
+			nxt = iter->nxt;
 			printf("cleaning up allocated memory space @{%s:%d} [%lu Byte(s)] - %p\n", 
-					iter->file, iter->line, iter->block_size, iter->mem);
-			os_free(iter);
+					iter->site->file, iter->site->line, iter->block_size,
+					(char*)iter + MEM_HDR_SIZE);
+			iter->magic = 0;
+			mem_os_free(iter);
 		}
+		sh->head.nxt = sh->head.prv = &sh->head;
+		sh->alloc_count = 0;
+		sh->free_count = 0;
+		pthread_mutex_unlock(&sh->lock);
 	}
-	memer.alloc_count = 0;
-	memer.free_count = 0;
-
+	mem_site_reset();
+#ifdef CUSTOM_MALLOC
+	slab_finit();
+#endif
 }
 
 /*! @brief  
- *   allocate memory and store in mem list (tagging)
+ *   allocate memory with the alloc info kept in a header
+ *   in front of the block and link it to the leak list (tagging)
  *  @return - memory address
  * */
 t_gen tag_alloc(size_t nmemb, size_t size, char *file, int line)
 {
-	//TODO:add resource lock
-	t_mem_record *new_mem = os_alloc(1, sizeof(t_mem_record));
-	if (new_mem == NULL) {
+	t_mem_header *hdr;
+	t_mem_shard *sh;
+
+	// one allocation holds both the header and the block
+	hdr = mem_os_alloc(1, MEM_HDR_SIZE + nmemb * size);
+	if (hdr == NULL) {
+		printf("Memory allocation failed\n");
+		return NULL;
+	}
+	hdr->nmemb = nmemb;
+	hdr->block_size = size;
+	hdr->site = mem_site_get(file, line);
+	hdr->magic = MEM_HDR_MAGIC;
+	mem_site_alloc(hdr->site, nmemb * size);
+
+	sh = mem_shard(hdr);
+	pthread_mutex_lock(&sh->lock);
+	// mem_init not called yet
+	if (sh->head.nxt == NULL) {
+		sh->head.nxt = sh->head.prv = &sh->head;
+	}
+
+	// link at head of list
+	hdr->prv = &sh->head;
+	hdr->nxt = sh->head.nxt;
+	sh->head.nxt->prv = hdr;
+	sh->head.nxt = hdr;
+	sh->alloc_count++;
+	pthread_mutex_unlock(&sh->lock);
+
+	return (char*)hdr + MEM_HDR_SIZE;
+}
+
+/*! @brief  
+ *   unlink block from the leak list in O(1) and deallocate (untagging)
+ *  @return - NA
+ * */
+void untag_alloc(void *mem_addr, char *file, int line)
+{
+	t_mem_header *hdr;
+	t_mem_shard *sh;
+
+	if (mem_addr == NULL)
+		return;
+
+	hdr = (t_mem_header*)((char*)mem_addr - MEM_HDR_SIZE);
+	if (hdr->magic != MEM_HDR_MAGIC) {
+		printf("free of untagged memory @{%s:%d} - %p\n", file, line, mem_addr);
+		return;
+	}
+
+	sh = mem_shard(hdr);
+	pthread_mutex_lock(&sh->lock);
+	hdr->prv->nxt = hdr->nxt;
+	hdr->nxt->prv = hdr->prv;
+	hdr->magic = 0;
+	sh->free_count++;
+	pthread_mutex_unlock(&sh->lock);
+	mem_site_free(hdr->site, hdr->nmemb * hdr->block_size);
+	mem_os_free(hdr);
+}
+
+#else
+/*! @brief  
+ *   Hash an address to a slot of the record table of a shard
+ *   bits below the ones picking the shard are used
+ *  @param sh       - Pointer to shard
+ *  @param mem_addr - address to hash
+ *  @return 	- slot index
+ * */
+static inline size_t mem_slot(t_mem_shard *sh, void *mem_addr)
+{
+	return (size_t)(mem_hash(mem_addr) >> 16) & (sh->size - 1);
+}
+
+/*! @brief  
+ *   Place a record in the table (table has at least one free slot)
+ *  @param sh   - Pointer to shard
+ *  @param rec  - record to be stored
+ *  @return 	- NA
+ * */
+static void mem_record_put(t_mem_shard *sh, t_mem_record *rec)
+{
+	size_t idx = mem_slot(sh, rec->mem);
+
+	// linear probe till an empty slot
+	while (sh->mem_record[idx].mem != NULL) {
+		idx = (idx + 1) & (sh->size - 1);
+	}
+	sh->mem_record[idx] = *rec;
+	sh->used++;
+}
+
+/*! @brief  
+ *   Resize the record table of a shard and rehash all live records
+ *  @param sh   - Pointer to shard
+ *  @param size - new slot count (power of 2)
+ *  @return 	- true on success
+ * */
+static bool mem_record_resize(t_mem_shard *sh, size_t size)
+{
+	t_mem_record *old = sh->mem_record;
+	size_t old_size = sh->size, i;
+	t_mem_record *tbl = mem_os_alloc(size, sizeof(t_mem_record));
+
+	if (tbl == NULL) {
 		printf("Memory allocation for tracker failed\n");
+		return false;
 	}
-	new_mem->nmemb = nmemb;
-	new_mem->block_size = size;
-	new_mem->file = file;
-	new_mem->line = line;
-	new_mem->next = NULL;
 
-	new_mem->mem = os_alloc(nmemb, size);
-	if (new_mem->mem == NULL) {
-		printf("Memory allocation failed\n");
+	sh->mem_record = tbl;
+	sh->size = size;
+	sh->used = 0;
+	for (i = 0; i < old_size; i++) {
+		if (old[i].mem != NULL) {
+			mem_record_put(sh, &old[i]);
+		}
 	}
-	else {
-		memer.alloc_count++;
-		new_mem->next = memer.mem_record;
-		memer.mem_record = new_mem;
+	if (old != NULL) {
+		mem_os_free(old);
 	}
 
+	return true;
+}
 
-	return (new_mem->mem);
+/*! @brief  
+ *   Initailize memory module
+ *  @return 	- NA
+ * */
+void mem_init() 
+{ 
+	t_mem_shard *sh;
+	int i;
 
+	for (i = 0; i < MEM_SHARDS; i++) {
+		sh = &memer.shard[i];
+		pthread_mutex_lock(&sh->lock);
+		sh->alloc_count = 0;
+		sh->free_count = 0;
+		if (sh->mem_record == NULL) {
+			mem_record_resize(sh, MEM_RECORD_INIT_SIZE);
+		}
+		pthread_mutex_unlock(&sh->lock);
+	}
 }
 
+/*! @brief  
+ *   Close memory module by checking and destroying if any tagged memory
+ *  @return 	- NA
+ * */
+void mem_finit(void) 
+{
+	t_mem_record *iter = NULL;
+	t_mem_shard *sh;
+	size_t i;
+	int j;
 
+	mem_alloc_report();
+	for (j = 0; j < MEM_SHARDS; j++) {
+		sh = &memer.shard[j];
+		pthread_mutex_lock(&sh->lock);
+		for (i = 0; i < sh->size; i++) {
+			iter = &sh->mem_record[i];
+			if (iter->mem != NULL) {
+				printf("cleaning up allocated memory space @{%s:%d} [%lu Byte(s)] - %p\n", 
+						iter->site->file, iter->site->line, iter->block_size, iter->mem);
+				mem_os_free(iter->mem);
+			}
+		}
+		if (sh->mem_record != NULL) {
+			mem_os_free(sh->mem_record);
+		}
+		sh->mem_record = NULL;
+		sh->size = 0;
+		sh->used = 0;
+		sh->alloc_count = 0;
+		sh->free_count = 0;
+		pthread_mutex_unlock(&sh->lock);
+	}
+	mem_site_reset();
+#ifdef CUSTOM_MALLOC
+	slab_finit();
+#endif
+
+}
 
 /*! @brief  
- *   deallocate memory and remove from mem list (untagging)
+ *   allocate memory and store in mem table (tagging)
+ *   only the shard owning the new address is locked
  *  @return - memory address
  * */
+t_gen tag_alloc(size_t nmemb, size_t size, char *file, int line)
+{
+	t_mem_record new_mem;
+	t_mem_shard *sh;
+
+	new_mem.nmemb = nmemb;
+	new_mem.block_size = size;
+	new_mem.site = mem_site_get(file, line);
+
+	new_mem.mem = mem_os_alloc(nmemb, size);
+	if (new_mem.mem == NULL) {
+		printf("Memory allocation failed\n");
+		return NULL;
+	}
+
+	sh = mem_shard(new_mem.mem);
+	pthread_mutex_lock(&sh->lock);
+	// keep load factor under 1/2 so that probe sequences stay short
+	if ((sh->used + 1) * 2 > sh->size) {
+		if (mem_record_resize(sh, sh->size ? sh->size * 2 :
+					MEM_RECORD_INIT_SIZE) != true) {
+			pthread_mutex_unlock(&sh->lock);
+			mem_os_free(new_mem.mem);
+			return NULL;
+		}
+	}
+	sh->alloc_count++;
+	mem_record_put(sh, &new_mem);
+	pthread_mutex_unlock(&sh->lock);
+	mem_site_alloc(new_mem.site, nmemb * size);
+
+	return (new_mem.mem);
+
+}
+
+
+
+/*! @brief  
+ *   deallocate memory and remove from mem table (untagging)
+ *   The slot is emptied by shifting back the records of the same
+ *   probe chain, so no tombstones are left behind
+ *  @return - NA
+ * */
 void untag_alloc(void *mem_addr, char *file, int line)
 {
-	t_mem_record * mem_list = NULL, *prev_addr = NULL;
-	if (memer.mem_record == NULL)
+	size_t idx, nxt, home;
+	t_mem_shard *sh;
+	t_mem_site *site;
+	size_t bytes;
+
+	if (mem_addr == NULL)
 		return;
 
-	for (mem_list = memer.mem_record; mem_list != NULL; prev_addr = mem_list, mem_list = mem_list->next) {
-		if (mem_addr == mem_list->mem) {
+	sh = mem_shard(mem_addr);
+	pthread_mutex_lock(&sh->lock);
+	if (sh->used == 0) {
+		pthread_mutex_unlock(&sh->lock);
+		return;
+	}
 
-			if (mem_addr == memer.mem_record->mem) {
-				memer.mem_record = mem_list->next;
-			}
-			else {
-				prev_addr->next = mem_list->next;
-			}
+	// Find the record of the address
+	for (idx = mem_slot(sh, mem_addr); sh->mem_record[idx].mem != mem_addr;
+			idx = (idx + 1) & (sh->size - 1)) {
+		// address not tagged
+		if (sh->mem_record[idx].mem == NULL) {
+			pthread_mutex_unlock(&sh->lock);
+			return;
+		}
+	}
 
-			if (mem_addr)	{
-				os_free(mem_addr);
-				mem_addr = NULL;
-				memer.free_count++;
-			}
+	sh->free_count++;
+	sh->used--;
+	site = sh->mem_record[idx].site;
+	bytes = sh->mem_record[idx].nmemb * sh->mem_record[idx].block_size;
 
-			os_free(mem_list);
+	// backward shift deletion
+	for (nxt = (idx + 1) & (sh->size - 1); sh->mem_record[nxt].mem != NULL;
+			nxt = (nxt + 1) & (sh->size - 1)) {
+		home = mem_slot(sh, sh->mem_record[nxt].mem);
+		// move record if its home slot is not in (idx, nxt]
+		if (((nxt - home) & (sh->size - 1)) >= ((nxt - idx) & (sh->size - 1))) {
+			sh->mem_record[idx] = sh->mem_record[nxt];
+			idx = nxt;
 		}
 	}
+	sh->mem_record[idx].mem = NULL;
+	pthread_mutex_unlock(&sh->lock);
+
+	// address is untracked now, the os free needs no lock
+	mem_site_free(site, bytes);
+	mem_os_free(mem_addr);
 }
 
 
+#endif
+
 /*! @brief  
  *  print report of all the assigned memory
+ *  counts of all shards are summed up
  *  @return - NA
  * */
 void mem_alloc_report(void)
 {
+	int i, alloc_count = 0, free_count = 0;
+
+	for (i = 0; i < MEM_SHARDS; i++) {
+		pthread_mutex_lock(&memer.shard[i].lock);
+		alloc_count += memer.shard[i].alloc_count;
+		free_count += memer.shard[i].free_count;
+		pthread_mutex_unlock(&memer.shard[i].lock);
+	}
+
 	printf("allocations = %4d , freed allocations = %4d\n", 
-	           memer.alloc_count, memer.free_count);
+	           alloc_count, free_count);
+	mem_large_report();
+#ifdef CUSTOM_MALLOC
+	slab_report();
+#endif
+}
+
+#else
+static t_mem_manager memer = { .lock = PTHREAD_MUTEX_INITIALIZER };
+
+/// Allocs left before the thread samples again
+__thread long mem_sample_countdown;
+
+/// Per thread state of sampling interval generator
+static __thread uint64_t mem_sample_seed;
+
+/// Count of live samples hashing to each slot, read lock free on free
+uint16_t mem_sample_filter[1 << MEM_FILTER_BITS];
+
+/*! @brief  
+ *   Pick allocs till the next sample, uniform in [1, 2 * MEM_SAMPLE_RATE)
+ *   so that on average 1 in MEM_SAMPLE_RATE allocs is sampled
+ *  @return 	- NA
+ * */
+static void mem_sample_rearm(void)
+{
+	uint64_t x = mem_sample_seed;
+
+	// seed each thread differently
+	if (x == 0) {
+		x = (uint64_t)(uintptr_t)&mem_sample_seed ^ (uint64_t)time(NULL);
+		x |= 1;
+	}
+	// xorshift64
+	x ^= x << 13;
+	x ^= x >> 7;
+	x ^= x << 17;
+	mem_sample_seed = x;
+
+	mem_sample_countdown = 1 + (long)(x % (2 * MEM_SAMPLE_RATE - 1));
+}
+
+/*! @brief  
+ *   Hash an address to a slot of the sample table
+ *  @param mem_addr - address to hash
+ *  @return 	- slot index
+ * */
+static inline size_t mem_slot(void *mem_addr)
+{
+	uint64_t key = (uint64_t)(uintptr_t)mem_addr;
+
+	key ^= key >> 32;
+	key *= 0x9E3779B97F4A7C15ULL;
+
+	return (size_t)(key >> 16) & (memer.size - 1);
+}
+
+/*! @brief  
+ *   Place a sample in the table (table has at least one free slot)
+ *  @param smp  - sample to be stored
+ *  @return 	- NA
+ * */
+static void mem_sample_put(t_mem_sample *smp)
+{
+	size_t idx = mem_slot(smp->mem);
+
+	// linear probe till an empty slot
+	while (memer.sample[idx].mem != NULL) {
+		idx = (idx + 1) & (memer.size - 1);
+	}
+	memer.sample[idx] = *smp;
+	memer.used++;
+}
+
+/*! @brief  
+ *   Resize the sample table and rehash all live samples
+ *  @param size - new slot count (power of 2)
+ *  @return 	- true on success
+ * */
+static bool mem_sample_resize(size_t size)
+{
+	t_mem_sample *old = memer.sample;
+	size_t old_size = memer.size, i;
+	t_mem_sample *tbl = mem_os_alloc(size, sizeof(t_mem_sample));
+
+	if (tbl == NULL) {
+		return false;
+	}
+
+	memer.sample = tbl;
+	memer.size = size;
+	memer.used = 0;
+	for (i = 0; i < old_size; i++) {
+		if (old[i].mem != NULL) {
+			mem_sample_put(&old[i]);
+		}
+	}
+	if (old != NULL) {
+		mem_os_free(old);
+	}
+
+	return true;
+}
+
+/*! @brief  
+ *   Initailize memory module
+ *  @return 	- NA
+ * */
+void mem_init() 
+{ 
+	mem_sample_rearm();
+}
+
+/*! @brief  
+ *   Close memory module, untracked blocks can not be cleaned up
+ *   in release mode so only the sampled estimate is reported
+ *  @return 	- NA
+ * */
+void mem_finit(void) 
+{
+	mem_alloc_report();
+
+	pthread_mutex_lock(&memer.lock);
+	if (memer.sample != NULL) {
+		mem_os_free(memer.sample);
+	}
+	memer.sample = NULL;
+	memer.size = 0;
+	memer.used = 0;
+	memset(mem_sample_filter, 0, sizeof(mem_sample_filter));
+	pthread_mutex_unlock(&memer.lock);
+	mem_site_reset();
+#ifdef CUSTOM_MALLOC
+	slab_finit();
+#endif
+}
+
+/*! @brief  
+ *   allocate memory and record it against its call site (sampling)
+ *  @return - memory address
+ * */
+void *mem_sample_alloc(size_t nmemb, size_t size, char *file, int line)
+{
+	t_mem_sample smp;
+
+	mem_sample_rearm();
+
+	smp.mem = mem_os_alloc(nmemb, size);
+	if (smp.mem == NULL) {
+		return NULL;
+	}
+	smp.bytes = nmemb * size;
+
+	smp.site = mem_site_get(file, line);
+
+	pthread_mutex_lock(&memer.lock);
+	// keep load factor under 1/2 so that probe sequences stay short
+	if ((memer.used + 1) * 2 > memer.size &&
+			mem_sample_resize(memer.size ? memer.size * 2 :
+				MEM_SAMPLE_INIT_SIZE) != true) {
+		pthread_mutex_unlock(&memer.lock);
+		return smp.mem;
+	}
+	mem_sample_put(&smp);
+	mem_site_alloc(smp.site, smp.bytes);
+	__atomic_add_fetch(&mem_sample_filter[mem_filter_slot(smp.mem)], 1,
+			__ATOMIC_RELAXED);
+	pthread_mutex_unlock(&memer.lock);
+
+	return smp.mem;
+}
+
+/*! @brief  
+ *   deallocate memory dropping its sample if it was sampled
+ *  @return - NA
+ * */
+void mem_sample_free(void *mem_addr)
+{
+	size_t idx, nxt, home;
+	t_mem_sample *smp;
+
+	pthread_mutex_lock(&memer.lock);
+	for (idx = memer.size ? mem_slot(mem_addr) : 0; memer.size != 0;
+			idx = (idx + 1) & (memer.size - 1)) {
+		smp = &memer.sample[idx];
+		// not sampled, a filter slot shared with a sample
+		if (smp->mem == NULL) {
+			break;
+		}
+		if (smp->mem != mem_addr) {
+			continue;
+		}
+
+		mem_site_free(smp->site, smp->bytes);
+		__atomic_sub_fetch(&mem_sample_filter[mem_filter_slot(mem_addr)], 1,
+				__ATOMIC_RELAXED);
+		memer.used--;
+
+		// backward shift deletion
+		for (nxt = (idx + 1) & (memer.size - 1); memer.sample[nxt].mem != NULL;
+				nxt = (nxt + 1) & (memer.size - 1)) {
+			home = mem_slot(memer.sample[nxt].mem);
+			if (((nxt - home) & (memer.size - 1)) >= ((nxt - idx) & (memer.size - 1))) {
+				memer.sample[idx] = memer.sample[nxt];
+				idx = nxt;
+			}
+		}
+		memer.sample[idx].mem = NULL;
+		break;
+	}
+	pthread_mutex_unlock(&memer.lock);
+
+	mem_os_free(mem_addr);
+}
+
+/*! @brief  
+ *   allocate memory, same as get_mem (for callers using the fn directly)
+ *  @return - memory address
+ * */
+t_gen tag_alloc(size_t nmemb, size_t size, char *file, int line)
+{
+	return mem_release_alloc(nmemb, size, file, line);
+}
+
+/*! @brief  
+ *   deallocate memory, same as free_mem (used as FREE_MEM fn ptr)
+ *  @return - NA
+ * */
+void untag_alloc(void *mem_addr, char *file, int line)
+{
+	mem_release_free(mem_addr);
+}
+
+/*! @brief  
+ *  print estimated live memory of each call site, got by scaling
+ *  the sampled profile of the site by the sample rate
+ *  @return - NA
+ * */
+void mem_alloc_report(void)
+{
+	printf("sampled 1 in %d allocations\n", MEM_SAMPLE_RATE);
+	mem_profile_dump(stdout, eMEM_DUMP_TABLE);
+	mem_large_report();
+#ifdef CUSTOM_MALLOC
+	slab_report();
+#endif
+}
+#endif
+
+/// Profile counters are scaled by this when dumped
+#ifdef MEM_RELEASE
+#define MEM_SITE_SCALE		MEM_SAMPLE_RATE
+#else
+#define MEM_SITE_SCALE		1
+#endif
+
+/*! @brief  
+ *   qsort compare of call sites, biggest live bytes first then peak
+ *  @return - order of sites
+ * */
+static int mem_site_cmpr(const void *x, const void *y)
+{
+	const t_mem_site *a = *(t_mem_site* const*)x;
+	const t_mem_site *b = *(t_mem_site* const*)y;
+
+	if (a->live_bytes != b->live_bytes) {
+		return (a->live_bytes < b->live_bytes) - (a->live_bytes > b->live_bytes);
+	}
+	return (a->peak_bytes < b->peak_bytes) - (a->peak_bytes > b->peak_bytes);
+}
+
+/*! @brief  
+ *   Print a string as JSON string (quoted and escaped)
+ *  @param fp  - Output stream
+ *  @param str - String to print
+ *  @return    - NA
+ * */
+static void mem_json_str(FILE *fp, const char *str)
+{
+	fputc('"', fp);
+	for (; *str; str++) {
+		if (*str == '"' || *str == '\\') {
+			fputc('\\', fp);
+		}
+		fputc(*str, fp);
+	}
+	fputc('"', fp);
+}
+
+/*! @brief  
+ *   Allocations made at a call site
+ *  @param site - Pointer to site
+ *  @return     - alloc count
+ * */
+static size_t mem_site_allocs(t_mem_site *site)
+{
+	size_t n = 0;
+	int i;
+
+	for (i = 0; i < MEM_HIST_BINS; i++) {
+		n += site->hist[i];
+	}
+
+	return n;
+}
+
+/*! @brief  
+ *   Dump memory profile of every call site sorted by live bytes
+ *   Counters are read while allocs go on, so a dump taken under
+ *   load is a close snapshot rather than an exact one
+ *  @param fp  - Output stream
+ *  @param fmt - eMEM_DUMP_TABLE or eMEM_DUMP_JSON
+ *  @return    - NA
+ * */
+void mem_profile_dump(FILE *fp, e_mem_dump fmt)
+{
+	t_mem_site **sites, *site;
+	size_t live = 0, peak = 0;
+	int i, j, n = 0;
+
+	sites = os_alloc(MEM_SITE_MAX + 1, sizeof(t_mem_site*));
+	if (sites == NULL) {
+		return;
+	}
+
+	pthread_mutex_lock(&mem_site_lock);
+	for (i = 0; i < MEM_SITE_MAX; i++) {
+		if (mem_site[i].file != NULL) {
+			sites[n++] = &mem_site[i];
+		}
+	}
+	if (mem_site_allocs(&mem_site_other) != 0) {
+		sites[n++] = &mem_site_other;
+	}
+	pthread_mutex_unlock(&mem_site_lock);
+	qsort(sites, n, sizeof(t_mem_site*), mem_site_cmpr);
+
+	if (fmt == eMEM_DUMP_JSON) {
+		fprintf(fp, "[");
+		for (i = 0; i < n; i++) {
+			site = sites[i];
+			fprintf(fp, "%s\n {\"file\": ", i ? "," : "");
+			mem_json_str(fp, site->file);
+			fprintf(fp, ", \"line\": %d, \"allocs\": %lu, \"frees\": %lu, "
+					"\"live_bytes\": %lu, \"peak_bytes\": %lu, \"hist\": [",
+					site->line, mem_site_allocs(site) * MEM_SITE_SCALE,
+					site->free_count * MEM_SITE_SCALE,
+					site->live_bytes * MEM_SITE_SCALE,
+					site->peak_bytes * MEM_SITE_SCALE);
+			for (j = 0; j < MEM_HIST_BINS; j++) {
+				fprintf(fp, "%s%lu", j ? ", " : "", site->hist[j] * MEM_SITE_SCALE);
+			}
+			fprintf(fp, "]}");
+		}
+		fprintf(fp, "\n]\n");
+		os_free(sites);
+		return;
+	}
+
+	fprintf(fp, "%-40s %10s %10s %12s %12s  %s\n", "site", "allocs", "frees",
+			"live(B)", "peak(B)", "size histogram (<=B:count)");
+	for (i = 0; i < n; i++) {
+		site = sites[i];
+		fprintf(fp, "%-34.34s:%-5d %10lu %10lu %12lu %12lu ", site->file, site->line,
+				mem_site_allocs(site) * MEM_SITE_SCALE,
+				site->free_count * MEM_SITE_SCALE,
+				site->live_bytes * MEM_SITE_SCALE,
+				site->peak_bytes * MEM_SITE_SCALE);
+		for (j = 0; j < MEM_HIST_BINS; j++) {
+			if (site->hist[j] == 0) {
+				continue;
+			}
+			if (j == MEM_HIST_BINS - 1) {
+				fprintf(fp, " >%lu:%lu", 1UL << (MEM_HIST_MIN_SHIFT + j - 1),
+						site->hist[j] * MEM_SITE_SCALE);
+			} else {
+				fprintf(fp, " %lu:%lu", 1UL << (MEM_HIST_MIN_SHIFT + j),
+						site->hist[j] * MEM_SITE_SCALE);
+			}
+		}
+		fprintf(fp, "\n");
+		live += site->live_bytes;
+		peak += site->peak_bytes;
+	}
+	fprintf(fp, "%-40s %10s %10s %12lu %12lu\n", "total", "", "",
+			live * MEM_SITE_SCALE, peak * MEM_SITE_SCALE);
+	os_free(sites);
 }
@@ -0,0 +1,206 @@
+/*! @file profiler.c
+    @brief 
+    Contains definitions of the sampling profiler routines
+    The SIGPROF handler only bumps a counter and calls backtrace into a
+    preallocated slot, symbols are resolved when profiling stops
+*/
+
+#include "common.h"
+#include <execinfo.h>
+
+static t_profiler prof;
+
+/*! @brief  
+ *  SIGPROF handler, takes a backtrace into the next free sample slot
+ *  @param signo - Signal number
+ *  @param info  - Signal info
+ *  @param extra - Signal context
+ *  @return      - NA
+ * */
+static void prof_handler(int signo, siginfo_t *info, void *extra)
+{
+	size_t idx = __atomic_fetch_add(&prof.count, 1, __ATOMIC_RELAXED);
+	int saved_errno = errno;
+
+	if (idx < PROF_MAX_SAMPLES) {
+		prof.samples[idx].depth = backtrace(prof.samples[idx].pc, PROF_DEPTH);
+	}
+	errno = saved_errno;
+}
+
+/*! @brief  
+ *  Start sampling the process, samples are written to path at exit or
+ *  on profiler_stop
+ *  @param path - File to write folded stacks to
+ *  @param hz   - Samples per second of cpu time (0 for PROF_HZ)
+ *  @return     - 0 on success else -1
+ * */
+int profiler_start(char *path, int hz)
+{
+	static bool hooked = false;
+	struct sigaction action = {0};
+	struct sigevent sev = {0};
+	struct itimerspec its = {0};
+	long long period;
+	void *warm[1];
+
+	if (prof.running) {
+		return -1;
+	}
+	hz = (hz > 0) ? hz : PROF_HZ;
+
+	// a zero interval would disarm the timer
+	period = 1000000000LL / hz;
+	if (period == 0) {
+		LOG_WARN("PROFILER", "%d hz beyond timer resolution\n", hz);
+		return -1;
+	}
+
+	if (prof.samples == NULL) {
+		prof.samples = mmap(NULL, PROF_MAX_SAMPLES * sizeof(t_prof_sample),
+				PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (prof.samples == MAP_FAILED) {
+			prof.samples = NULL;
+			return -1;
+		}
+	}
+	strncpy(prof.path, path, PATH_MAX - 1);
+	prof.count = 0;
+
+	// first backtrace call loads the unwinder, keep that out of the handler
+	backtrace(warm, 1);
+
+	action.sa_flags = SA_SIGINFO | SA_RESTART;
+	action.sa_sigaction = prof_handler;
+	sigemptyset(&action.sa_mask);
+	if (sigaction(SIGPROF, &action, &prof.old) == -1) {
+		perror("sigprof: sigaction");
+		return -1;
+	}
+
+	sev.sigev_notify = SIGEV_SIGNAL;
+	sev.sigev_signo = SIGPROF;
+	if (timer_create(CLOCK_PROCESS_CPUTIME_ID, &sev, &prof.timer) == -1) {
+		perror("profiler: timer_create");
+		sigaction(SIGPROF, &prof.old, NULL);
+		return -1;
+	}
+	its.it_interval.tv_sec = period / 1000000000LL;
+	its.it_interval.tv_nsec = period % 1000000000LL;
+	its.it_value = its.it_interval;
+	if (timer_settime(prof.timer, 0, &its, NULL) == -1) {
+		perror("profiler: timer_settime");
+		timer_delete(prof.timer);
+		sigaction(SIGPROF, &prof.old, NULL);
+		return -1;
+	}
+	prof.running = true;
+
+	if (!hooked) {
+		atexit(profiler_stop);
+		hooked = true;
+	}
+
+	return 0;
+}
+
+/*! @brief  
+ *  Stop the timer without writing samples, safe in a signal handler,
+ *  the samples are still written by profiler_stop (run at exit)
+ *  @return     - NA
+ * */
+void profiler_disarm(void)
+{
+	struct itimerspec its = {0};
+
+	if (prof.running) {
+		timer_settime(prof.timer, 0, &its, NULL);
+	}
+}
+
+/*! @brief  
+ *  Compare two samples by their frames, groups equal stacks when sorting
+ *  @return     - <0, 0 or >0 as for qsort
+ * */
+static int prof_cmpr(const void *a, const void *b)
+{
+	const t_prof_sample *x = a, *y = b;
+
+	if (x->depth != y->depth) {
+		return x->depth - y->depth;
+	}
+	return memcmp(x->pc, y->pc, x->depth * sizeof(void*));
+}
+
+/*! @brief  
+ *  Write one stack in folded form "outer;...;inner count"
+ *  @param fp    - Output file
+ *  @param s     - Sample
+ *  @param count - Samples with this stack
+ *  @return      - NA
+ * */
+static void prof_write_stack(FILE *fp, t_prof_sample *s, size_t count)
+{
+	int i, n = s->depth - PROF_SKIP;
+	char **syms, *name, *end;
+
+	if (n <= 0) {
+		return;
+	}
+	syms = backtrace_symbols(s->pc + PROF_SKIP, n);
+	if (syms == NULL) {
+		return;
+	}
+
+	for (i = n - 1; i >= 0; i--) {
+		// "file(symbol+offset) [addr]", keep symbol else the address
+		name = strchr(syms[i], '(');
+		end = (name != NULL) ? strpbrk(name, "+)") : NULL;
+		if (name != NULL && end != NULL && end > name + 1) {
+			fprintf(fp, "%.*s", (int)(end - name - 1), name + 1);
+		} else {
+			fprintf(fp, "%p", s->pc[PROF_SKIP + i]);
+		}
+		fputc(i ? ';' : ' ', fp);
+	}
+	fprintf(fp, "%lu\n", count);
+
+	free(syms);
+}
+
+/*! @brief  
+ *  Stop sampling and write samples as folded stacks, one line per
+ *  distinct stack with its sample count
+ *  @return     - NA
+ * */
+void profiler_stop(void)
+{
+	size_t i, j, taken, ticks;
+	FILE *fp;
+
+	if (!prof.running) {
+		return;
+	}
+	timer_delete(prof.timer);
+	sigaction(SIGPROF, &prof.old, NULL);
+	prof.running = false;
+
+	ticks = __atomic_load_n(&prof.count, __ATOMIC_RELAXED);
+	taken = (ticks < PROF_MAX_SAMPLES) ? ticks : PROF_MAX_SAMPLES;
+	qsort(prof.samples, taken, sizeof(t_prof_sample), prof_cmpr);
+
+	fp = fopen(prof.path, "w");
+	if (fp == NULL) {
+		perror("profiler: fopen");
+		return;
+	}
+	for (i = 0; i < taken; i = j) {
+		for (j = i + 1; j < taken && prof_cmpr(&prof.samples[i], &prof.samples[j]) == 0; j++);
+		prof_write_stack(fp, &prof.samples[i], j - i);
+	}
+	fclose(fp);
+
+	if (ticks > taken) {
+		LOG_WARN("PROFILER", "%lu samples dropped, buffer full\n", ticks - taken);
+	}
+}
@@ -0,0 +1,378 @@
+/*! @file slab_allocator.c
+    @brief 
+    Contains definitions of the size class slab allocator
+    Small blocks are carved out of page sized slabs and recycled through
+    per size class free lists. Since slabs are page aligned, the slab header
+    of any block is found by masking the block address, so free needs no size
+    Each thread keeps a cache of free blocks per class that is served
+    without locking, caches exchange whole batches (magazines) of blocks
+    with a shared depot so that a lock is taken once per batch
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+#include "slab_allocator.h"
+
+/// Block sizes served from slabs
+static const size_t slab_class_size[] = {
+	16, 32, 48, 64, 80, 96, 112, 128, 160, 192, 256, 320, 512
+};
+
+#define SLAB_CLASSES	(sizeof(slab_class_size) / sizeof(slab_class_size[0]))
+
+/// Size class of a request, indexed by size rounded up to SLAB_ALIGN / SLAB_ALIGN
+static const uint8_t slab_class_of[SLAB_MAX_BLOCK / SLAB_ALIGN + 1] = {
+	0, 0, 1, 2, 3, 4, 5, 6, 7,		// 0 - 128
+	8, 8, 9, 9,				// 144 - 192
+	10, 10, 10, 10,				// 208 - 256
+	11, 11, 11, 11,				// 272 - 320
+	12, 12, 12, 12, 12, 12, 12, 12,		// 336 - 448
+	12, 12, 12, 12,				// 464 - 512
+};
+
+/// Free block, free list is threaded through the blocks themselves
+typedef struct slab_block {
+	struct slab_block *nxt;		///< Next free block in batch
+	struct slab_block *batch;	///< Next full batch (only in depot batch heads)
+} t_slab_block;
+
+/// Per thread cache of free blocks, used without any lock
+typedef struct slab_cache {
+	bool registered;				///< thread exit hook installed
+	t_slab_block *loaded[SLAB_CLASSES];		///< blocks served first
+	size_t count[SLAB_CLASSES];			///< blocks in loaded list
+	t_slab_block *prev[SLAB_CLASSES];		///< full batch held back (or NULL)
+} t_slab_cache;
+
+/// Slab allocator state shared by all threads
+typedef struct slab_manager {
+	pthread_mutex_t lock;				///< guards depot, slab list and stats
+	pthread_once_t once;				///< one time init of slab list and key
+	pthread_key_t key;				///< flushes thread cache on thread exit
+	t_slab_block *depot[SLAB_CLASSES];		///< full batches given back by threads
+	t_slab_block *loose[SLAB_CLASSES];		///< blocks of new slabs and partial batches
+	size_t pages[SLAB_CLASSES];			///< slabs carved for each class
+	size_t large_count;				///< large blocks live
+	t_slab head;					///< Sentinel of list of all slabs
+} t_slab_manager;
+
+static t_slab_manager slabber = {
+	.lock = PTHREAD_MUTEX_INITIALIZER,
+	.once = PTHREAD_ONCE_INIT,
+};
+
+static __thread t_slab_cache slab_cache;
+
+static void slab_cache_release(void *arg);
+
+/*! @brief  
+ *   Init list of slabs and the thread exit hook, run once
+ *   from the slow paths (cache refill and large allocs)
+ *  @return 	- NA
+ * */
+static void slab_init(void)
+{
+	slabber.head.nxt = slabber.head.prv = &slabber.head;
+	pthread_key_create(&slabber.key, slab_cache_release);
+}
+
+/*! @brief  
+ *   Get a page aligned chunk from the os and link it as a slab
+ *   called with slabber lock held
+ *  @param len  - length of the chunk
+ *  @return 	- slab header
+ * */
+static t_slab *slab_new(size_t len)
+{
+	t_slab *slab = NULL;
+
+	if (posix_memalign((void**)&slab, SLAB_PAGE_SIZE, len) != 0) {
+		return NULL;
+	}
+	slab->magic = SLAB_MAGIC;
+	slab->prv = &slabber.head;
+	slab->nxt = slabber.head.nxt;
+	slabber.head.nxt->prv = slab;
+	slabber.head.nxt = slab;
+
+	return slab;
+}
+
+/*! @brief  
+ *   Carve a new slab for a class and add its blocks to the loose list
+ *   called with slabber lock held
+ *  @param cls  - size class
+ *  @return 	- true on success
+ * */
+static bool slab_refill(size_t cls)
+{
+	t_slab *slab = slab_new(SLAB_PAGE_SIZE);
+	t_slab_block *blk;
+	char *cur, *end;
+
+	if (slab == NULL) {
+		return false;
+	}
+	slab->class_id = cls;
+	slab->block_size = slab_class_size[cls];
+
+	// thread all blocks of the page onto the free list
+	cur = (char*)slab + SLAB_HDR_SIZE;
+	end = (char*)slab + SLAB_PAGE_SIZE - slab->block_size;
+	for (; cur <= end; cur += slab->block_size) {
+		blk = (t_slab_block*)cur;
+		blk->nxt = slabber.loose[cls];
+		slabber.loose[cls] = blk;
+	}
+	slabber.pages[cls]++;
+
+	return true;
+}
+
+/*! @brief  
+ *   Reload the empty cache of a class, from the held back batch if
+ *   there is one else from the depot, a new slab is carved when
+ *   the depot runs dry
+ *  @param cls  - size class
+ *  @return 	- true on success
+ * */
+static bool slab_cache_refill(size_t cls)
+{
+	t_slab_block *blk;
+	size_t n;
+
+	if (slab_cache.prev[cls] != NULL) {
+		slab_cache.loaded[cls] = slab_cache.prev[cls];
+		slab_cache.count[cls] = SLAB_CACHE_BATCH;
+		slab_cache.prev[cls] = NULL;
+		return true;
+	}
+
+	// register thread so that its cache is flushed on exit
+	pthread_once(&slabber.once, slab_init);
+	if (slab_cache.registered == false) {
+		pthread_setspecific(slabber.key, &slab_cache);
+		slab_cache.registered = true;
+	}
+
+	pthread_mutex_lock(&slabber.lock);
+	// full batch is taken in one go
+	if (slabber.depot[cls] != NULL) {
+		blk = slabber.depot[cls];
+		slabber.depot[cls] = blk->batch;
+		slab_cache.loaded[cls] = blk;
+		slab_cache.count[cls] = SLAB_CACHE_BATCH;
+		pthread_mutex_unlock(&slabber.lock);
+		return true;
+	}
+
+	if (slabber.loose[cls] == NULL && slab_refill(cls) != true) {
+		pthread_mutex_unlock(&slabber.lock);
+		return false;
+	}
+	for (n = 0; n < SLAB_CACHE_BATCH && slabber.loose[cls] != NULL; n++) {
+		blk = slabber.loose[cls];
+		slabber.loose[cls] = blk->nxt;
+		blk->nxt = slab_cache.loaded[cls];
+		slab_cache.loaded[cls] = blk;
+	}
+	slab_cache.count[cls] = n;
+	pthread_mutex_unlock(&slabber.lock);
+
+	return true;
+}
+
+/*! @brief  
+ *   Give a full batch of a class back to the depot
+ *  @param cls   - size class
+ *  @param blk   - head of batch
+ *  @return 	 - NA
+ * */
+static void slab_depot_put(size_t cls, t_slab_block *blk)
+{
+	pthread_mutex_lock(&slabber.lock);
+	blk->batch = slabber.depot[cls];
+	slabber.depot[cls] = blk;
+	pthread_mutex_unlock(&slabber.lock);
+}
+
+/*! @brief  
+ *   Thread exit hook, hands all cached blocks back to the depot
+ *  @param arg  - Pointer to thread cache of exiting thread
+ *  @return 	- NA
+ * */
+static void slab_cache_release(void *arg)
+{
+	t_slab_cache *cache = arg;
+	t_slab_block *blk;
+	size_t cls;
+
+	for (cls = 0; cls < SLAB_CLASSES; cls++) {
+		if (cache->prev[cls] != NULL) {
+			slab_depot_put(cls, cache->prev[cls]);
+		}
+		// partial batch goes block by block to the loose list
+		pthread_mutex_lock(&slabber.lock);
+		while ((blk = cache->loaded[cls]) != NULL) {
+			cache->loaded[cls] = blk->nxt;
+			blk->nxt = slabber.loose[cls];
+			slabber.loose[cls] = blk;
+		}
+		pthread_mutex_unlock(&slabber.lock);
+		cache->prev[cls] = NULL;
+		cache->count[cls] = 0;
+	}
+	cache->registered = false;
+}
+
+/*! @brief  
+ *   Allocate zeroed memory (calloc semantics)
+ *  @param nmemb - number of members
+ *  @param size  - size of each member
+ *  @return 	 - memory address, NULL if nmemb * size overflows
+ * */
+void *slab_alloc(size_t nmemb, size_t size)
+{
+	size_t len, cls;
+	t_slab_block *blk;
+	t_slab *slab;
+
+	// A wrapped len may fit a size class, fail before picking the path
+	if (size && nmemb > SIZE_MAX / size) {
+		return NULL;
+	}
+	len = nmemb * size;
+
+	// Big blocks get their own page aligned chunk with the header in front
+	if (len > SLAB_MAX_BLOCK) {
+		if (len > SIZE_MAX - SLAB_HDR_SIZE) {
+			return NULL;
+		}
+		pthread_once(&slabber.once, slab_init);
+		pthread_mutex_lock(&slabber.lock);
+		slab = slab_new(SLAB_HDR_SIZE + len);
+		if (slab == NULL) {
+			pthread_mutex_unlock(&slabber.lock);
+			return NULL;
+		}
+		slab->class_id = SLAB_LARGE;
+		slab->block_size = len;
+		slabber.large_count++;
+		pthread_mutex_unlock(&slabber.lock);
+		memset((char*)slab + SLAB_HDR_SIZE, 0, len);
+		return (char*)slab + SLAB_HDR_SIZE;
+	}
+
+	// Pop a block from the thread cache of the size class
+	cls = slab_class_of[(len + SLAB_ALIGN - 1) / SLAB_ALIGN];
+	if (slab_cache.loaded[cls] == NULL && slab_cache_refill(cls) != true) {
+		return NULL;
+	}
+	blk = slab_cache.loaded[cls];
+	slab_cache.loaded[cls] = blk->nxt;
+	slab_cache.count[cls]--;
+	memset(blk, 0, slab_class_size[cls]);
+
+	return blk;
+}
+
+/*! @brief  
+ *   Free memory got from slab_alloc
+ *  @param mem_addr - memory address
+ *  @return 	    - NA
+ * */
+void slab_free(void *mem_addr)
+{
+	t_slab *slab;
+	t_slab_block *blk = mem_addr;
+	size_t cls;
+
+	if (mem_addr == NULL) {
+		return;
+	}
+
+	// slab header sits at the start of the page
+	slab = (t_slab*)((uintptr_t)mem_addr & ~((uintptr_t)SLAB_PAGE_SIZE - 1));
+	if (slab->magic != SLAB_MAGIC) {
+		printf("slab_free: %p not allocated from slab\n", mem_addr);
+		return;
+	}
+
+	// Large blocks are returned to the os
+	if (slab->class_id == SLAB_LARGE) {
+		pthread_mutex_lock(&slabber.lock);
+		slab->prv->nxt = slab->nxt;
+		slab->nxt->prv = slab->prv;
+		slab->magic = 0;
+		slabber.large_count--;
+		pthread_mutex_unlock(&slabber.lock);
+		free(slab);
+		return;
+	}
+
+	// Block goes to the cache of the freeing thread, once the loaded
+	// batch is full it is held back and the older held batch goes to depot
+	cls = slab->class_id;
+	if (slab_cache.count[cls] == SLAB_CACHE_BATCH) {
+		if (slab_cache.prev[cls] != NULL) {
+			slab_depot_put(cls, slab_cache.prev[cls]);
+		}
+		slab_cache.prev[cls] = slab_cache.loaded[cls];
+		slab_cache.loaded[cls] = NULL;
+		slab_cache.count[cls] = 0;
+	}
+	blk->nxt = slab_cache.loaded[cls];
+	slab_cache.loaded[cls] = blk;
+	slab_cache.count[cls]++;
+}
+
+/*! @brief  
+ *   Print the slabs held by each size class
+ *  @return 	    - NA
+ * */
+void slab_report(void)
+{
+	size_t i;
+
+	pthread_mutex_lock(&slabber.lock);
+	printf("slab pages:");
+	for (i = 0; i < SLAB_CLASSES; i++) {
+		printf(" %luB:%lu", slab_class_size[i], slabber.pages[i]);
+	}
+	printf(" large:%lu\n", slabber.large_count);
+	pthread_mutex_unlock(&slabber.lock);
+}
+
+/*! @brief  
+ *   Release all slabs back to os
+ *   Any block still held becomes invalid, other threads
+ *   must not use the allocator once this is called
+ *  @return 	    - NA
+ * */
+void slab_finit(void)
+{
+	t_slab *slab, *nxt;
+
+	pthread_mutex_lock(&slabber.lock);
+	if (slabber.head.nxt == NULL) {
+		pthread_mutex_unlock(&slabber.lock);
+		return;
+	}
+
+	for (slab = slabber.head.nxt; slab != &slabber.head; slab = nxt) {
+		nxt = slab->nxt;
+		slab->magic = 0;
+		free(slab);
+	}
+	slabber.head.nxt = slabber.head.prv = &slabber.head;
+	memset(slabber.depot, 0, sizeof(slabber.depot));
+	memset(slabber.loose, 0, sizeof(slabber.loose));
+	memset(slabber.pages, 0, sizeof(slabber.pages));
+	slabber.large_count = 0;
+	memset(slab_cache.loaded, 0, sizeof(slab_cache.loaded));
+	memset(slab_cache.prev, 0, sizeof(slab_cache.prev));
+	memset(slab_cache.count, 0, sizeof(slab_cache.count));
+	pthread_mutex_unlock(&slabber.lock);
+}
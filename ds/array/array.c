@@ -165,3 +165,79 @@ void quick_sort(t_gen a, int n, t_dparams *op)
 }
 
 
+
+/*! @brief  
+ *  Util function to be used by nth element, median of lo, mid and hi
+ *  is taken as pivot and moved to lo, elems equal to the pivot stop
+ *  both scans so runs of equal keys split evenly
+ *  @param a  - Pointer to array
+ *  @param lo - idx to partition start
+ *  @param hi - idx to partition end
+ *  @param op - Data type specific params 
+		for operation such as compare and swap
+ *  @return   - index of pivot
+ * */
+static int nth_element_partition(t_gen a, int lo, int hi, t_dparams *op)
+{
+	int mid = lo + (hi - lo) / 2;
+	int left = lo, right = hi + 1;
+
+	// order lo, mid, hi then median to lo
+	if (op->cmpr_idx(a, mid, lo) == eLESS) {
+		op->swap_idx(a, mid, lo);
+	}
+	if (op->cmpr_idx(a, hi, lo) == eLESS) {
+		op->swap_idx(a, hi, lo);
+	}
+	if (op->cmpr_idx(a, hi, mid) == eLESS) {
+		op->swap_idx(a, hi, mid);
+	}
+	op->swap_idx(a, lo, mid);
+
+	// scan in from both ends, swap elems on the wrong side of pivot
+	while (true) {
+		while (++left < hi && op->cmpr_idx(a, left, lo) == eLESS);
+		while (op->cmpr_idx(a, lo, --right) == eLESS);
+		if (left >= right) {
+			break;
+		}
+		op->swap_idx(a, left, right);
+	}
+	op->swap_idx(a, lo, right);
+
+	return right;
+}
+
+/*! @brief  
+ *  Quickselect, rearranges the array so that the elem at k is the one
+ *  that would be there if sorted, elems before it are not greater and
+ *  elems after it are not less. Only the partition holding k is
+ *  scanned each round, average O(n) and worst case O(n2)
+ *  @param a  - Pointer to array
+ *  @param n  - size of array
+ *  @param k  - idx of elem to place, 0 to n-1
+ *  @param op - Data type specific params 
+		for operation such as compare and swap
+ *  @return   - NA
+ * */
+void nth_element(t_gen a, int n, int k, t_dparams *op)
+{
+	int lo = 0, hi = n - 1, pivot;
+
+	if (k < 0 || k >= n) {
+		LOG_WARN("ARRAY", "nth element %d out of bounds %d\n", k, n);
+		return;
+	}
+
+	while (lo < hi) {
+		pivot = nth_element_partition(a, lo, hi, op);
+		if (pivot == k) {
+			break;
+		}
+		if (k < pivot) {
+			hi = pivot - 1;
+		} else {
+			lo = pivot + 1;
+		}
+	}
+}
@@ -9,3 +9,52 @@ void selection_sort(t_gen a, int n, t_dparams *op);
 void insertion_sort(t_gen a, int n, t_dparams *op);
 void quick_sort(t_gen a, int n, t_dparams *op);
 void merge_sort(t_gen a, int n, t_dparams *op);
+void nth_element(t_gen a, int n, int k, t_dparams *op);
+
+/// Quick sort of a T array specialised at compile time, same partition scheme
+/// as quick_sort with CMP(x, y) (<0, 0 or >0) expanded in place of cmpr_idx
+#define DEFINE_SORT(T, NAME, CMP)							\
+static inline int NAME##_partition(T *a, int lo, int hi)				\
+{											\
+	T pivot = a[hi];								\
+	T tmp;										\
+	int green, yellow = lo - 1;							\
+											\
+	for (green = lo; green <= (hi - 1); green++) {					\
+		if (CMP(a[green], pivot) < 0) {						\
+			yellow++;							\
+			tmp = a[yellow]; a[yellow] = a[green]; a[green] = tmp;		\
+		}									\
+	}										\
+	yellow++;									\
+	tmp = a[yellow]; a[yellow] = a[hi]; a[hi] = tmp;				\
+											\
+	return yellow;									\
+}											\
+											\
+static inline void NAME(T *a, int n)							\
+{											\
+	int top = -1, *stack, lo, hi, pivot;						\
+											\
+	if (n < 2) {									\
+		return;									\
+	}										\
+	/* auxiliary stack of partitions still to be sorted */			\
+	stack = (int*)get_mem(n, sizeof(int));						\
+	stack[++top] = 0;								\
+	stack[++top] = n - 1;								\
+	while (top >= 0) {								\
+		hi = stack[top--];							\
+		lo = stack[top--];							\
+		pivot = NAME##_partition(a, lo, hi);					\
+		if ((pivot - 1) > lo) {							\
+			stack[++top] = lo;						\
+			stack[++top] = pivot - 1;					\
+		}									\
+		if ((pivot + 1) < hi) {							\
+			stack[++top] = pivot + 1;					\
+			stack[++top] = hi;						\
+		}									\
+	}										\
+	free_mem(stack);								\
+}
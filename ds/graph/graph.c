@@ -32,6 +32,27 @@ void graph_print(t_gen d);
 void graph_wprint(t_gen d);
 void graph_destroy(t_gen d);
 
+/// Routines shared by all graphs
+static const t_graph_ops graph_ops = {
+	.add_vertex	  = graph_add_vertex, 
+	.del_vertex	  = graph_del_vertex,
+	.add_edge	  = graph_add_edge, 
+	.del_edge	  = graph_del_edge,
+	.has_edge	  = graph_has_edge,
+	.add_edge_sym   = graph_add_edge_sym, 
+	.del_edge_sym   = graph_del_edge_sym,
+	.add_wedge      = graph_add_wedge, 
+	.add_wedge_sym  = graph_add_wedge_sym, 
+	.bfs	          = graph_bfs,
+	.dfs	          = graph_dfs,
+	.topo_order_dag = graph_toplogicaly_order_dag,
+	.find 	  = graph_find,
+	.len	 	  = graph_len,
+	.print 	  = graph_print,
+	.wprint 	  = graph_wprint,
+	.destroy 	  = graph_destroy,
+};
+
 /*! @brief  
  *  Create an instance of graph
  *  @param name	 - Name of graph instance
@@ -41,33 +62,38 @@ void graph_destroy(t_gen d);
  * */
 t_gen create_graph(char *name, int size, t_dparams *prm)
 {
-	t_graph *g = get_mem(1, sizeof(t_graph));
+	return create_graph_in_arena(name, size, prm, NULL);
+}
+
+/*! @brief  
+ *  Create an instance of graph with its vertices, edges and
+ *  neigh lists allocated from the given arena, the graph owns
+ *  the arena and destroying the graph releases it in one go
+ *  @param name	 - Name of graph instance
+ *  @param size  - Max vertices in graph
+ *  @param prm   - Data type specific parameters
+ *  @param arena - Arena to allocate from (NULL for tagged mem)
+ *  @return 	 - Pointer to instance of graph
+ * */
+t_gen create_graph_in_arena(char *name, int size, t_dparams *prm, t_arena *arena)
+{
+	t_graph *g = arena_get_mem(arena, 1, sizeof(t_graph));
+	t_dparams dp;
 
 	// Initailze graph Params
 	g->name 	  = name;
 	g->count 	  = 0;
 	g->total_edges    = 0;
 	g->max_size       = size;
-	g->nodes          = get_mem(size, sizeof(t_gnode));
+	g->arena          = arena;
+	g->nodes          = arena_get_mem(arena, size, sizeof(t_gnode));
+	g->index          = NULL;
+	g->edges          = NULL;
+	g->heap_type      = eMIN_HEAP;
+	g->has_negative   = false;
 	
 	// Initailze graph routines
-	g->add_vertex	  = graph_add_vertex; 
-	g->del_vertex	  = graph_del_vertex;
-	g->add_edge	  = graph_add_edge; 
-	g->del_edge	  = graph_del_edge;
-	g->has_edge	  = graph_has_edge;
-	g->add_edge_sym   = graph_add_edge_sym; 
-	g->del_edge_sym   = graph_del_edge_sym;
-	g->add_wedge      = graph_add_wedge; 
-	g->add_wedge_sym  = graph_add_wedge_sym; 
-	g->bfs	          = graph_bfs;
-	g->dfs	          = graph_dfs;
-	g->topo_order_dag = graph_toplogicaly_order_dag;
-	g->find 	  = graph_find;
-	g->len	 	  = graph_len;
-	g->print 	  = graph_print;
-	g->wprint 	  = graph_wprint;
-	g->destroy 	  = graph_destroy;
+	g->ops		  = &graph_ops;
 
 	// Initailze data type based operations req for prop working of graph
 	g->cmpr 	  = prm->cmpr;
@@ -75,6 +101,14 @@ t_gen create_graph(char *name, int size, t_dparams *prm)
 	g->free 	  = prm->free;
 	g->print_data 	  = prm->print_data;
 
+	// Index vertex ids when the data type can be hashed, the ids are owned by the graph
+	if (prm->hash != NULL) {
+		dp = *prm;
+		dp.elem_size = 0;
+		dp.free = dummy_free;
+		g->index = create_hash_map("vertex index", size, &dp);
+	}
+
 	return (t_gen)g;
 }
 
@@ -98,8 +132,15 @@ int graph_len(t_gen g)
 t_gen graph_find(t_gen d, t_gen data)
 {
 	t_graph *g = (t_graph*)d;
+	t_gen *idx;
 	int i;
 
+	// O(1) lookup through the vertex index
+	if (g->index != NULL) {
+		idx = g->index->find(g->index, data);
+		return (idx != NULL)? &g->nodes[(long)*idx] : NULL;
+	}
+
 	for (i = 0; i < g->count; i++) {
 		if (g->cmpr(g->nodes[i].id, data) == eEQUAL) {
 			return &g->nodes[i];
@@ -109,6 +150,113 @@ t_gen graph_find(t_gen d, t_gen data)
 	return NULL;
 }
 
+/*! @brief  
+ *  Util compare function for keys of the edge set
+ *  @param x	- Pointer to key
+ *  @param y   	- Pointer to key to be compared
+ *  @return 	- Equal, Less or Great
+ */
+static e_cmpr graph_edge_key_cmpr(t_gen x, t_gen y)
+{
+	uint64_t a = *(uint64_t*)x, b = *(uint64_t*)y;
+
+	return (a == b)? eEQUAL : ((a < b)? eLESS : eGREAT);
+}
+
+/*! @brief  
+ *  Util hash function for keys of the edge set
+ *  @param x	- Pointer to key
+ *  @return 	- hash of key
+ */
+static uint64_t graph_edge_key_hash(t_gen x)
+{
+	return hash_mix(*(uint64_t*)x);
+}
+
+/*! @brief  
+ *  Add an edge to the edge set of graph if enabled
+ *  @param g	- Pointer instance of graph
+ *  @param src	- Index of source vertex
+ *  @param dst	- Index of destination vertex
+ *  @param edge	- Pointer to edge
+ *  @return 	- NA
+ */
+static void graph_edge_set_add(t_graph *g, int src, int dst, t_gedge *edge)
+{
+	uint64_t key = ((uint64_t)src << 32) | (uint32_t)dst;
+
+	if (g->edges != NULL) {
+		g->edges->insert(g->edges, &key, edge);
+	}
+}
+
+/*! @brief  
+ *  Del an edge from the edge set of graph if enabled
+ *  @param g	- Pointer instance of graph
+ *  @param src	- Index of source vertex
+ *  @param dst	- Index of destination vertex
+ *  @return 	- Pointer to edge removed else null
+ */
+static t_gen graph_edge_set_del(t_graph *g, int src, int dst)
+{
+	uint64_t key = ((uint64_t)src << 32) | (uint32_t)dst;
+
+	// most probes miss (del_vertex), find first as del logs a missing key
+	if (g->edges == NULL || g->edges->find(g->edges, &key) == NULL) {
+		return NULL;
+	}
+
+	return g->edges->del(g->edges, &key);
+}
+
+/*! @brief  
+ *  Enable or disable the edge set of a graph, with it has_edge and the
+ *  duplicate check on adding edges are O(1) instead of O(degree)
+ *  @param d	  - Pointer instance of graph
+ *  @param enable - true to index the edges, false to drop the index
+ *  @return 	  - NA
+ */
+void graph_index_edges(t_gen d, bool enable)
+{
+	t_graph *g = (t_graph*)d;
+	t_linklist *neigh_list;
+	t_llnode *cur, *end;
+	t_dparams dp;
+	int i;
+
+	if (enable == false) {
+		if (g->edges != NULL) {
+			g->edges->destroy(g->edges);
+			g->edges = NULL;
+		}
+		return;
+	}
+
+	if (g->edges != NULL) {
+		return;
+	}
+
+	init_data_params(&dp, eUSER);
+	dp.elem_size = sizeof(uint64_t);
+	dp.cmpr = graph_edge_key_cmpr;
+	dp.hash = graph_edge_key_hash;
+	g->edges = create_hash_map("edge set", g->total_edges, &dp);
+
+	// Add edges already present in graph
+	for (i = 0; i < g->count; i++) {
+		neigh_list = g->nodes[i].neigh;
+		cur = neigh_list->ops->head_node(neigh_list);
+		end = neigh_list->ops->end_node(neigh_list);
+		while (cur) {
+			graph_edge_set_add(g, i, ((t_gedge*)cur->data)->node->idx, cur->data);
+			cur = neigh_list->ops->next_node(neigh_list, cur);
+			if (cur == end) {
+				break;
+			}
+		}
+	}
+}
+
 /*! @brief  
  *  Util compare function for neigh link list node data
  *  @param x	- Pointer linklist node 
@@ -157,7 +305,7 @@ t_gen graph_add_vertex(t_gen d, t_gen data)
 	t_dparams dp;
 	
 	// existing node return
-	node = g->find(g, data);
+	node = g->ops->find(g, data);
 	if (node != NULL) {
 		//LOG_WARN("GRAPH", "%s: node already present\n",g->name);
 		return node;
@@ -176,11 +324,15 @@ t_gen graph_add_vertex(t_gen d, t_gen data)
 
 	// create link list to store node neighbors
 	node->id = data;
+	if (g->index != NULL) {
+		g->index->insert(g->index, data, (t_gen)(long)node->idx);
+	}
+	// neigh lists share the graph arena, edges are released with it
 	init_data_params(&dp, eUSER);
-	dp.free = graph_neigh_list_free;
+	dp.free = g->arena ? dummy_free : graph_neigh_list_free;
 	dp.cmpr = graph_neigh_list_compare;
 //	node->neigh = create_link_list("neighNodes", eDOUBLE_LINKLIST, &dp);
-	node->neigh = create_link_list("neighNodes", eXOR_LINKLIST, &dp);
+	node->neigh = create_link_list_in_arena("neighNodes", eXOR_LINKLIST, &dp, g->arena);
 
 	return node;
 }
@@ -197,16 +349,24 @@ t_gen graph_has_edge(t_gen d, t_gen n1, t_gen n2)
 	t_graph *g = (t_graph*)d;
 	t_gnode *A, *B;
 
-	A = g->find(g, n1);
-	B = g->find(g, n2);
+	A = g->ops->find(g, n1);
+	B = g->ops->find(g, n2);
 	
 	// Nodes not present
 	if (A == NULL || B == NULL) {
 		return NULL;
 	}
+
+	// Edge set holds every edge of graph when enabled
+	if (g->edges != NULL) {
+		uint64_t key = ((uint64_t)A->idx << 32) | (uint32_t)B->idx;
+		t_gen *edge = g->edges->find(g->edges, &key);
+
+		return (edge != NULL)? *edge : NULL;
+	}
 	
 	// return if B present A's neigh list
-	return A->neigh->find(A->neigh, B);
+	return A->neigh->ops->find(A->neigh, B);
 }
 
 /*! @brief  
@@ -223,8 +383,8 @@ t_gen graph_add_edge(t_gen d, t_gen n1, t_gen n2)
 	t_gedge *edge;
 
 	// ADD Node if node doesn't exit else get node
-	A = g->add_vertex(g, n1);
-	B = g->add_vertex(g, n2);
+	A = g->ops->add_vertex(g, n1);
+	B = g->ops->add_vertex(g, n2);
 
 	// Return if Graph FULL
 	if (A == NULL || B == NULL) {
@@ -232,18 +392,19 @@ t_gen graph_add_edge(t_gen d, t_gen n1, t_gen n2)
 	}
 
 	// Return Link already exists
-	if (g->has_edge(g, n1, n2) != NULL) {
+	if (g->ops->has_edge(g, n1, n2) != NULL) {
 		return NULL;
 	}
 
 	g->total_edges++;
 
-	edge = get_mem(1, sizeof(t_gedge));
+	edge = arena_get_mem(g->arena, 1, sizeof(t_gedge));
 	edge->node  = B;
 	edge->weight = 0;
 
 	// link N1->N2
-	A->neigh->append(A->neigh, edge);
+	A->neigh->ops->append(A->neigh, edge);
+	graph_edge_set_add(g, A->idx, B->idx, edge);
 
 	return A;
 }
@@ -263,8 +424,8 @@ t_gen graph_add_wedge(t_gen d, t_gen n1, t_gen n2, int weight)
 	t_gedge *edge;
 
 	// ADD Node if node doesn't exit else get node
-	A = g->add_vertex(g, n1);
-	B = g->add_vertex(g, n2);
+	A = g->ops->add_vertex(g, n1);
+	B = g->ops->add_vertex(g, n2);
 
 	// Return if Graph FULL
 	if (A == NULL || B == NULL) {
@@ -272,18 +433,20 @@ t_gen graph_add_wedge(t_gen d, t_gen n1, t_gen n2, int weight)
 	}
 
 	// Return Link already exists
-	if (g->has_edge(g, n1, n2) != NULL) {
+	if (g->ops->has_edge(g, n1, n2) != NULL) {
 		return NULL;
 	}
 
 	g->total_edges++;
 
-	edge = get_mem(1, sizeof(t_gedge));
+	edge = arena_get_mem(g->arena, 1, sizeof(t_gedge));
 	edge->node  = B;
 	edge->weight = weight;
+	g->has_negative |= (weight < 0);
 
 	// link N1->N2
-	A->neigh->append(A->neigh, edge);
+	A->neigh->ops->append(A->neigh, edge);
+	graph_edge_set_add(g, A->idx, B->idx, edge);
 
 	return A;
 }
@@ -300,17 +463,22 @@ t_gen graph_del_edge(t_gen d, t_gen n1, t_gen n2)
 	t_graph *g = (t_graph*)d;
 	t_gnode *A, *B;
 
-	A = g->find(g, n1);
-	B = g->find(g, n2);
+	A = g->ops->find(g, n1);
+	B = g->ops->find(g, n2);
 	
 	// Nodes not present
 	if (A == NULL || B == NULL) {
 		return NULL;
 	}
 	
+	// Edge not present, skip the neigh list walk
+	if (g->edges != NULL && graph_edge_set_del(g, A->idx, B->idx) == NULL) {
+		return A;
+	}
+
 	// unlink N1->N2
-	d = A->neigh->del(A->neigh, B);
-	free_mem(d);
+	d = A->neigh->ops->del(A->neigh, B);
+	arena_free_mem(g->arena, d);
 	return A;
 }
 
@@ -327,9 +495,9 @@ t_gen graph_add_edge_sym(t_gen d, t_gen n1, t_gen n2)
 	t_gen ret;
 
 	// link N1->N2
-	ret = g->add_edge(g, n1, n2);
+	ret = g->ops->add_edge(g, n1, n2);
 	// link N2->N1
-	ret = g->add_edge(g, n2, n1);
+	ret = g->ops->add_edge(g, n2, n1);
 
 	return ret;
 }
@@ -348,9 +516,9 @@ t_gen graph_add_wedge_sym(t_gen d, t_gen n1, t_gen n2, int weight)
 	t_gen ret;
 
 	// link N1->N2
-	ret = g->add_wedge(g, n1, n2, weight);
+	ret = g->ops->add_wedge(g, n1, n2, weight);
 	// link N2->N1
-	ret = g->add_wedge(g, n2, n1, weight);
+	ret = g->ops->add_wedge(g, n2, n1, weight);
 
 	return ret;
 }
@@ -368,11 +536,80 @@ t_gen graph_del_edge_sym(t_gen d, t_gen n1, t_gen n2)
 	t_gen ret;
 
 	// unlink N1->N2
-	ret = g->del_edge(g, n1, n2);
+	ret = g->ops->del_edge(g, n1, n2);
 	
 	// unlink N2->N1
-	ret = g->del_edge(g, n2, n1);
+	ret = g->ops->del_edge(g, n2, n1);
+
+}
+
+/*! @brief  
+ *  Point edges of a vertex to a vertex that moved to another slot
+ *  @param g    - Pointer instance of graph
+ *  @param node - Pointer to vertex whose edges are updated
+ *  @param from - Pointer to old slot of vertex
+ *  @param to   - Pointer to new slot of vertex
+ *  @return 	- NA
+ */
+static void graph_neigh_retarget(t_graph *g, t_gnode *node, t_gnode *from, t_gnode *to)
+{
+	t_linklist *neigh_list = node->neigh;
+	t_llnode *cur, *end;
+	t_gedge *edge;
+
+	// No edge to the moved vertex, skip the neigh list walk
+	if (g->edges != NULL) {
+		edge = graph_edge_set_del(g, node->idx, from->idx);
+		if (edge == NULL) {
+			return;
+		}
+		graph_edge_set_add(g, node->idx, to->idx, edge);
+	}
+
+	cur = neigh_list->ops->head_node(neigh_list);
+	end = neigh_list->ops->end_node(neigh_list);
+	while (cur) {
+		edge = cur->data;
+		if (edge->node == from) {
+			edge->node = to;
+		}
+		cur = neigh_list->ops->next_node(neigh_list, cur);
+		if (cur == end) {
+			break;
+		}
+	}
+}
+
+/*! @brief  
+ *  Move the out edges of a vertex in the edge set to a new source index
+ *  @param g    - Pointer instance of graph
+ *  @param node - Pointer to vertex
+ *  @param src  - New source index, -1 to only drop the edges from the set
+ *  @return 	- NA
+ */
+static void graph_edge_set_move(t_graph *g, t_gnode *node, int src)
+{
+	t_linklist *neigh_list = node->neigh;
+	t_llnode *cur, *end;
+	t_gedge *edge;
+
+	if (g->edges == NULL) {
+		return;
+	}
 
+	cur = neigh_list->ops->head_node(neigh_list);
+	end = neigh_list->ops->end_node(neigh_list);
+	while (cur) {
+		edge = cur->data;
+		graph_edge_set_del(g, node->idx, edge->node->idx);
+		if (src != -1) {
+			graph_edge_set_add(g, src, edge->node->idx, edge);
+		}
+		cur = neigh_list->ops->next_node(neigh_list, cur);
+		if (cur == end) {
+			break;
+		}
+	}
 }
 
 /*! @brief  
@@ -385,17 +622,20 @@ t_gen graph_del_vertex(t_gen d, t_gen n1)
 {
 	t_graph *g = (t_graph*)d;
 	int i;
-	t_gnode *A, *node;
+	t_gnode *A, *node, *last;
 	t_gen tmp = NULL;
 
 	// Find node
-	A = g->find(g, n1);
+	A = g->ops->find(g, n1);
 
 	// return if node doesn't exist
 	if (A == NULL) {
 		return tmp;
 	}
 
+	// last node moves into the slot of the deleted node
+	last = &g->nodes[g->count - 1];
+	graph_edge_set_move(g, A, -1);
 
 	// travers all nodes in graph
 	// and delete itself from each node->neigh list
@@ -404,12 +644,25 @@ t_gen graph_del_vertex(t_gen d, t_gen n1)
 			continue;
 		}
 		node = &g->nodes[i];
-		tmp = node->neigh->del(node->neigh, A);
-		free_mem(tmp);
+		if (g->edges == NULL || graph_edge_set_del(g, i, A->idx) != NULL) {
+			tmp = node->neigh->ops->del(node->neigh, A);
+			arena_free_mem(g->arena, tmp);
+		}
+		if (last != A) {
+			graph_neigh_retarget(g, node, last, A);
+		}
+	}
+	if (last != A) {
+		graph_edge_set_move(g, last, A->idx);
+	}
+	// destroy neigh list, arena lists go with the graph arena
+	if (g->arena == NULL) {
+		A->neigh->ops->destroy(A->neigh);	
 	}
-	// destroy neigh list 
-	A->neigh->destroy(A->neigh);	
 	tmp = A->id;
+	if (g->index != NULL) {
+		g->index->del(g->index, tmp);
+	}
 	
 	g->count--;
 	
@@ -417,6 +670,9 @@ t_gen graph_del_vertex(t_gen d, t_gen n1)
 		// Swap node to be deleted with last node
 		A->id = g->nodes[g->count].id;
 		A->neigh = g->nodes[g->count].neigh;
+		if (g->index != NULL) {
+			g->index->insert(g->index, A->id, (t_gen)(long)A->idx);
+		}
 	}
 
 	return tmp;
@@ -450,8 +706,8 @@ void bfs_core(t_graph *g, t_gnode *node, t_bfsinfo *bfs, t_queue *q, int comp)
 		// For each vertex in queue
 		// Increment level and update parent for each new vertex
 		neigh_list = (t_linklist*)node->neigh;
-		cur = neigh_list->head_node(neigh_list);
-		end = neigh_list->end_node(neigh_list);
+		cur = neigh_list->ops->head_node(neigh_list);
+		end = neigh_list->ops->end_node(neigh_list);
 		while (cur) {
 			edge  = cur->data;
 			neigh = edge->node;
@@ -463,7 +719,7 @@ void bfs_core(t_graph *g, t_gnode *node, t_bfsinfo *bfs, t_queue *q, int comp)
 				q->enq(q, neigh);
 			}
 			// Get next node in neigh list
-			cur = neigh_list->next_node(neigh_list, cur);
+			cur = neigh_list->ops->next_node(neigh_list, cur);
 			if (cur == end) {
 				break;
 			}
@@ -493,7 +749,7 @@ t_gen graph_bfs(t_gen d, t_gen n)
 	bool all_nodes_visited = false;
 
 	// Find node
-	node = g->find(g, n);
+	node = g->ops->find(g, n);
 
 	// return if node doesn't exist
 	if (node == NULL) {
@@ -561,8 +817,8 @@ void dfs_core(t_graph *g, t_gnode *node, t_dfsinfo *dfs, t_stack *s, int comp, i
 	s->push(s, node);
 	do {
 		neigh_list = (t_linklist*)node->neigh;
-		cur = neigh_list->head_node(neigh_list);
-		end = neigh_list->end_node(neigh_list);
+		cur = neigh_list->ops->head_node(neigh_list);
+		end = neigh_list->ops->end_node(neigh_list);
 		// Depth Traversal of unvisited neighbor vertex
 		// Don't check Neighbor list if already all neighbors visited  
 		while (cur && dfs[node->idx].visited_neighbors != 0) {
@@ -582,7 +838,7 @@ void dfs_core(t_graph *g, t_gnode *node, t_dfsinfo *dfs, t_stack *s, int comp, i
 			// Else get next unvisited vertex in neigh list
 			else {	
 				// Get next unvisited node in neigh list
-				cur = neigh_list->next_node(neigh_list, cur);
+				cur = neigh_list->ops->next_node(neigh_list, cur);
 				
 				if (cur == end) {
 					// All neighbor of current node have been visited
@@ -630,7 +886,7 @@ t_gen graph_dfs(t_gen d, t_gen n)
 	bool all_nodes_visited = false;
 
 	// Find node
-	node = g->find(g, n);
+	node = g->ops->find(g, n);
 
 	// return if node doesn't exist
 	if (node == NULL) {
@@ -695,7 +951,7 @@ t_gen graph_dfs_optimised(t_gen d, t_gen n)
 	int count = 0;
 
 	// Find node
-	node = g->find(g, n);
+	node = g->ops->find(g, n);
 
 	// return if node doesn't exist
 	if (node == NULL) {
@@ -713,14 +969,14 @@ t_gen graph_dfs_optimised(t_gen d, t_gen n)
 		dfs[i].parent = NULL;
 		dfs[i].pre = dfs[i].post = -1;
 		neigh_list = (t_linklist*)(g->nodes[i].neigh);
-		dfs[i].visited_neighbors = neigh_list->len(neigh_list);
+		dfs[i].visited_neighbors = neigh_list->ops->len(neigh_list);
 	}
 	
 	dfs[node->idx].pre = count++;
 	s->push(s, node);
 	do {	
 		neigh_list = (t_linklist*)node->neigh;
-		cur = neigh_list->head_node(neigh_list);
+		cur = neigh_list->ops->head_node(neigh_list);
 
 		// Depth Traversal of unvisited neighbor vertex
 		// Don't check Neighbor list if already visited all the neighbors
@@ -742,14 +998,14 @@ t_gen graph_dfs_optimised(t_gen d, t_gen n)
 				// By pushing the unvisited node to last
 				// And eliminating it being revisited
 				// By traversing  the list only 'visited_neighbors' times
-				edge = neigh_list->del_idx(neigh_list, 0);
-				neigh_list->append(neigh_list, edge);
+				edge = neigh_list->ops->del_idx(neigh_list, 0);
+				neigh_list->ops->append(neigh_list, edge);
 				break;
 			}  
 			// Else get next unvisited vertex in neigh list
 			else {	
 				// Get next unvisited node in neigh list
-				cur = neigh_list->next_node(neigh_list, cur);
+				cur = neigh_list->ops->next_node(neigh_list, cur);
 				
 				if (cur == end) {
 					// All neighbor of current node have been visited
@@ -812,13 +1068,13 @@ t_gen graph_toplogicaly_order_dag(t_gen d)
 	// Update indegree for all nodes
 	for (int i = 0; i < g->count; i++) {
 		neigh_list = g->nodes[i].neigh;
-		cur = neigh_list->head_node(neigh_list);
-		end = neigh_list->end_node(neigh_list);
+		cur = neigh_list->ops->head_node(neigh_list);
+		end = neigh_list->ops->end_node(neigh_list);
 		while (cur) {
 			edge = cur->data;
 			node = edge->node;
 			dag_inf[node->idx].indegree += 1;
-			cur = neigh_list->next_node(neigh_list, cur);
+			cur = neigh_list->ops->next_node(neigh_list, cur);
 			if (cur == end) {
 				break;
 			}
@@ -843,8 +1099,8 @@ t_gen graph_toplogicaly_order_dag(t_gen d)
 		// update longest path and indegree of neighbors
 		// for the enumerated vertex
 		neigh_list = node->neigh;
-		cur = neigh_list->head_node(neigh_list);
-		end = neigh_list->end_node(neigh_list);
+		cur = neigh_list->ops->head_node(neigh_list);
+		end = neigh_list->ops->end_node(neigh_list);
 		while (cur) {
 			edge  = cur->data;
 			neigh = edge->node;
@@ -859,7 +1115,7 @@ t_gen graph_toplogicaly_order_dag(t_gen d)
 				q->enq(q, neigh);
 			}	
 			// Get next neigh
-			cur = neigh_list->next_node(neigh_list, cur);
+			cur = neigh_list->ops->next_node(neigh_list, cur);
 			if (cur == end) {
 				break;
 			}
@@ -886,13 +1142,13 @@ void graph_neigh_print(t_gen d, t_gen neigh)
 	t_llnode *cur, *end;
 
 	printf("{ ");
-	cur = l->head_node(l);
+	cur = l->ops->head_node(l);
 	while (cur) {
 		edge  = cur->data;
 		node  = edge->node;
 		g->print_data(node->id);
 		printf(" ");
-		cur = l->next_node(l, cur);
+		cur = l->ops->next_node(l, cur);
 		if (cur == end) {
 			break;
 		}
@@ -935,14 +1191,14 @@ void graph_wneigh_print(t_gen d, t_gen neigh)
 	t_llnode *cur, *end;
 
 	printf("{ ");
-	cur = l->head_node(l);
+	cur = l->ops->head_node(l);
 	while (cur) {
 		edge  = cur->data;
 		node  = edge->node;
 		printf("<");
 		g->print_data(node->id);
 		printf(" %d> ", edge->weight);
-		cur = l->next_node(l, cur);
+		cur = l->ops->next_node(l, cur);
 		if (cur == end) {
 			break;
 		}
@@ -1034,13 +1290,14 @@ SWP_IDX(t_distinfo, graph_wedge_swap_idx)
 /*! @brief  
  *  Find the shortest path from a given source vertex
  *  to all source nodes in a graph using Dijkstra's algo
+ *  with a binary heap of edges
  *  @see https://en.wikipedia.org/wiki/Dijkstra%27s_algorithm
  *  Note: Dijktra's works for graph with no negative edges
  *  @param d	 - Pointer instance of graph
  *  @param data  - Pointer to source vertex data
  *  @return 	 - Pointer to dist array to all nodes in graph
  */
-t_gen dijkstra(t_gen d, t_gen data)
+t_gen dijkstra_heap(t_gen d, t_gen data)
 {
 	t_graph *g = (t_graph*)d;
 	t_gnode *node;
@@ -1054,7 +1311,7 @@ t_gen dijkstra(t_gen d, t_gen data)
 	int alt_weight;
 
 	// Get vertex
-	node = g->find(g, data);
+	node = g->ops->find(g, data);
 	if (node == NULL) {
 		return NULL;
 	}	
@@ -1068,9 +1325,10 @@ t_gen dijkstra(t_gen d, t_gen data)
 	dp.copy_idx = gen_cpy_idx;
 	dp.get_idx  = gen_get_idx;
 
-	// Creating a generic min heap to store edges
+	// Creating a generic min heap to store edges, indexed by vertex
+	// so each vertex is in the heap at most once
 	pq   = get_mem(g->count, sizeof(t_gen)); 	
-	h    = create_heap("Dijkstra's Heap", pq, g->count, eMIN_HEAP, &dp);
+	h    = create_indexed_heap("Dijkstra's Heap", pq, g->count, g->heap_type, &dp);
 	
 	// Initalize all dist to all nodes as infinite 
 	dist = get_mem(g->count, sizeof(t_distinfo)); 	
@@ -1084,16 +1342,16 @@ t_gen dijkstra(t_gen d, t_gen data)
 	dist[node->idx].edge.weight = 0; 
 	
 	// Add source vertex to heap 
-	h->insert(h, &dist[node->idx].edge);
+	h->insert_handle(h, node->idx, &dist[node->idx].edge);
 	while (h->empty(h) != true) {
 		// Get min dist vertex from heap and traverse all its edges
 		// check if dist from cur vertex to its neigh vertex is smaller
-		// Using heaps cos extract min is O(1)
+		// Using heaps cos extract min is O(log n)
 		u = h->extract(h);
 
 		neigh_list = (t_linklist*)u->node->neigh;
-		cur = neigh_list->head_node(neigh_list);
-		end = neigh_list->end_node(neigh_list);
+		cur = neigh_list->ops->head_node(neigh_list);
+		end = neigh_list->ops->end_node(neigh_list);
 		while (cur) {
 			v = (t_gedge*)cur->data;
 
@@ -1101,14 +1359,18 @@ t_gen dijkstra(t_gen d, t_gen data)
 			alt_weight = u->weight + v->weight;
 			if (dist[v->node->idx].edge.weight > alt_weight) {
 				// Set cur dist as alt dist, update parent
-				// and add edge to heap
+				// and add edge to heap or move it up if present
 				dist[v->node->idx].edge.weight = alt_weight;
 				dist[v->node->idx].parent = u->node;
-				h->insert(h, &dist[v->node->idx].edge);
+				if (h->pos[v->node->idx] == -1) {
+					h->insert_handle(h, v->node->idx, &dist[v->node->idx].edge);
+				} else {
+					h->decrease_key(h, v->node->idx, &dist[v->node->idx].edge);
+				}
 			}
 			
 			// Exit after neigh list traversal complete
-			cur = neigh_list->next_node(neigh_list, cur);
+			cur = neigh_list->ops->next_node(neigh_list, cur);
 			if (cur == end) {
 				break;
 			}
@@ -1122,6 +1384,100 @@ t_gen dijkstra(t_gen d, t_gen data)
 	return dist;
 }
 
+/*! @brief  
+ *  Dijkstra's algo with a radix heap of vertex dists, needs all edge
+ *  weights to be non negative so extracted dists never decrease
+ *  @param g	 - Pointer instance of graph
+ *  @param node  - Pointer to source vertex
+ *  @return 	 - Pointer to dist array to all nodes in graph
+ */
+static t_distinfo *dijkstra_radix(t_graph *g, t_gnode *node)
+{
+	t_gedge *v;
+	t_llnode *cur, *end;
+	t_linklist *neigh_list;
+	t_distinfo *dist;
+	t_radix_heap *h;
+	unsigned int key;
+	long long alt_weight;
+	int u;
+
+	h = create_radix_heap("Dijkstra's radix heap", g->count);
+
+	// Initalize all dist to all nodes as infinite 
+	dist = get_mem(g->count, sizeof(t_distinfo)); 	
+	for (int i = 0; i < g->count; i++) {
+		dist[i].edge.node   = &g->nodes[i];
+		dist[i].edge.weight = INT_MAX; 
+		dist[i].parent 	    = NULL;
+	}
+
+	// Set the source node dist as 0 and add it to heap
+	dist[node->idx].edge.weight = 0; 
+	h->insert(h, node->idx, 0);
+	while (h->empty(h) != true) {
+		// Get min dist vertex and relax all its edges
+		u = h->extract(h, &key);
+
+		neigh_list = (t_linklist*)g->nodes[u].neigh;
+		cur = neigh_list->ops->head_node(neigh_list);
+		end = neigh_list->ops->end_node(neigh_list);
+		while (cur) {
+			v = (t_gedge*)cur->data;
+
+			// a dist that does not fit below INT_MAX (unreached) is not relaxed
+			alt_weight = (long long)key + v->weight;
+			if (alt_weight < INT_MAX && dist[v->node->idx].edge.weight > alt_weight) {
+				dist[v->node->idx].edge.weight = alt_weight;
+				dist[v->node->idx].parent = &g->nodes[u];
+				if (h->bucket[v->node->idx] == -1) {
+					h->insert(h, v->node->idx, alt_weight);
+				} else {
+					h->decrease_key(h, v->node->idx, alt_weight);
+				}
+			}
+			
+			// Exit after neigh list traversal complete
+			cur = neigh_list->ops->next_node(neigh_list, cur);
+			if (cur == end) {
+				break;
+			}
+		}
+	}
+
+	h->destroy(h);
+
+	return dist;
+}
+
+/*! @brief  
+ *  Find the shortest path from a given source vertex to all source
+ *  nodes in a graph using Dijkstra's algo, a radix heap is used when
+ *  all edge weights are non negative else the binary heap
+ *  @see dijkstra_heap
+ *  @param d	 - Pointer instance of graph
+ *  @param data  - Pointer to source vertex data
+ *  @return 	 - Pointer to dist array to all nodes in graph
+ */
+t_gen dijkstra(t_gen d, t_gen data)
+{
+	t_graph *g = (t_graph*)d;
+	t_gnode *node;
+
+	// Get vertex
+	node = g->ops->find(g, data);
+	if (node == NULL) {
+		return NULL;
+	}
+
+	// Any negative edge weight breaks the monotone keys of radix heap
+	if (g->has_negative) {
+		return dijkstra_heap(d, data);
+	}
+
+	return dijkstra_radix(g, node);
+}
+
 /*! @brief  
  *  Find the shortest path from a given source vertex
  *  to all source nodes in a graph with negative edges
@@ -1146,7 +1502,7 @@ t_gen bellman_ford(t_gen d, t_gen data)
 	bool *in_q;
 
 	// Get vertex
-	node = g->find(g, data);
+	node = g->ops->find(g, data);
 	if (node == NULL) {
 		return NULL;
 	}
@@ -1173,8 +1529,8 @@ t_gen bellman_ford(t_gen d, t_gen data)
 		u = q->deq(q);
 		in_q[u->node->idx] = false;
 		neigh_list = (t_linklist*)u->node->neigh;
-		cur = neigh_list->head_node(neigh_list);
-		end = neigh_list->end_node(neigh_list);
+		cur = neigh_list->ops->head_node(neigh_list);
+		end = neigh_list->ops->end_node(neigh_list);
 	
 		while (cur) {
 			v = (t_gedge*)cur->data;
@@ -1194,7 +1550,7 @@ t_gen bellman_ford(t_gen d, t_gen data)
 			}
 
 			// Exit after neigh list traversal complete
-			cur = neigh_list->next_node(neigh_list, cur);
+			cur = neigh_list->ops->next_node(neigh_list, cur);
 			if (cur == end) {
 				break;
 			}
@@ -1224,6 +1580,12 @@ t_gen prims_mst(t_gen d)
 	t_heap *h;
 	t_dparams dp;
 	t_gen *pq;
+	bool *in_tree;
+
+	// Nothing to span
+	if (g->count == 0) {
+		return NULL;
+	}
 
 	// Data specific operation for generic min heap
 	init_data_params(&dp, eUSER);
@@ -1234,9 +1596,11 @@ t_gen prims_mst(t_gen d)
 	dp.copy_idx = gen_cpy_idx;
 	dp.get_idx  = gen_get_idx;
 
-	// Creating a generic min heap to store edges
+	// Creating a generic min heap to store edges, indexed by vertex
+	// so each vertex is in the heap at most once
 	pq   = get_mem(g->count, sizeof(t_gen)); 	
-	h    = create_heap("Dijkstra's Heap", pq, g->count, eMIN_HEAP, &dp);
+	h    = create_indexed_heap("Prim's Heap", pq, g->count, g->heap_type, &dp);
+	in_tree = get_mem(g->count, sizeof(bool));
 	
 	// Initalize all dist to all nodes as infinite 
 	dist = get_mem(g->count, sizeof(t_distinfo)); 	
@@ -1248,30 +1612,36 @@ t_gen prims_mst(t_gen d)
 	
 	
 	// Set 0 as start vertex
-	h->insert(h, &dist[0].edge);
+	dist[0].edge.weight = 0;
+	h->insert_handle(h, 0, &dist[0].edge);
 	while (h->empty(h) != true) {
 		// Of the edges that connect the tree to vertices not yet in the tree,
 		// Find the minimum-weight edge, and transfer it to the tree
 		u = h->extract(h);
+		in_tree[u->node->idx] = true;
 
 		neigh_list = (t_linklist*)u->node->neigh;
-		cur = neigh_list->head_node(neigh_list);
-		end = neigh_list->end_node(neigh_list);
+		cur = neigh_list->ops->head_node(neigh_list);
+		end = neigh_list->ops->end_node(neigh_list);
 		while (cur) {
 			v = (t_gedge*)cur->data;
 			
 			// If cur edge weight is greater than new edge
 			// and the end vertex is not visited
-			if (dist[v->node->idx].edge.weight > v->weight) {
+			if (in_tree[v->node->idx] != true && dist[v->node->idx].edge.weight > v->weight) {
 				// Set new edge as part of MST, update parent
-				// and add edge to heap
+				// and add edge to heap or move it up if present
 				dist[v->node->idx].edge.weight = v->weight;
 				dist[v->node->idx].parent = u->node;
-				h->insert(h, &dist[v->node->idx].edge);
+				if (h->pos[v->node->idx] == -1) {
+					h->insert_handle(h, v->node->idx, &dist[v->node->idx].edge);
+				} else {
+					h->decrease_key(h, v->node->idx, &dist[v->node->idx].edge);
+				}
 			}
 			
 			// Exit after neigh list traversal complete
-			cur = neigh_list->next_node(neigh_list, cur);
+			cur = neigh_list->ops->next_node(neigh_list, cur);
 			if (cur == end) {
 				break;
 			}
@@ -1281,6 +1651,7 @@ t_gen prims_mst(t_gen d)
 	// Destroy heap and destroy the array used for storing heap
 	h->destroy(h);
 	free_mem(pq);
+	free_mem(in_tree);
 
 	return dist;
 }
@@ -1313,14 +1684,14 @@ t_gen kruskals_mst(t_gen d)
 	// Create edge list from Adjancency list
 	for (j = i = 0; i < g->count; i++) {
 		neigh_list = (t_linklist*)(g->nodes[i].neigh);
-		cur = neigh_list->head_node(neigh_list);
-		end = neigh_list->end_node(neigh_list);
+		cur = neigh_list->ops->head_node(neigh_list);
+		end = neigh_list->ops->end_node(neigh_list);
 		while (cur) {
 			tmp[j].parent = &g->nodes[i];
 			tmp[j++].edge = *((t_gedge*)cur->data);
 			
 			// Exit after neigh list traversal complete
-			cur = neigh_list->next_node(neigh_list, cur);
+			cur = neigh_list->ops->next_node(neigh_list, cur);
 			if (cur == end) {
 				break;
 			}
@@ -1370,9 +1741,25 @@ void graph_destroy(t_gen d)
 	t_graph *g = (t_graph*)d;
 	int i;
 	
+	if (g->index != NULL) {
+		g->index->destroy(g->index);
+	}
+	graph_index_edges(g, false);
+
+	// Arena graph, only vertex data lives outside the arena
+	if (g->arena != NULL) {
+		if (g->free != dummy_free) {
+			for (i = 0; i < g->count; i++) {
+				g->free(g->nodes[i].id, __FILE__, __LINE__);
+			}
+		}
+		destroy_arena(g->arena);
+		return;
+	}
+
 	// Go through each node and delete neigh list and data
 	for (i = 0; i < g->count; i++) {
-		g->nodes[i].neigh->destroy(g->nodes[i].neigh);
+		g->nodes[i].neigh->ops->destroy(g->nodes[i].neigh);
 		g->free(g->nodes[i].id, __FILE__, __LINE__);
 	}
 	
@@ -1381,3 +1768,538 @@ void graph_destroy(t_gen d)
 }
 
 
+
+/// Pending vertex of the csr min heaps, keyed on dist of the vertex when added
+typedef struct csr_item {
+	int weight;			///< Dist (or edge cost) of vertex when added
+	int idx;			///< Index of vertex
+} t_csr_item;
+
+#define CSR_ITEM_CMP(x, y)	CMP_NUM((x).weight, (y).weight)
+
+DEFINE_HEAP(t_csr_item, csr_heap, CSR_ITEM_CMP)
+
+// csr function Declarations
+t_gen csr_bfs(t_gen d, t_gen n);
+t_gen csr_dfs(t_gen d, t_gen n);
+t_gen csr_toplogicaly_order_dag(t_gen d);
+t_gen csr_find(t_gen d, t_gen data);
+int csr_len(t_gen d);
+void csr_destroy(t_gen d);
+
+/// Routines shared by all csr snapshots
+static const t_csr_ops csr_ops = {
+	.bfs	        = csr_bfs,
+	.dfs	        = csr_dfs,
+	.topo_order_dag = csr_toplogicaly_order_dag,
+	.find 	        = csr_find,
+	.len	        = csr_len,
+	.destroy        = csr_destroy,
+};
+
+/*! @brief  
+ *  Freeze a graph into a compressed sparse row snapshot, the edges of
+ *  each vertex are laid out back to back in neigh list order so the
+ *  csr routines stream through arrays instead of chasing list nodes
+ *  @param d	 - Pointer instance of graph
+ *  @return 	 - Pointer to csr snapshot of graph
+ */
+t_gen graph_freeze(t_gen d)
+{
+	t_graph *g = (t_graph*)d;
+	t_csr *c = get_mem(1, sizeof(t_csr));
+	t_linklist *neigh_list;
+	t_llnode *cur, *end;
+	t_gedge *edge;
+	int i, j, edges = 0;
+
+	// Edge count from neigh lists, total_edges is not kept on deletes
+	for (i = 0; i < g->count; i++) {
+		neigh_list = g->nodes[i].neigh;
+		edges += neigh_list->ops->len(neigh_list);
+	}
+
+	c->g	       = g;
+	c->count       = g->count;
+	c->total_edges = edges;
+	c->offsets     = get_mem(g->count + 1, sizeof(int));
+	c->targets     = get_mem(edges + 1, sizeof(int));
+	c->weights     = get_mem(edges + 1, sizeof(int));
+	c->ops	       = &csr_ops;
+
+	for (j = i = 0; i < g->count; i++) {
+		c->offsets[i] = j;
+		neigh_list = g->nodes[i].neigh;
+		cur = neigh_list->ops->head_node(neigh_list);
+		end = neigh_list->ops->end_node(neigh_list);
+		while (cur) {
+			edge = cur->data;
+			c->targets[j] = edge->node->idx;
+			c->weights[j++] = edge->weight;
+			cur = neigh_list->ops->next_node(neigh_list, cur);
+			if (cur == end) {
+				break;
+			}
+		}
+	}
+	c->offsets[i] = j;
+
+	return c;
+}
+
+/*! @brief  
+ *   get num Vertex(nodes) in csr snapshot;
+ *  @param d	- Pointer instance of csr snapshot
+ *  @return 	- Vertex(node) Count
+ */
+int csr_len(t_gen d)
+{
+	return ((t_csr*)d)->count;
+}
+
+/*! @brief  
+ *  Find a Vertex(node) in csr snapshot;
+ *  @param d	- Pointer instance of csr snapshot
+ *  @param data	- Pointer to data
+ *  @return 	- Pointer to Vertex(node) of graph containing data else null
+ */
+t_gen csr_find(t_gen d, t_gen data)
+{
+	t_csr *c = (t_csr*)d;
+
+	return c->g->ops->find(c->g, data);
+}
+
+/*! @brief  
+ *  Breath First Search on csr snapshot, vertex indexes are
+ *  queued in a plain array as each vertex is queued once
+ *  @see graph_bfs
+ *  @param d	- Pointer instance of csr snapshot
+ *  @param n	- Pointer to data1 (Source node from where to start BFS)
+ *  @return 	- Pointer to BFS info if node present else null
+ */
+t_gen csr_bfs(t_gen d, t_gen n)
+{
+	t_csr *c = (t_csr*)d;
+	t_gnode *node;
+	t_bfsinfo *bfs;
+	int *q, head, tail, u, v, e, i, comp;
+
+	// Find node
+	node = c->ops->find(c, n);
+
+	// return if node doesn't exist
+	if (node == NULL) {
+		return NULL;
+	}
+
+	q   = get_mem(c->count, sizeof(int));
+	bfs = get_mem(c->count, sizeof(t_bfsinfo));
+	for (i = 0; i < c->count; i++) {
+		bfs[i].parent = NULL;
+		bfs[i].comp = bfs[i].level  = -1;
+	}
+
+	// Run BFS for different connected Components of graph
+	// starting with the source and then each unvisited vertex
+	head = tail = 0;
+	for (comp = 0, i = -1, u = node->idx; u < c->count; u = ++i) {
+		if (i != -1 && (u == node->idx || bfs[u].level != -1)) {
+			continue;
+		}
+		bfs[u].level  = 0;
+		bfs[u].comp   = comp++;
+		q[tail++] = u;
+		while (head != tail) {
+			u = q[head++];
+			for (e = c->offsets[u]; e < c->offsets[u + 1]; e++) {
+				v = c->targets[e];
+				if (bfs[v].level == -1) {
+					bfs[v].level  = bfs[u].level + 1;
+					bfs[v].parent = c->g->nodes[u].id;
+					bfs[v].comp   = bfs[u].comp;
+					q[tail++] = v;
+				}
+			}
+		}
+	}
+
+	free_mem(q);
+
+	return bfs;
+}
+
+/*! @brief  
+ *  Depth First Search on csr snapshot, the stack holds vertex
+ *  indexes and each vertex resumes its edge scan where it left off
+ *  @see graph_dfs
+ *  @param d	- Pointer instance of csr snapshot
+ *  @param n	- Pointer to data1 (Source node from where to start DFS)
+ *  @return 	- Pointer to DFS info of all nodes if node present else null
+ */
+t_gen csr_dfs(t_gen d, t_gen n)
+{
+	t_csr *c = (t_csr*)d;
+	t_gnode *node;
+	t_dfsinfo *dfs;
+	int *stack, *pos, top, u, v, i, comp, count;
+
+	// Find node
+	node = c->ops->find(c, n);
+
+	// return if node doesn't exist
+	if (node == NULL) {
+		return NULL;
+	}
+
+	stack = get_mem(c->count, sizeof(int));
+	pos   = get_mem(c->count, sizeof(int));
+	dfs   = get_mem(c->count, sizeof(t_dfsinfo));
+	for (i = 0; i < c->count; i++) {
+		dfs[i].comp = -1;
+		dfs[i].parent = NULL;
+		dfs[i].pre = dfs[i].post = -1;
+		dfs[i].visited_neighbors = 1;
+		pos[i] = c->offsets[i];
+	}
+
+	// Run DFS for different connected Components of graph
+	// starting with the source and then each unvisited vertex
+	count = 0;
+	for (comp = 0, i = -1, u = node->idx; u < c->count; u = ++i) {
+		if (i != -1 && (u == node->idx || dfs[u].pre != -1)) {
+			continue;
+		}
+		dfs[u].pre  = count++;
+		dfs[u].comp = comp++;
+		stack[0] = u;
+		top = 1;
+		while (top) {
+			u = stack[top - 1];
+			// All neighbors visited update post count on exit
+			if (pos[u] == c->offsets[u + 1]) {
+				dfs[u].visited_neighbors = 0;
+				dfs[u].post = count++;
+				top--;
+				continue;
+			}
+			v = c->targets[pos[u]++];
+			if (dfs[v].pre == -1) {
+				dfs[v].parent = c->g->nodes[u].id;
+				dfs[v].pre    = count++;
+				dfs[v].comp   = dfs[u].comp;
+				stack[top++]  = v;
+			}
+		}
+	}
+
+	free_mem(stack);
+	free_mem(pos);
+
+	return dfs;
+}
+
+/*! @brief  
+ *  Topologicaly order a DAG csr snapshot and get longest path
+ *  to each vertex
+ *  @see graph_toplogicaly_order_dag
+ *  @param d	- Pointer instance of csr snapshot
+ *  @return 	- Pointer to dag info of all nodes
+ */
+t_gen csr_toplogicaly_order_dag(t_gen d)
+{
+	t_csr *c = (t_csr*)d;
+	t_daginfo *dag_inf;
+	int *q, head, tail, u, v, e, i;
+
+	q       = get_mem(c->count, sizeof(int));
+	dag_inf = get_mem(c->count, sizeof(t_daginfo));
+	for (i = 0; i < c->count; i++) {
+		dag_inf[i].indegree     = 0;
+		dag_inf[i].longest_path = 0;
+	}
+
+	// Update indegree for all nodes
+	for (e = 0; e < c->total_edges; e++) {
+		dag_inf[c->targets[e]].indegree += 1;
+	}
+
+	// Add vertices with indegree 0
+	head = tail = 0;
+	for (i = 0; i < c->count; i++) {
+		if (dag_inf[i].indegree == 0) {
+			q[tail++] = i;
+		}
+	}
+
+	// Enumerate vertices and update longest path and indegree of neighbors
+	while (head != tail) {
+		u = q[head++];
+		dag_inf[u].node     = c->g->nodes[u].id;
+		dag_inf[u].indegree = -1;
+		for (e = c->offsets[u]; e < c->offsets[u + 1]; e++) {
+			v = c->targets[e];
+			dag_inf[v].indegree -= 1;
+			if (dag_inf[v].longest_path <= dag_inf[u].longest_path) {
+				dag_inf[v].longest_path = dag_inf[u].longest_path + 1;
+			}
+			if (dag_inf[v].indegree == 0) {
+				q[tail++] = v;
+			}
+		}
+	}
+
+	free_mem(q);
+
+	return dag_inf;
+}
+
+/*! @brief  
+ *  Util to allocate and init dist array of a csr snapshot
+ *  @param c	 - Pointer instance of csr snapshot
+ *  @return 	 - Pointer to dist array with all dist infinite
+ */
+static t_distinfo *csr_dist_init(t_csr *c)
+{
+	t_distinfo *dist = get_mem(c->count, sizeof(t_distinfo));
+
+	for (int i = 0; i < c->count; i++) {
+		dist[i].edge.node   = &c->g->nodes[i];
+		dist[i].edge.weight = INT_MAX;
+		dist[i].parent      = NULL;
+	}
+
+	return dist;
+}
+
+/*! @brief  
+ *  Shortest path from a given source vertex to all vertices of a csr
+ *  snapshot using Dijkstra's algo, the heap holds (dist, vertex) pairs
+ *  by value and entries made stale by a shorter dist are skipped
+ *  @see dijkstra
+ *  @param d	 - Pointer instance of csr snapshot
+ *  @param data  - Pointer to source vertex data
+ *  @return 	 - Pointer to dist array to all nodes in graph
+ */
+t_gen csr_dijkstra(t_gen d, t_gen data)
+{
+	t_csr *c = (t_csr*)d;
+	t_gnode *node;
+	t_distinfo *dist;
+	t_csr_heap h;
+	t_csr_item u, *pq;
+	int e, v, alt_weight;
+
+	// Get vertex
+	node = c->ops->find(c, data);
+	if (node == NULL) {
+		return NULL;
+	}
+
+	// Each edge adds at most one entry
+	pq = get_mem(c->total_edges + 1, sizeof(t_csr_item));
+	csr_heap_init(&h, pq, c->total_edges + 1);
+	dist = csr_dist_init(c);
+
+	// Set the source node dist as 0
+	dist[node->idx].edge.weight = 0;
+	u.weight = 0;
+	u.idx = node->idx;
+	csr_heap_insert(&h, u);
+	while (h.count) {
+		csr_heap_extract(&h, &u);
+		// Skip stale entry, vertex already settled with a shorter dist
+		if (u.weight > dist[u.idx].edge.weight) {
+			continue;
+		}
+		for (e = c->offsets[u.idx]; e < c->offsets[u.idx + 1]; e++) {
+			v = c->targets[e];
+			alt_weight = u.weight + c->weights[e];
+			if (dist[v].edge.weight > alt_weight) {
+				dist[v].edge.weight = alt_weight;
+				dist[v].parent = &c->g->nodes[u.idx];
+				csr_heap_insert(&h, (t_csr_item){alt_weight, v});
+			}
+		}
+	}
+
+	free_mem(pq);
+
+	return dist;
+}
+
+/*! @brief  
+ *  Shortest path from a given source vertex to all vertices of a csr
+ *  snapshot with negative edges using SPFA, each vertex is queued at
+ *  most once at a time so a ring of vertex count indexes is enough
+ *  @see bellman_ford
+ *  @param d	 - Pointer instance of csr snapshot
+ *  @param data  - Pointer to source vertex data
+ *  @return 	 - Pointer to dist array to all nodes in graph
+ */
+t_gen csr_bellman_ford(t_gen d, t_gen data)
+{
+	t_csr *c = (t_csr*)d;
+	t_gnode *node;
+	t_distinfo *dist;
+	int *q, head, len, u, v, e, alt_weight;
+	bool *in_q;
+
+	// Get vertex
+	node = c->ops->find(c, data);
+	if (node == NULL) {
+		return NULL;
+	}
+
+	q    = get_mem(c->count, sizeof(int));
+	in_q = get_mem(c->count, sizeof(bool));
+	dist = csr_dist_init(c);
+
+	// Set the source node dist as 0
+	dist[node->idx].edge.weight = 0;
+	q[0] = node->idx;
+	in_q[node->idx] = true;
+	head = 0;
+	len  = 1;
+	while (len) {
+		u = q[head];
+		head = (head + 1) % c->count;
+		len--;
+		in_q[u] = false;
+		for (e = c->offsets[u]; e < c->offsets[u + 1]; e++) {
+			v = c->targets[e];
+			alt_weight = dist[u].edge.weight + c->weights[e];
+			if (dist[v].edge.weight > alt_weight) {
+				dist[v].edge.weight = alt_weight;
+				dist[v].parent = &c->g->nodes[u];
+				if (in_q[v] != true) {
+					q[(head + len++) % c->count] = v;
+					in_q[v] = true;
+				}
+			}
+		}
+	}
+
+	free_mem(q);
+	free_mem(in_q);
+
+	return dist;
+}
+
+/*! @brief  
+ *  Minimum Spanning tree of weighted undirected csr snapshot using
+ *  Prim's Algorithm from vertex 0, vertices taken into the tree are
+ *  not relaxed again and stale heap entries are skipped
+ *  @see prims_mst
+ *  @param d	 - Pointer instance of csr snapshot
+ *  @return 	 - Pointer to dist array to all nodes in graph
+ */
+t_gen csr_prims_mst(t_gen d)
+{
+	t_csr *c = (t_csr*)d;
+	t_distinfo *dist;
+	t_csr_heap h;
+	t_csr_item u, *pq;
+	bool *in_tree;
+	int e, v;
+
+	dist = csr_dist_init(c);
+	if (c->count == 0) {
+		return dist;
+	}
+
+	pq = get_mem(c->total_edges + 1, sizeof(t_csr_item));
+	in_tree = get_mem(c->count, sizeof(bool));
+	csr_heap_init(&h, pq, c->total_edges + 1);
+
+	// Set 0 as start vertex
+	dist[0].edge.weight = 0;
+	csr_heap_insert(&h, (t_csr_item){0, 0});
+	while (h.count) {
+		csr_heap_extract(&h, &u);
+		// Of the edges that connect the tree to vertices not yet in the tree,
+		// Take the minimum-weight edge, and transfer its vertex to the tree
+		if (in_tree[u.idx] == true) {
+			continue;
+		}
+		in_tree[u.idx] = true;
+		for (e = c->offsets[u.idx]; e < c->offsets[u.idx + 1]; e++) {
+			v = c->targets[e];
+			if (in_tree[v] != true && dist[v].edge.weight > c->weights[e]) {
+				dist[v].edge.weight = c->weights[e];
+				dist[v].parent = &c->g->nodes[u.idx];
+				csr_heap_insert(&h, (t_csr_item){c->weights[e], v});
+			}
+		}
+	}
+
+	free_mem(pq);
+	free_mem(in_tree);
+
+	return dist;
+}
+
+/*! @brief  
+ *  Minimum Spanning for weighted undirected csr snapshot using
+ *  Kruskal's Algorithm, the edge list is read straight off the arrays
+ *  @see kruskals_mst
+ *  @param d	 - Pointer instance of csr snapshot
+ *  @return 	 - Pointer to dist array to all nodes in graph
+ */
+t_gen csr_kruskals_mst(t_gen d)
+{
+	t_csr *c = (t_csr*)d;
+	t_gnode *nodes = c->g->nodes;
+	t_distinfo *dist, *tmp;
+	t_dparams dp;
+	t_disjset *set;
+	int i, j, e;
+
+	tmp  = get_mem(c->total_edges + 1, sizeof(t_distinfo));
+	dist = get_mem(c->count, sizeof(t_distinfo));
+	set  = create_disjoint_set("Kruskal csr set", c->count);
+
+	// Create edge list
+	for (i = 0; i < c->count; i++) {
+		for (e = c->offsets[i]; e < c->offsets[i + 1]; e++) {
+			tmp[e].parent = &nodes[i];
+			tmp[e].edge.node = &nodes[c->targets[e]];
+			tmp[e].edge.weight = c->weights[e];
+		}
+	}
+
+	// Sort the edge List based on weights
+	init_data_params(&dp, eUSER);
+	dp.cmpr_idx = graph_wedge_cmpr_idx2;
+	dp.swap_idx = graph_wedge_swap_idx;
+	quick_sort(tmp, c->total_edges, &dp);
+
+	// Add edges in ascending order if they join two trees of the forest
+	set->make(set);
+	for (j = i = 0; (j < c->count) && (i < c->total_edges); i++) {
+		if (set->find(set, tmp[i].parent->idx) != set->find(set, tmp[i].edge.node->idx)) {
+			dist[j++] = tmp[i];
+			set->merge(set, tmp[i].parent->idx, tmp[i].edge.node->idx);
+		}
+	}
+
+	set->destroy(set);
+	free_mem(tmp);
+
+	return dist;
+}
+
+/*! @brief  
+ *  Destroy instance of csr snapshot, the graph is left as is
+ *  @param d	 - Pointer instance of csr snapshot
+ *  @return 	 - NA
+ */
+void csr_destroy(t_gen d)
+{
+	t_csr *c = (t_csr*)d;
+
+	free_mem(c->offsets);
+	free_mem(c->targets);
+	free_mem(c->weights);
+	free_mem(c);
+}
@@ -5,6 +5,8 @@
 #pragma once
 #include "common.h"
 #include "link_list.h"
+#include "hash_map.h"
+#include "heap.h"
 
 /// graph Vertex
 typedef struct gnode {
@@ -22,18 +24,8 @@ typedef struct gedge {
 // fn ptr for adding weighted edge
 typedef t_gen (*f_wedge)(t_gen, t_gen, t_gen, int);	
 
-/// graph struct defn
-typedef struct graph {
-	// graph info params
-	char *name;			///< Graph Instance Name
-	int count;			///< Vertex Count of graph
-	int max_size;			///< Max Vertex count of graph
-	int total_edges;		///< Edge count of graph
-
-	// graph nodes
-	t_gnode *nodes;			///< Adaceny List Representation of graph vertices
-
-	// graph routines
+/// graph routines, one const table shared by all graph instances
+typedef struct graph_ops {
 	f_gen2 add_vertex;		///< routine to add a vertex in graph
 	f_gen2 del_vertex;		///< routine to del a vertex in graph
 	f_gen3 add_edge;		///< routine to add an edge in graph
@@ -52,6 +44,26 @@ typedef struct graph {
 	f_print print;			///< routine to print graph info
 	f_print wprint;			///< routine to print graph info with edge weights
 	f_destroy destroy;		///< routine to destroy the graph instance
+} t_graph_ops;
+
+/// graph struct defn
+typedef struct graph {
+	// graph info params
+	char *name;			///< Graph Instance Name
+	int count;			///< Vertex Count of graph
+	int max_size;			///< Max Vertex count of graph
+	int total_edges;		///< Edge count of graph
+
+	// graph nodes
+	t_gnode *nodes;			///< Adaceny List Representation of graph vertices
+	t_arena *arena;			///< Arena nodes, edges and neigh lists are allocated from (NULL for tagged mem)
+	t_hash_map *index;		///< Vertex id to idx of vertex in nodes (NULL if data type has no hash)
+	t_hash_map *edges;		///< (src idx, dst idx) to edge set (NULL unless enabled by graph_index_edges)
+	e_heaptype heap_type;		///< Min heap layout used by dijkstra_heap and prims_mst (eMIN_HEAP/4/8)
+	bool has_negative;		///< An edge with negative weight was added, dijkstra then skips the radix heap
+
+	// graph routines
+	const t_graph_ops *ops;		///< Routines of graph, called as g->ops->add_vertex(g, x)
 	
 	// routies for operating on data
 	f_cmpr cmpr;
@@ -89,9 +101,40 @@ typedef struct dist_info {
 	t_gnode *parent;		///< Pointer to Vertex vertex
 } t_distinfo;
 
+/// graph csr routines, one const table shared by all csr snapshots
+typedef struct graph_csr_ops {
+	f_gen2 bfs;			///< routine to Breadth First Search in snapshot
+	f_gen2 dfs;			///< routine to Depth First Search in snapshot
+	f_gen topo_order_dag;		///< routine to topologica order a DAG snapshot
+	f_find find;			///< routine to find a vertex in snapshot
+	f_len len;			///< routine to get vertex count in snapshot
+	f_destroy destroy;		///< routine to destroy the snapshot
+} t_csr_ops;
+
+/// Frozen compressed sparse row snapshot of a graph, the edges of vertex i are
+/// targets[offsets[i]] till targets[offsets[i + 1] - 1] with matching weights.
+/// Results refer to the vertices of the graph, which must not be changed while in use
+typedef struct graph_csr {
+	t_graph *g;			///< Graph the snapshot is of
+	int count;			///< Vertex Count of snapshot
+	int total_edges;		///< Edge count of snapshot
+	int *offsets;			///< Start of edges per vertex in targets/weights, count + 1 entries
+	int *targets;			///< Index of destination vertex per edge
+	int *weights;			///< Cost per edge
+	const t_csr_ops *ops;		///< Routines of snapshot, called as c->ops->bfs(c, x)
+} t_csr;
+
 /// graph interface APIs
 t_gen create_graph(char *name, int size, t_dparams *prm);
+t_gen create_graph_in_arena(char *name, int size, t_dparams *prm, t_arena *arena);
+void graph_index_edges(t_gen d, bool enable);
 t_gen dijkstra(t_gen d, t_gen data);
+t_gen dijkstra_heap(t_gen d, t_gen data);
 t_gen bellman_ford(t_gen d, t_gen data);
 t_gen prims_mst(t_gen d);
 t_gen kruskals_mst(t_gen d);
+t_gen graph_freeze(t_gen d);
+t_gen csr_dijkstra(t_gen d, t_gen data);
+t_gen csr_bellman_ford(t_gen d, t_gen data);
+t_gen csr_prims_mst(t_gen d);
+t_gen csr_kruskals_mst(t_gen d);
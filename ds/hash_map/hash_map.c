@@ -0,0 +1,422 @@
+/*! @file hash_map.c
+    @brief 
+    Contains definitions of routines supported by hash map
+*/
+#include "hash_map.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+t_gen hash_map_insert(t_gen d, t_gen key, t_gen val);
+t_gen hash_map_find(t_gen d, t_gen key);
+t_gen hash_map_del(t_gen d, t_gen key);
+int hash_map_next(t_gen d, int idx, t_gen *key, t_gen *val);
+int hash_map_len(t_gen d);
+void hash_map_print(t_gen d);
+void destroy_hash_map(t_gen d);
+
+/*! @brief  
+ *  Mask of slots in a group whose control byte matches
+ *  @param grp  - Pointer to control bytes of the group
+ *  @param ctrl - Control byte to match
+ *  @return     - bit i set if slot i of group matches
+ * */
+static inline uint32_t hmap_match(int8_t *grp, int8_t ctrl)
+{
+#ifdef __SSE2__
+	__m128i c = _mm_loadu_si128((__m128i*)grp);
+
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(c, _mm_set1_epi8(ctrl)));
+#else
+	uint32_t mask = 0;
+	int i;
+
+	for (i = 0; i < HMAP_GROUP; i++) {
+		mask |= (uint32_t)(grp[i] == ctrl) << i;
+	}
+	return mask;
+#endif
+}
+
+/*! @brief  
+ *  Mask of slots in a group that are empty or deleted,
+ *  only those control bytes have the top bit set
+ *  @param grp  - Pointer to control bytes of the group
+ *  @return     - bit i set if slot i of group is free
+ * */
+static inline uint32_t hmap_match_free(int8_t *grp)
+{
+#ifdef __SSE2__
+	return _mm_movemask_epi8(_mm_loadu_si128((__m128i*)grp));
+#else
+	uint32_t mask = 0;
+	int i;
+
+	for (i = 0; i < HMAP_GROUP; i++) {
+		mask |= (uint32_t)(grp[i] < 0) << i;
+	}
+	return mask;
+#endif
+}
+
+/*! @brief  
+ *  Get key stored in a slot
+ *  @param m    - Pointer to instance of hash map
+ *  @param slot - Slot idx
+ *  @return     - key ptr (address of the key if inline)
+ * */
+static inline t_gen hmap_key(t_hash_map *m, int slot)
+{
+	if (m->elem_size == 0) {
+		return ((t_gen*)m->keys)[slot];
+	}
+	return (char*)m->keys + (size_t)slot * m->elem_size;
+}
+
+/*! @brief  
+ *  Store key in a slot
+ *  @param m    - Pointer to instance of hash map
+ *  @param slot - Slot idx
+ *  @param key  - key ptr, copied if inline
+ *  @return     - NA
+ * */
+static inline void hmap_set_key(t_hash_map *m, int slot, t_gen key)
+{
+	if (m->elem_size == 0) {
+		((t_gen*)m->keys)[slot] = key;
+	} else {
+		memcpy((char*)m->keys + (size_t)slot * m->elem_size, key, m->elem_size);
+	}
+}
+
+/*! @brief  
+ *  Get slot holding a key, groups are probed in triangular
+ *  order which visits every group when their count is a power of 2
+ *  @param m    - Pointer to instance of hash map
+ *  @param key  - key to look for
+ *  @param h    - hash of the key
+ *  @return     - slot idx, -1 if key not present
+ * */
+static int hmap_find_slot(t_hash_map *m, t_gen key, uint64_t h)
+{
+	int gmask = m->capacity / HMAP_GROUP - 1;
+	int g = (h >> 7) & gmask, step, slot;
+	int8_t *grp;
+	uint32_t match;
+
+	for (step = 1; ; step++) {
+		grp = m->ctrl + g * HMAP_GROUP;
+		// only slots with the same 7 bits of hash are compared
+		match = hmap_match(grp, h & 0x7F);
+		while (match) {
+			slot = g * HMAP_GROUP + __builtin_ctz(match);
+			if (m->cmpr(hmap_key(m, slot), key) == eEQUAL) {
+				return slot;
+			}
+			match &= match - 1;
+		}
+		// an empty slot ends the probe, the key would have gone there
+		if (hmap_match(grp, HMAP_EMPTY)) {
+			return -1;
+		}
+		g = (g + step) & gmask;
+	}
+}
+
+/*! @brief  
+ *  Get first empty or deleted slot on the probe path of a hash
+ *  @param m    - Pointer to instance of hash map
+ *  @param h    - hash of the key
+ *  @return     - slot idx
+ * */
+static int hmap_free_slot(t_hash_map *m, uint64_t h)
+{
+	int gmask = m->capacity / HMAP_GROUP - 1;
+	int g = (h >> 7) & gmask, step;
+	uint32_t match;
+
+	for (step = 1; ; step++) {
+		match = hmap_match_free(m->ctrl + g * HMAP_GROUP);
+		if (match) {
+			return g * HMAP_GROUP + __builtin_ctz(match);
+		}
+		g = (g + step) & gmask;
+	}
+}
+
+/*! @brief  
+ *  Allocate empty slots of the map
+ *  @param m        - Pointer to instance of hash map
+ *  @param capacity - Slots (power of 2, multiple of HMAP_GROUP)
+ *  @return         - NA
+ * */
+static void hmap_alloc(t_hash_map *m, int capacity)
+{
+	m->capacity    = capacity;
+	m->growth_left = (int)((long)capacity * HMAP_LOAD_NUM / HMAP_LOAD_DEN);
+	m->ctrl        = get_mem(capacity, sizeof(int8_t));
+	m->keys        = get_mem(capacity, (m->elem_size != 0)? m->elem_size : sizeof(t_gen));
+	m->vals        = get_mem(capacity, sizeof(t_gen));
+	memset(m->ctrl, HMAP_EMPTY, capacity);
+}
+
+/*! @brief  
+ *  Move all elems to new slots, drops the deleted slots
+ *  @param m        - Pointer to instance of hash map
+ *  @param capacity - Slots of the new table
+ *  @return         - NA
+ * */
+static void hmap_resize(t_hash_map *m, int capacity)
+{
+	int8_t *ctrl = m->ctrl;
+	t_gen keys = m->keys, key;
+	t_gen *vals = m->vals;
+	int i, slot, old_capacity = m->capacity;
+	uint64_t h;
+
+	hmap_alloc(m, capacity);
+	for (i = 0; i < old_capacity; i++) {
+		if (ctrl[i] < 0) {
+			continue;
+		}
+		key = (m->elem_size == 0)? ((t_gen*)keys)[i] : (char*)keys + (size_t)i * m->elem_size;
+		// keys are unique, no compare needed
+		h = m->hash(key);
+		slot = hmap_free_slot(m, h);
+		m->ctrl[slot] = h & 0x7F;
+		hmap_set_key(m, slot, key);
+		m->vals[slot] = vals[i];
+		m->growth_left--;
+	}
+
+	free_mem(ctrl);
+	free_mem(keys);
+	free_mem(vals);
+}
+
+/*! @brief  
+ *  Create an instance of hash map
+ *  @param name     - Name of hash map instance
+ *  @param capacity - Elems the map holds before it first grows
+ *  @param prm      - Data type specific parameters of the keys (hash required)
+ *  @return         - Pointer to instance of hash map, NULL if keys have no hash
+ * */
+t_gen create_hash_map(char *name, int capacity, t_dparams *prm)
+{
+	t_hash_map *m;
+	int slots = HMAP_GROUP;
+
+	if (prm->hash == NULL) {
+		LOG_ERROR("HASH_MAP", "%s: no hash routine for keys\n", name);
+		return NULL;
+	}
+
+	// slots to keep capacity elems under the max load
+	while ((long)slots * HMAP_LOAD_NUM / HMAP_LOAD_DEN < capacity) {
+		slots <<= 1;
+	}
+
+	m = get_mem(1, sizeof(t_hash_map));
+
+	// Initailze hash map Params
+	m->name       = name;
+	m->count      = 0;
+	m->elem_size  = prm->elem_size;
+
+	// Initailze hash map routines
+	m->insert     = hash_map_insert;
+	m->find       = hash_map_find;
+	m->del        = hash_map_del;
+	m->next       = hash_map_next;
+	m->len        = hash_map_len;
+	m->print      = hash_map_print;
+	m->destroy    = destroy_hash_map;
+
+	// Initailze key type based operations
+	m->cmpr       = prm->cmpr;
+	m->hash       = prm->hash;
+	m->free       = prm->free;
+	m->print_data = prm->print_data;
+
+	// inline keys live in the slots, nothing to free per key
+	if (m->elem_size != 0) {
+		m->free = dummy_free;
+	}
+
+	hmap_alloc(m, slots);
+
+	return (t_gen)m;
+}
+
+/*! @brief  
+ *  Add a key with its value, the map owns the key from then on
+ *  if the key is present only its value is replaced and the key
+ *  passed stays with the caller
+ *  @param d    - Pointer to instance of hash map
+ *  @param key  - Pointer to the key
+ *  @param val  - Value to be stored with the key
+ *  @return     - Pointer to the value slot of the key (valid till the map grows)
+ * */
+t_gen hash_map_insert(t_gen d, t_gen key, t_gen val)
+{
+	t_hash_map *m = (t_hash_map*)d;
+	uint64_t h = m->hash(key);
+	int slot;
+
+	slot = hmap_find_slot(m, key, h);
+	if (slot >= 0) {
+		m->vals[slot] = val;
+		return &m->vals[slot];
+	}
+
+	// grow, or only clean up deleted slots if the map is not that full
+	if (m->growth_left == 0) {
+		if ((long)m->count * HMAP_LOAD_DEN * 2 <= (long)m->capacity * HMAP_LOAD_NUM) {
+			hmap_resize(m, m->capacity);
+		} else {
+			hmap_resize(m, m->capacity * 2);
+		}
+	}
+
+	slot = hmap_free_slot(m, h);
+	if (m->ctrl[slot] == HMAP_EMPTY) {
+		m->growth_left--;
+	}
+	m->ctrl[slot] = h & 0x7F;
+	hmap_set_key(m, slot, key);
+	m->vals[slot] = val;
+	m->count++;
+
+	return &m->vals[slot];
+}
+
+/*! @brief  
+ *  Find the value of a key
+ *  @param d    - Pointer to instance of hash map
+ *  @param key  - Pointer to the key
+ *  @return     - Pointer to the value slot of the key, NULL if not present
+ * */
+t_gen hash_map_find(t_gen d, t_gen key)
+{
+	t_hash_map *m = (t_hash_map*)d;
+	int slot = hmap_find_slot(m, key, m->hash(key));
+
+	return (slot < 0)? NULL : &m->vals[slot];
+}
+
+/*! @brief  
+ *  Delete a key, the stored key is freed
+ *  @param d    - Pointer to instance of hash map
+ *  @param key  - Pointer to the key
+ *  @return     - Value of the key, NULL if not present
+ * */
+t_gen hash_map_del(t_gen d, t_gen key)
+{
+	t_hash_map *m = (t_hash_map*)d;
+	int slot = hmap_find_slot(m, key, m->hash(key));
+	t_gen val;
+
+	if (slot < 0) {
+		LOG_INFO("HASH_MAP", "%s: key not present\n", m->name);
+		return NULL;
+	}
+
+	val = m->vals[slot];
+	m->free(hmap_key(m, slot), __FILE__, __LINE__);
+
+	// probes stop at a group with an empty slot, so if the group of
+	// the slot has one no probe passes by and the slot can be empty
+	if (hmap_match(m->ctrl + (slot & ~(HMAP_GROUP - 1)), HMAP_EMPTY)) {
+		m->ctrl[slot] = HMAP_EMPTY;
+		m->growth_left++;
+	} else {
+		m->ctrl[slot] = HMAP_DELETED;
+	}
+	m->count--;
+
+	return val;
+}
+
+/*! @brief  
+ *  Iterate over elems of the map in slot order
+ *  for (i = m->next(m, -1, &k, &v); i >= 0; i = m->next(m, i, &k, &v))
+ *  @param d    - Pointer to instance of hash map
+ *  @param idx  - Slot of the current elem (-1 to start)
+ *  @param key  - Gets key of the next elem (can be NULL)
+ *  @param val  - Gets value of the next elem (can be NULL)
+ *  @return     - Slot of the next elem, -1 if no more elems
+ * */
+int hash_map_next(t_gen d, int idx, t_gen *key, t_gen *val)
+{
+	t_hash_map *m = (t_hash_map*)d;
+	uint32_t full;
+
+	// skip a group at a time, full slots have the top bit clear
+	for (idx++; idx < m->capacity; idx = (idx | (HMAP_GROUP - 1)) + 1) {
+		full = ~hmap_match_free(m->ctrl + (idx & ~(HMAP_GROUP - 1))) & 0xFFFF;
+		full &= 0xFFFF << (idx & (HMAP_GROUP - 1));
+		if (full) {
+			idx = (idx & ~(HMAP_GROUP - 1)) + __builtin_ctz(full);
+			if (key != NULL) {
+				*key = hmap_key(m, idx);
+			}
+			if (val != NULL) {
+				*val = m->vals[idx];
+			}
+			return idx;
+		}
+	}
+	return -1;
+}
+
+/*! @brief  
+ *  Get count of elems in map
+ *  @param d    - Pointer to instance of hash map
+ *  @return     - count of elems
+ * */
+int hash_map_len(t_gen d)
+{
+	return ((t_hash_map*)d)->count;
+}
+
+/*! @brief  
+ *  Print keys of the map
+ *  @param d    - Pointer to instance of hash map
+ *  @return     - NA
+ * */
+void hash_map_print(t_gen d)
+{
+	t_hash_map *m = (t_hash_map*)d;
+	t_gen key;
+	int i;
+
+	printf("%s {count: %d} {capacity: %d}\n[ ", m->name, m->count, m->capacity);
+	for (i = m->next(m, -1, &key, NULL); i >= 0; i = m->next(m, i, &key, NULL)) {
+		m->print_data(key);
+		printf(" ");
+	}
+	printf("]\n");
+}
+
+/*! @brief  
+ *  Destroy the instance of the hash map, stored keys are freed
+ *  @param d    - Pointer to instance of hash map
+ *  @return     - NA
+ * */
+void destroy_hash_map(t_gen d)
+{
+	t_hash_map *m = (t_hash_map*)d;
+	t_gen key;
+	int i;
+
+	if (m->free != dummy_free) {
+		for (i = m->next(m, -1, &key, NULL); i >= 0; i = m->next(m, i, &key, NULL)) {
+			m->free(key, __FILE__, __LINE__);
+		}
+	}
+
+	free_mem(m->ctrl);
+	free_mem(m->keys);
+	free_mem(m->vals);
+	free_mem(m);
+}
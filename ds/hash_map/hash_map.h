@@ -0,0 +1,50 @@
+/*! @file hash_map.h
+    @brief 
+    Contains declations of hash map operations and structure
+*/
+#pragma once
+#include "common.h"
+
+#define HMAP_GROUP		16		///< Slots whose control bytes are probed at once
+#define HMAP_EMPTY		((int8_t)0x80)	///< Control byte of a slot never used since last rehash
+#define HMAP_DELETED		((int8_t)0xFE)	///< Control byte of a slot whose elem was deleted
+#define HMAP_LOAD_NUM		7		///< Max load factor of the map is NUM/DEN
+#define HMAP_LOAD_DEN		8
+
+/// hash map iterate fn defn, gets key and value of the next elem after slot idx
+typedef int (*f_hmap_next)(t_gen d, int idx, t_gen *key, t_gen *val);
+
+/// Hash map struct defn, open addressing with a control byte per slot (swiss table)
+/// slots are split in groups of HMAP_GROUP and a probe checks the control bytes of
+/// a whole group with one compare, a full slot holds the low 7 bits of its key hash
+typedef struct hash_map {
+	// hash map info params
+	char *name;			///< Hash map instance name
+	int count;			///< Total elems present in map
+	int capacity;			///< Total slots (power of 2, multiple of HMAP_GROUP)
+	int growth_left;		///< Elems that can be added before the map grows
+	size_t elem_size;		///< Bytes of a key stored inline (0 stores key ptr)
+
+	// slots
+	int8_t *ctrl;			///< Control byte per slot, empty/deleted or 7 bits of hash
+	t_gen keys;			///< Key per slot, key ptrs or keys inline
+	t_gen *vals;			///< Value per slot
+
+	// hash map routines
+	f_gen3 insert;			///< routine to add key with value (replaced if key present)
+	f_find find;			///< routine to get ptr to value of a key
+	f_del del;			///< routine to delete a key and get its value
+	f_hmap_next next;		///< routine to iterate over elems
+	f_len len;			///< routine to get count of elems in map
+	f_print print;			///< routine to print map keys
+	f_destroy destroy;		///< routine to destroy the map instance
+
+	// routines for operating on keys
+	f_cmpr cmpr;
+	f_hash hash;
+	f_free free;
+	f_print print_data;
+} t_hash_map;
+
+// Hash map interface API
+t_gen create_hash_map(char *name, int capacity, t_dparams *prm);
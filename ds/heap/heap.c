@@ -14,6 +14,27 @@ void heap_print(t_gen d);
 bool heap_empty(t_gen d);
 bool heap_full(t_gen d);
 t_gen heap_update_key(t_gen d, t_gen val, int idx);
+bool heap_insert_handle(t_gen d, int handle, t_gen val);
+bool heap_decrease_key(t_gen d, int handle, t_gen val);
+bool radix_heap_insert(t_gen d, int handle, unsigned int key);
+bool radix_heap_decrease_key(t_gen d, int handle, unsigned int key);
+int radix_heap_extract(t_gen d, unsigned int *key);
+int radix_heap_len(t_gen d);
+bool radix_heap_empty(t_gen d);
+void destroy_radix_heap(t_gen d);
+t_gen pairing_heap_insert(t_gen d, t_gen data);
+t_gen pairing_heap_extract(t_gen d);
+t_gen pairing_heap_peek(t_gen d);
+void pairing_heap_meld(t_gen d, t_gen other);
+bool pairing_heap_decrease_key(t_gen d, t_gen node, t_gen val);
+int pairing_heap_len(t_gen d);
+bool pairing_heap_empty(t_gen d);
+void destroy_pairing_heap(t_gen d);
+bool top_k_add(t_gen d, t_gen data);
+t_gen top_k_threshold(t_gen d);
+t_gen top_k_result(t_gen d);
+int top_k_len(t_gen d);
+void destroy_top_k(t_gen d);
 void destroy_heap(t_gen d);
 
 
@@ -33,9 +54,16 @@ t_gen create_heap(char *name, t_gen data, int size, e_heaptype htype, t_dparams
 	// Initailze heap Params
 	h->name       = name;
 	h->type       = htype;
+	h->max        = (htype == eMAX_HEAP || htype == eMAX_HEAP4 || htype == eMAX_HEAP8);
+	h->arity      = (htype == eMIN_HEAP4 || htype == eMAX_HEAP4)? 4 :
+			(htype == eMIN_HEAP8 || htype == eMAX_HEAP8)? 8 : 2;
 	h->data       = data;
 	h->size       = size;
 	h->count      = 0;
+	h->pos        = NULL;
+	h->handles    = NULL;
+	h->min_size   = size;
+	h->own_data   = false;
 	
 	// Initailze heap routines
 	h->insert     = heap_insert;
@@ -44,6 +72,8 @@ t_gen create_heap(char *name, t_gen data, int size, e_heaptype htype, t_dparams
 	h->sort       = heap_sort;
 	h->len        = heap_len;
 	h->update     = heap_update_key;
+	h->insert_handle = heap_insert_handle;
+	h->decrease_key  = heap_decrease_key;
 	h->full	      = heap_full;
 	h->empty      = heap_empty;
 	h->print      = heap_print;
@@ -56,10 +86,125 @@ t_gen create_heap(char *name, t_gen data, int size, e_heaptype htype, t_dparams
 	h->copy_idx   =	prm->copy_idx;
 	h->get_idx    =	prm->get_idx;
 	h->print_data =	prm->print_data;
+	h->elem_size  = prm->elem_size;
+
+	// Elems of an idx routine heap have no known size so its array can not be moved
+	h->auto_grow  = prm->auto_grow;
+	h->shrink_div = (prm->shrink_div >= 2)? prm->shrink_div : 0;
+	if (h->elem_size == 0 && (h->auto_grow || h->shrink_div)) {
+		LOG_WARN("HEAP", "%s: resize needs inline elems (elem_size), fixed size\n",h->name);
+		h->auto_grow  = false;
+		h->shrink_div = 0;
+	}
 	
 	return (t_gen)h;
 }
 
+/*! @brief  
+ *  Create an instance of indexed heap, each elem is inserted with a
+ *  handle in 0 to size - 1 and a position map from handle to heap idx
+ *  is kept so the key of an elem can be changed by its handle
+ *  @param name     - Name of heap instance
+ *  @param size     - Max size of heap instance and bound of handles
+ *  @param type     - Type of heap to be created
+ *  @param data     - Array pointer to build heap
+ *  @param prm      - Data type specific parameters
+ *  @return         - Pointer to instance of heap
+*/
+t_gen create_indexed_heap(char *name, t_gen data, int size, e_heaptype htype, t_dparams *prm)
+{
+	t_heap *h = create_heap(name, data, size, htype, prm);
+	int i;
+
+	h->pos     = get_mem(size, sizeof(int));
+	h->handles = get_mem(size, sizeof(int));
+	for (i = 0; i < size; i++) {
+		h->pos[i] = -1;
+	}
+
+	return (t_gen)h;
+}
+
+/*! @brief  
+ *  Address of elem at idx when the array holds elems inline
+ *  @param h    - Pointer to instance of heap 
+ *  @param idx  - Index in the array
+ *  @return     - Pointer to the elem
+ * */
+static inline t_gen heap_slot(t_heap *h, int idx)
+{
+	return (char*)h->data + (size_t)idx * h->elem_size;
+}
+
+/*! @brief  
+ *  Compare elems at two idx, inline elems are compared in place
+ *  with cmpr, else through the idx routine of the data type
+ *  @param h    - Pointer to instance of heap 
+ *  @return     - Compare result of elem at idx1 vs idx2
+ * */
+static inline e_cmpr heap_cmpr_at(t_heap *h, int idx1, int idx2)
+{
+	if (h->elem_size == 0) {
+		return h->cmpr_idx(h->data, idx1, idx2);
+	}
+	return h->cmpr(heap_slot(h, idx1), heap_slot(h, idx2));
+}
+
+/*! @brief  
+ *  Swap elems at two idx of heap array
+ *  @param h    - Pointer to instance of heap 
+ *  @return     - NA
+ * */
+static inline void heap_swap_at(t_heap *h, int idx1, int idx2)
+{
+	int tmp;
+
+	if (h->elem_size == 0) {
+		h->swap_idx(h->data, idx1, idx2);
+	} else {
+		swap_bytes(heap_slot(h, idx1), heap_slot(h, idx2), h->elem_size);
+	}
+
+	// handles move with their elems
+	if (h->pos != NULL) {
+		tmp = h->handles[idx1];
+		h->handles[idx1] = h->handles[idx2];
+		h->handles[idx2] = tmp;
+		h->pos[h->handles[idx1]] = idx1;
+		h->pos[h->handles[idx2]] = idx2;
+	}
+}
+
+/*! @brief  
+ *  Copy data to idx of heap array
+ *  @param h    - Pointer to instance of heap 
+ *  @param idx  - Index in the array
+ *  @param data - Pointer to the data
+ *  @return     - NA
+ * */
+static inline void heap_copy_at(t_heap *h, int idx, t_gen data)
+{
+	if (h->elem_size == 0) {
+		h->copy_idx(h->data, idx, data);
+	} else {
+		memcpy(heap_slot(h, idx), data, h->elem_size);
+	}
+}
+
+/*! @brief  
+ *  Get elem at idx of heap array
+ *  @param h    - Pointer to instance of heap 
+ *  @param idx  - Index in the array
+ *  @return     - Pointer to the elem
+ * */
+static inline t_gen heap_get_at(t_heap *h, int idx)
+{
+	if (h->elem_size == 0) {
+		return h->get_idx(h->data, idx);
+	}
+	return heap_slot(h, idx);
+}
+
 
 /*! @brief  
  *  To check if heap full
@@ -97,20 +242,75 @@ void heapify_up(t_heap *h, int idx)
 	int parent;
 	e_cmpr cmp_res;
 	// exit condition depending type of heap
-	cmp_res = (h->type == eMAX_HEAP)? eGREAT : eLESS;
+	cmp_res = (h->max == true)? eGREAT : eLESS;
 
-	for (parent = (idx - 1) / 2; idx; parent = (idx - 1) / 2) {
+	for (parent = (idx - 1) / h->arity; idx; parent = (idx - 1) / h->arity) {
 		// Heap prop satisfied parent </> child for min/max heap
 		// else swap parent and child and go one up
-		if (h->cmpr_idx(h->data, parent, idx) == cmp_res) {
+		if (heap_cmpr_at(h, parent, idx) == cmp_res) {
 			break;
 		} else {
-			h->swap_idx(h->data, parent, idx);
+			heap_swap_at(h, parent, idx);
 		}
 		idx = parent;
 	}
 }
 
+/*! @brief  
+ *  Move the heap to a new array of given size, the array given at
+ *  create is left as is and the heap owns the new one from then on
+ *  @param h    - Pointer to instance of heap 
+ *  @param size - New size of heap, not less than count
+ *  @return 	- NA
+ * */
+static void heap_resize(t_heap *h, int size)
+{
+	t_gen data = get_mem(size, h->elem_size);
+	int *pos, *handles;
+	int i;
+
+	memcpy(data, h->data, (size_t)h->count * h->elem_size);
+	if (h->own_data) {
+		free_mem(h->data);
+	}
+	h->data = data;
+	h->own_data = true;
+
+	// handles are bound by size, new ones start out of heap
+	if (h->pos != NULL) {
+		pos     = get_mem(size, sizeof(int));
+		handles = get_mem(size, sizeof(int));
+		for (i = 0; i < size; i++) {
+			pos[i] = (i < h->size)? h->pos[i] : -1;
+		}
+		memcpy(handles, h->handles, (size_t)h->count * sizeof(int));
+		free_mem(h->pos);
+		free_mem(h->handles);
+		h->pos     = pos;
+		h->handles = handles;
+	}
+	h->size = size;
+}
+
+/*! @brief  
+ *  Make room for one more elem, doubles the size if full and auto
+ *  grow is set, n inserts cost O(n) copies in total
+ *  @param h    - Pointer to instance of heap 
+ *  @return 	- true if there is room for an elem
+ * */
+static bool heap_grow(t_heap *h)
+{
+	if (h->count < h->size) {
+		return true;
+	}
+	if (h->auto_grow == false) {
+		return false;
+	}
+
+	heap_resize(h, (h->size > 0)? 2 * h->size : 1);
+	return true;
+}
+
 /*! @brief  
  *  Insert an element to heap
  *  @param d    - Pointer to instance of heap 
@@ -121,16 +321,59 @@ void heap_insert(t_gen d,t_gen data)
 {
 	t_heap *h = (t_heap*)d;
 
-	if (h->count >= h->size) {
+	if (h->pos != NULL) {
+		LOG_WARN("HEAP", "%s: indexed heap, insert with handle\n",h->name);
+		return;
+	}
+
+	if (heap_grow(h) == false) {
 		LOG_WARN("HEAP", "%s: HEAP_FULL\n",h->name);
 		return;
 	}
 	
-	h->copy_idx(h->data, h->count, data);
+	heap_copy_at(h, h->count, data);
 	heapify_up(h, h->count);
 	h->count++;
 }
 
+/*! @brief  
+ *  Rearrange a d-ary heap to maintain the heap property, the children
+ *  of idx are the arity elems from arity * idx + 1 on
+ *  @param h    - Pointer to instance of heap 
+ *  @param idx  - Index of node to heapify
+ *  @return 	- NA
+ */
+static void heapify_dary(t_heap *h, int idx)
+{
+	int best, child, first, last;
+	e_cmpr cmp_res;
+
+	// exit condition depending type of heap
+	cmp_res = (h->max != true)? eGREAT : eLESS;
+	for (;;) {
+		first = h->arity * idx + 1;
+		if (first >= h->count) {
+			break;
+		}
+		last = (first + h->arity < h->count)? first + h->arity : h->count;
+
+		// Pick the min/max of the children
+		best = first;
+		for (child = first + 1; child < last; child++) {
+			if (heap_cmpr_at(h, best, child) == cmp_res) {
+				best = child;
+			}
+		}
+
+		// Heap prop satisfied parent </> children for min/max heap
+		if (heap_cmpr_at(h, idx, best) != cmp_res) {
+			break;
+		}
+		heap_swap_at(h, idx, best);
+		idx = best;
+	}
+}
+
 /*! @brief  
  *  Rearrange a heap to maintain the heap property 
  *  aka heapyfy_down
@@ -142,26 +385,29 @@ void heapify(t_heap *h, int idx)
 {
 	int parent,lchild,rchild;
 	e_cmpr cmp_res;
+
+	if (h->arity != 2) {
+		heapify_dary(h, idx);
+		return;
+	}
 	
 	// exit condition depending type of heap
-	cmp_res = (h->type != eMAX_HEAP)? eGREAT : eLESS;
+	cmp_res = (h->max != true)? eGREAT : eLESS;
 	lchild = rchild = 0;
 	for (parent = idx; rchild <= h->count; ) {
 		lchild = (2 * idx)+1; rchild = (2 * parent) + 2;
 		// Heap prop satisfied parent </> child for min/max heap
 		// else parent and child and go one up
-		if (lchild < h->count && h->cmpr_idx
-				(h->data, parent, lchild) == cmp_res) {
+		if (lchild < h->count && heap_cmpr_at(h, parent, lchild) == cmp_res) {
 			parent = lchild;
 		}
-		if (rchild < h->count && h->cmpr_idx
-				(h->data, parent, rchild) == cmp_res) {
+		if (rchild < h->count && heap_cmpr_at(h, parent, rchild) == cmp_res) {
 			parent = rchild;
 		}
 	
 		// if parent has changed swap parent with idx
 		if (idx != parent) {
-			h->swap_idx(h->data, parent, idx);
+			heap_swap_at(h, parent, idx);
 			idx = parent;
 		} else {
 			break;
@@ -170,7 +416,8 @@ void heapify(t_heap *h, int idx)
 }
 
 /*! @brief  
- *  Build a heap given a array
+ *  Build a heap given a array, all size elems of the user array or
+ *  the count elems held once the heap owns its array after a resize
  *  @param d    - Pointer to instance of heap 
  *  @return 	- NA
  */
@@ -179,8 +426,11 @@ void heap_build(t_gen d)
 	t_heap *h = (t_heap*)d;
 	int idx;
 	
-	h->count = h->size;
-	for(idx = h->size/2; idx >= 0; idx--) {
+	// slots past count of an array grown by the heap hold no elems
+	if (h->own_data == false) {
+		h->count = h->size;
+	}
+	for(idx = h->count / h->arity; idx >= 0; idx--) {
 		heapify(h, idx);
 	}
 }
@@ -200,23 +450,35 @@ t_gen heap_extract_root(t_gen d)
 		LOG_WARN("HEAP", "%s: HEAP EMPTY\n",h->name);
 		return data;
 	}
+
+	// Halve on low occupancy before the root slot is handed out,
+	// an indexed heap keeps its size as live handles are bound by it
+	if (h->shrink_div > 0 && h->pos == NULL && h->size / 2 >= h->min_size &&
+			h->count <= h->size / h->shrink_div) {
+		heap_resize(h, h->size / 2);
+	}
 	
 	// Root is swapped with last node in heap
 	// temp store root at last heap location
 	h->count--;
-	h->swap_idx(h->data, 0, h->count);
+	heap_swap_at(h, 0, h->count);
 
 	// heapify to preserve heap prop
 	heapify(h, 0);
+
+	// handle of previous root is out of heap
+	if (h->pos != NULL) {
+		h->pos[h->handles[h->count]] = -1;
+	}
 	
 	//Ref to previous heap root is returned
-	data = h->get_idx(h->data, h->count);
+	data = heap_get_at(h, h->count);
 	
 	return data;
 }
 
 /*! @brief  
- *  Heap sort the data
+ *  Heap sort the data, the elems build takes @see heap_build
  *  @param d    - Pointer to instance of heap 
  *  @return 	- NA
  */
@@ -233,7 +495,7 @@ void heap_sort(t_gen d)
 	for(;h->count;) {
 		// Root to be deleted is swapped with last node in heap
 		h->count--;
-		h->swap_idx(h->data, 0, h->count);
+		heap_swap_at(h, 0, h->count);
 		// heapify to preserve heap prop
 		heapify(h, 0);
 	}
@@ -259,23 +521,77 @@ t_gen heap_update_key(t_gen d, t_gen val, int idx)
 	}
 
 	// exit condition depending type of heap
-	cmp_res = (h->type != eMAX_HEAP)? eGREAT : eLESS;
-	tmp = h->get_idx(h->data, idx);
+	cmp_res = (h->max != true)? eGREAT : eLESS;
+	tmp = heap_get_at(h, idx);
 	
 	// If new val '<'/'>' previous val or min/max heap
 	// then heapify up else heapify down
 	if (h->cmpr(tmp, val) == cmp_res) {
-		h->copy_idx(h->data, idx, val);
+		heap_copy_at(h, idx, val);
 		heapify_up(h, idx);
 	}
 	else {
-		h->copy_idx(h->data, idx, val);
+		heap_copy_at(h, idx, val);
 		heapify(h, idx);
 	}
 
 	return tmp;
 }
 
+/*! @brief  
+ *  Insert an element known by a handle to indexed heap
+ *  @param d      - Pointer to instance of heap 
+ *  @param handle - Handle of elem, 0 to heap size - 1
+ *  @param val    - Pointer to data that has to be added to heap
+ *  @return 	  - true if added, false if handle invalid or already in heap
+ */
+bool heap_insert_handle(t_gen d, int handle, t_gen val)
+{
+	t_heap *h = (t_heap*)d;
+
+	// grow till the handle is in bounds
+	while (h->pos != NULL && h->auto_grow && handle >= h->size) {
+		heap_resize(h, (h->size > 0)? 2 * h->size : 1);
+	}
+
+	if (h->pos == NULL || handle < 0 || handle >= h->size || h->pos[handle] != -1) {
+		LOG_WARN("HEAP", "%s: invalid handle %d\n",h->name, handle);
+		return false;
+	}
+
+	heap_copy_at(h, h->count, val);
+	h->handles[h->count] = handle;
+	h->pos[handle] = h->count;
+	heapify_up(h, h->count);
+	h->count++;
+
+	return true;
+}
+
+/*! @brief  
+ *  Change key of an element in indexed heap to one closer to root
+ *  (lower for min heap, higher for max heap) in O(log n), the elem
+ *  may have been modified in place before the call
+ *  @param d      - Pointer to instance of heap 
+ *  @param handle - Handle of elem
+ *  @param val    - Pointer of value to be copied to the heap node of handle
+ *  @return 	  - true if updated, false if handle not in heap
+ */
+bool heap_decrease_key(t_gen d, int handle, t_gen val)
+{
+	t_heap *h = (t_heap*)d;
+
+	if (h->pos == NULL || handle < 0 || handle >= h->size || h->pos[handle] == -1) {
+		LOG_WARN("HEAP", "%s: handle %d not in heap\n",h->name, handle);
+		return false;
+	}
+
+	heap_copy_at(h, h->pos[handle], val);
+	heapify_up(h, h->pos[handle]);
+
+	return true;
+}
+
 /*! @brief  
  *  heap count
  *  @param d    - Pointer to instance of heap 
@@ -294,6 +610,15 @@ int heap_len(t_gen h)
 void destroy_heap(t_gen d)
 {
 	t_heap *h = (t_heap*)d;
+
+	if (h->pos != NULL) {
+		free_mem(h->pos);
+		free_mem(h->handles);
+	}
+
+	if (h->own_data) {
+		free_mem(h->data);
+	}
 	
 	free_mem(h);
 }
@@ -310,6 +635,14 @@ char * get_heaptype_name(e_heaptype type)
 			return "MIN_HEAP";
 		case eMAX_HEAP:
 			return "MAX_HEAP";
+		case eMIN_HEAP4:
+			return "MIN_HEAP4";
+		case eMAX_HEAP4:
+			return "MAX_HEAP4";
+		case eMIN_HEAP8:
+			return "MIN_HEAP8";
+		case eMAX_HEAP8:
+			return "MAX_HEAP8";
 	}
 
 	return "UNDEFINED";
@@ -327,8 +660,756 @@ void heap_print(t_gen d)
 	printf("%s:%s {count: %d} {size: %d}\n[ ",h->name, 
 			get_heaptype_name(h->type), h->count, h->size);
 	for (i = 0; i < h->size; i ++) {
-		h->print_data(h->get_idx(h->data, i));
+		h->print_data(heap_get_at(h, i));
 		printf(" ");
 	}
 	printf("]\n");
 }
+
+/*! @brief  
+ *  Create an instance of radix heap
+ *  @param name     - Name of radix heap instance
+ *  @param size     - Max elems of heap, handles are 0 to size - 1
+ *  @return         - Pointer to instance of radix heap
+*/
+t_gen create_radix_heap(char *name, int size)
+{
+	t_radix_heap *h = get_mem(1, sizeof(t_radix_heap));
+	int i;
+
+	// Initailze radix heap Params
+	h->name   = name;
+	h->size   = size;
+	h->count  = 0;
+	h->last   = 0;
+	h->keys   = get_mem(size, sizeof(unsigned int));
+	h->next   = get_mem(size, sizeof(int));
+	h->prev   = get_mem(size, sizeof(int));
+	h->bucket = get_mem(size, sizeof(int));
+	for (i = 0; i < RADIX_BUCKETS; i++) {
+		h->head[i] = -1;
+	}
+	for (i = 0; i < size; i++) {
+		h->bucket[i] = -1;
+	}
+
+	// Initailze radix heap routines
+	h->insert       = radix_heap_insert;
+	h->decrease_key = radix_heap_decrease_key;
+	h->extract      = radix_heap_extract;
+	h->len          = radix_heap_len;
+	h->empty        = radix_heap_empty;
+	h->destroy      = destroy_radix_heap;
+
+	return (t_gen)h;
+}
+
+/*! @brief  
+ *  Bucket of a key, the highest bit the key differs from last
+ *  @param h    - Pointer to instance of radix heap 
+ *  @param key  - Key
+ *  @return     - Bucket idx, 0 if key is last
+ * */
+static inline int radix_bucket_of(t_radix_heap *h, unsigned int key)
+{
+	return (key == h->last)? 0 : 32 - __builtin_clz(key ^ h->last);
+}
+
+/*! @brief  
+ *  Add handle at head of list of a bucket
+ *  @param h      - Pointer to instance of radix heap 
+ *  @param handle - Handle of elem
+ *  @param b      - Bucket idx
+ *  @return       - NA
+ * */
+static inline void radix_link(t_radix_heap *h, int handle, int b)
+{
+	h->bucket[handle] = b;
+	h->prev[handle] = -1;
+	h->next[handle] = h->head[b];
+	if (h->head[b] != -1) {
+		h->prev[h->head[b]] = handle;
+	}
+	h->head[b] = handle;
+}
+
+/*! @brief  
+ *  Remove handle from list of its bucket
+ *  @param h      - Pointer to instance of radix heap 
+ *  @param handle - Handle of elem
+ *  @return       - NA
+ * */
+static inline void radix_unlink(t_radix_heap *h, int handle)
+{
+	if (h->prev[handle] != -1) {
+		h->next[h->prev[handle]] = h->next[handle];
+	} else {
+		h->head[h->bucket[handle]] = h->next[handle];
+	}
+	if (h->next[handle] != -1) {
+		h->prev[h->next[handle]] = h->prev[handle];
+	}
+	h->bucket[handle] = -1;
+}
+
+/*! @brief  
+ *  Insert an elem known by a handle to radix heap
+ *  @param d      - Pointer to instance of radix heap 
+ *  @param handle - Handle of elem, 0 to heap size - 1
+ *  @param key    - Key of elem, not less than the last extracted key
+ *  @return 	  - true if added, false if handle/key invalid or already in heap
+ */
+bool radix_heap_insert(t_gen d, int handle, unsigned int key)
+{
+	t_radix_heap *h = (t_radix_heap*)d;
+
+	if (handle < 0 || handle >= h->size || h->bucket[handle] != -1 || key < h->last) {
+		LOG_WARN("HEAP", "%s: invalid handle %d or key %u\n",h->name, handle, key);
+		return false;
+	}
+
+	h->keys[handle] = key;
+	radix_link(h, handle, radix_bucket_of(h, key));
+	h->count++;
+
+	return true;
+}
+
+/*! @brief  
+ *  Lower the key of an elem in radix heap, the elem moves to the
+ *  bucket of its new key in O(1)
+ *  @param d      - Pointer to instance of radix heap 
+ *  @param handle - Handle of elem
+ *  @param key    - New key, not less than the last extracted key
+ *  @return 	  - true if updated, false if handle not in heap or key invalid
+ */
+bool radix_heap_decrease_key(t_gen d, int handle, unsigned int key)
+{
+	t_radix_heap *h = (t_radix_heap*)d;
+
+	if (handle < 0 || handle >= h->size || h->bucket[handle] == -1 ||
+			key < h->last || key > h->keys[handle]) {
+		LOG_WARN("HEAP", "%s: handle %d not in heap or key %u invalid\n",h->name, handle, key);
+		return false;
+	}
+
+	radix_unlink(h, handle);
+	h->keys[handle] = key;
+	radix_link(h, handle, radix_bucket_of(h, key));
+
+	return true;
+}
+
+/*! @brief  
+ *  Extract the elem with min key from radix heap, when bucket 0 is
+ *  empty the min of the first non empty bucket becomes last and the
+ *  elems of that bucket are spread over the lower buckets
+ *  @param d    - Pointer to instance of radix heap 
+ *  @param key  - Pointer to get the key of extracted elem (can be NULL)
+ *  @return 	- Handle of extracted elem, -1 if heap empty
+ */
+int radix_heap_extract(t_gen d, unsigned int *key)
+{
+	t_radix_heap *h = (t_radix_heap*)d;
+	int b, handle, nxt;
+
+	if (h->count == 0) {
+		LOG_WARN("HEAP", "%s: HEAP EMPTY\n",h->name);
+		return -1;
+	}
+
+	if (h->head[0] == -1) {
+		// First non empty bucket and its min key
+		for (b = 1; h->head[b] == -1; b++);
+		h->last = h->keys[h->head[b]];
+		for (handle = h->head[b]; handle != -1; handle = h->next[handle]) {
+			if (h->keys[handle] < h->last) {
+				h->last = h->keys[handle];
+			}
+		}
+
+		// Spread bucket on the new last, all go to lower buckets
+		for (handle = h->head[b], h->head[b] = -1; handle != -1; handle = nxt) {
+			nxt = h->next[handle];
+			radix_link(h, handle, radix_bucket_of(h, h->keys[handle]));
+		}
+	}
+
+	handle = h->head[0];
+	radix_unlink(h, handle);
+	h->count--;
+	if (key != NULL) {
+		*key = h->keys[handle];
+	}
+
+	return handle;
+}
+
+/*! @brief  
+ *  radix heap count
+ *  @param d    - Pointer to instance of radix heap 
+ *  @return 	- radix heap length
+ */
+int radix_heap_len(t_gen d)
+{
+	return ((t_radix_heap*)d)->count;
+}
+
+/*! @brief  
+ *  To check if radix heap empty
+ *  @param d    - Pointer to instance of radix heap 
+ *  @return     - true if radix heap empty
+ * */
+bool radix_heap_empty(t_gen d)
+{
+	return ((t_radix_heap*)d)->count == 0;
+}
+
+/*! @brief  
+ *  Destroy the instance of the radix heap
+ *  @param d    - Pointer to instance of radix heap 
+ *  @return 	- NA
+ */
+void destroy_radix_heap(t_gen d)
+{
+	t_radix_heap *h = (t_radix_heap*)d;
+
+	free_mem(h->keys);
+	free_mem(h->next);
+	free_mem(h->prev);
+	free_mem(h->bucket);
+	free_mem(h);
+}
+
+/*! @brief  
+ *  Create an instance of pairing heap
+ *  @param name     - Name of pairing heap instance
+ *  @param htype    - Type of heap, max types give a max heap else min
+ *  @param prm      - Data type specific parameters (cmpr, elem_size)
+ *  @return         - Pointer to instance of pairing heap
+*/
+t_gen create_pairing_heap(char *name, e_heaptype htype, t_dparams *prm)
+{
+	t_pairing_heap *h = get_mem(1, sizeof(t_pairing_heap));
+
+	// Initailze pairing heap Params
+	h->name      = name;
+	h->type      = htype;
+	h->max       = (htype == eMAX_HEAP || htype == eMAX_HEAP4 || htype == eMAX_HEAP8);
+	h->elem_size = prm->elem_size;
+	h->count     = 0;
+	h->root      = NULL;
+	h->free_list = NULL;
+	h->free_tail = NULL;
+	h->pool      = create_arena(name, 0);
+
+	// Initailze pairing heap routines
+	h->insert       = pairing_heap_insert;
+	h->extract      = pairing_heap_extract;
+	h->peek         = pairing_heap_peek;
+	h->meld         = pairing_heap_meld;
+	h->decrease_key = pairing_heap_decrease_key;
+	h->len          = pairing_heap_len;
+	h->empty        = pairing_heap_empty;
+	h->destroy      = destroy_pairing_heap;
+
+	// Initailze datatype based operations
+	h->cmpr       = prm->cmpr;
+	h->print_data = prm->print_data;
+
+	return (t_gen)h;
+}
+
+/*! @brief  
+ *  Make the node whose elem is further from root the first child of
+ *  the other, ties keep a as parent
+ *  @param h    - Pointer to instance of pairing heap 
+ *  @param a    - Root of a tree
+ *  @param b    - Root of another tree
+ *  @return     - Root of linked tree (sibling and prev left to caller)
+ * */
+static inline t_pairing_node *pairing_link(t_pairing_heap *h, t_pairing_node *a, t_pairing_node *b)
+{
+	t_pairing_node *tmp;
+	e_cmpr res = h->cmpr(a->data, b->data);
+
+	if ((h->max == true)? res == eLESS : res == eGREAT) {
+		tmp = a;
+		a = b;
+		b = tmp;
+	}
+
+	b->prev = a;
+	b->sibling = a->child;
+	if (a->child != NULL) {
+		a->child->prev = b;
+	}
+	a->child = b;
+
+	return a;
+}
+
+/*! @brief  
+ *  Two pass pairing of a sibling list into one tree, link pairs left
+ *  to right then link the results right to left
+ *  @param h     - Pointer to instance of pairing heap 
+ *  @param first - First node of sibling list
+ *  @return      - Root of the tree, NULL if list empty
+ * */
+static t_pairing_node *pairing_merge_pairs(t_pairing_heap *h, t_pairing_node *first)
+{
+	t_pairing_node *a, *b, *nxt, *pairs = NULL, *root;
+
+	// first pass, linked pairs are stacked on pairs by sibling
+	while (first != NULL) {
+		a = first;
+		b = a->sibling;
+		if (b == NULL) {
+			a->sibling = pairs;
+			pairs = a;
+			break;
+		}
+		nxt = b->sibling;
+		a = pairing_link(h, a, b);
+		a->sibling = pairs;
+		pairs = a;
+		first = nxt;
+	}
+
+	if (pairs == NULL) {
+		return NULL;
+	}
+
+	// second pass, last pair first
+	root = pairs;
+	pairs = root->sibling;
+	while (pairs != NULL) {
+		nxt = pairs->sibling;
+		root = pairing_link(h, root, pairs);
+		pairs = nxt;
+	}
+	root->sibling = NULL;
+	root->prev = NULL;
+
+	return root;
+}
+
+/*! @brief  
+ *  Insert an elem to pairing heap in O(1)
+ *  @param d    - Pointer to instance of pairing heap 
+ *  @param data - Pointer to data, copied in node if elems are inline
+ *  @return     - Node of the elem, the handle for decrease key
+ * */
+t_gen pairing_heap_insert(t_gen d, t_gen data)
+{
+	t_pairing_heap *h = (t_pairing_heap*)d;
+	t_pairing_node *node;
+
+	// reuse an extracted node else take one from the pool
+	if (h->free_list != NULL) {
+		node = h->free_list;
+		h->free_list = node->sibling;
+		if (h->free_list == NULL) {
+			h->free_tail = NULL;
+		}
+	} else {
+		node = arena_alloc(h->pool, 1, sizeof(t_pairing_node) + h->elem_size);
+		if (node == NULL) {
+			return NULL;
+		}
+	}
+
+	node->child = NULL;
+	node->sibling = NULL;
+	node->prev = NULL;
+	if (h->elem_size != 0) {
+		node->data = (char*)node + sizeof(t_pairing_node);
+		memcpy(node->data, data, h->elem_size);
+	} else {
+		node->data = data;
+	}
+
+	h->root = (h->root == NULL)? node : pairing_link(h, h->root, node);
+	h->root->sibling = NULL;
+	h->root->prev = NULL;
+	h->count++;
+
+	return (t_gen)node;
+}
+
+/*! @brief  
+ *  Extract the root from pairing heap, O(log n) amortised
+ *  @param d    - Pointer to instance of pairing heap 
+ *  @return 	- Pointer to extracted elem, an inline elem is valid
+ *  		  till the next insert
+ */
+t_gen pairing_heap_extract(t_gen d)
+{
+	t_pairing_heap *h = (t_pairing_heap*)d;
+	t_pairing_node *root = h->root;
+
+	if (root == NULL) {
+		LOG_WARN("HEAP", "%s: HEAP EMPTY\n",h->name);
+		return NULL;
+	}
+
+	h->root = pairing_merge_pairs(h, root->child);
+	h->count--;
+
+	// node back to pool
+	root->sibling = h->free_list;
+	h->free_list = root;
+	if (root->sibling == NULL) {
+		h->free_tail = root;
+	}
+
+	return root->data;
+}
+
+/*! @brief  
+ *  Root elem of pairing heap
+ *  @param d    - Pointer to instance of pairing heap 
+ *  @return 	- Pointer to root elem, NULL if empty
+ */
+t_gen pairing_heap_peek(t_gen d)
+{
+	t_pairing_heap *h = (t_pairing_heap*)d;
+
+	return (h->root != NULL)? h->root->data : NULL;
+}
+
+/*! @brief  
+ *  Move all elems of other pairing heap to this one in O(1), nodes of
+ *  other stay valid handles in this heap and other is left empty
+ *  @param d     - Pointer to instance of pairing heap 
+ *  @param other - Pointer to pairing heap of same type and data
+ *  @return 	 - NA
+ */
+void pairing_heap_meld(t_gen d, t_gen other)
+{
+	t_pairing_heap *h = (t_pairing_heap*)d;
+	t_pairing_heap *o = (t_pairing_heap*)other;
+
+	if (h == o || h->max != o->max || h->elem_size != o->elem_size) {
+		LOG_WARN("HEAP", "%s: can not meld %s\n",h->name, o->name);
+		return;
+	}
+
+	if (o->root != NULL) {
+		h->root = (h->root == NULL)? o->root : pairing_link(h, h->root, o->root);
+		h->root->sibling = NULL;
+		h->root->prev = NULL;
+		h->count += o->count;
+	}
+
+	// nodes of other now live in this pool, its free nodes go
+	// after the free nodes here
+	arena_merge(h->pool, o->pool);
+	if (o->free_list != NULL) {
+		if (h->free_list == NULL) {
+			h->free_list = o->free_list;
+		} else {
+			h->free_tail->sibling = o->free_list;
+		}
+		h->free_tail = o->free_tail;
+	}
+
+	o->root = NULL;
+	o->free_list = NULL;
+	o->free_tail = NULL;
+	o->count = 0;
+}
+
+/*! @brief  
+ *  Change key of an elem to one closer to root (lower for min heap,
+ *  higher for max heap) in O(1), the node is cut from its parent
+ *  and linked with the root
+ *  @param d    - Pointer to instance of pairing heap 
+ *  @param node - Node of elem returned by insert
+ *  @param val  - Pointer to new data of elem, NULL if it was modified in place
+ *  @return 	- true if updated
+ */
+bool pairing_heap_decrease_key(t_gen d, t_gen node, t_gen val)
+{
+	t_pairing_heap *h = (t_pairing_heap*)d;
+	t_pairing_node *n = (t_pairing_node*)node;
+
+	if (n == NULL || h->root == NULL) {
+		LOG_WARN("HEAP", "%s: node not in heap\n",h->name);
+		return false;
+	}
+
+	if (val != NULL) {
+		if (h->elem_size != 0) {
+			memcpy(n->data, val, h->elem_size);
+		} else {
+			n->data = val;
+		}
+	}
+
+	if (n == h->root) {
+		return true;
+	}
+
+	// cut subtree of node from parent or previous sibling
+	if (n->prev->child == n) {
+		n->prev->child = n->sibling;
+	} else {
+		n->prev->sibling = n->sibling;
+	}
+	if (n->sibling != NULL) {
+		n->sibling->prev = n->prev;
+	}
+	n->sibling = NULL;
+	n->prev = NULL;
+
+	h->root = pairing_link(h, h->root, n);
+
+	return true;
+}
+
+/*! @brief  
+ *  pairing heap count
+ *  @param d    - Pointer to instance of pairing heap 
+ *  @return 	- heap length
+ */
+int pairing_heap_len(t_gen d)
+{
+	return ((t_pairing_heap*)d)->count;
+}
+
+/*! @brief  
+ *  To check if pairing heap empty
+ *  @param d    - Pointer to instance of pairing heap 
+ *  @return     - true if pairing heap empty
+ * */
+bool pairing_heap_empty(t_gen d)
+{
+	return ((t_pairing_heap*)d)->count == 0;
+}
+
+/*! @brief  
+ *  Destroy the instance of the pairing heap, all nodes are released
+ *  with the pool, elems pointed to are left to the user
+ *  @param d    - Pointer to instance of pairing heap 
+ *  @return 	- NA
+ */
+void destroy_pairing_heap(t_gen d)
+{
+	t_pairing_heap *h = (t_pairing_heap*)d;
+
+	destroy_arena(h->pool);
+	free_mem(h);
+}
+
+/*! @brief  
+ *  Move the k greatest elems of an array to its start, greatest first,
+ *  with a min heap of k elems in place, O(n log k) and no allocs bar
+ *  the heap instance, the rest of the array is left unordered
+ *  @param a    - Pointer to array
+ *  @param n    - size of array
+ *  @param k    - Elems to select
+ *  @param prm  - Data type specific params (idx routines, or cmpr if elem_size)
+ *  @return     - Elems selected, k clipped to n
+ * */
+int heap_top_k(t_gen a, int n, int k, t_dparams *prm)
+{
+	t_heap *h;
+	int i;
+
+	k = (k < n)? k : n;
+	if (k <= 0) {
+		return 0;
+	}
+
+	// root of min heap over a[0 .. k-1] is the kth greatest so far,
+	// an elem greater than it takes its place
+	h = create_heap("top k", a, k, eMIN_HEAP, prm);
+	h->build(h);
+	for (i = k; i < n; i++) {
+		if (heap_cmpr_at(h, i, 0) == eGREAT) {
+			heap_swap_at(h, 0, i);
+			heapify(h, 0);
+		}
+	}
+
+	// heap sort of a min heap leaves the greatest first
+	h->sort(h);
+	h->destroy(h);
+
+	return k;
+}
+
+/*! @brief  
+ *  Create an instance of streaming top k
+ *  @param name     - Name of top k instance
+ *  @param k        - Elems to keep
+ *  @param prm      - Data type specific parameters (cmpr, elem_size)
+ *  @return         - Pointer to instance of top k
+*/
+t_gen create_top_k(char *name, int k, t_dparams *prm)
+{
+	t_top_k *t = get_mem(1, sizeof(t_top_k));
+
+	// Initailze top k Params
+	t->name      = name;
+	t->k         = k;
+	t->count     = 0;
+	t->elem_size = prm->elem_size;
+	t->slot_size = (prm->elem_size != 0)? prm->elem_size : sizeof(t_gen);
+	t->data      = get_mem(k, t->slot_size);
+	t->tmp       = get_mem(1, t->slot_size);
+
+	// Initailze top k routines
+	t->add       = top_k_add;
+	t->threshold = top_k_threshold;
+	t->result    = top_k_result;
+	t->len       = top_k_len;
+	t->destroy   = destroy_top_k;
+
+	t->cmpr      = prm->cmpr;
+
+	return (t_gen)t;
+}
+
+/*! @brief  
+ *  Elem of a slot, the slot itself if inline else the ptr held
+ *  @param t    - Pointer to instance of top k 
+ *  @param slot - Pointer to slot
+ *  @return     - Pointer to elem
+ * */
+static inline t_gen top_k_elem(t_top_k *t, char *slot)
+{
+	return (t->elem_size != 0)? (t_gen)slot : *(t_gen*)slot;
+}
+
+/*! @brief  
+ *  Place the slot value src at idx of a min heap of n slots, moving
+ *  the lesser child up till src is not greater than it
+ *  @param t    - Pointer to instance of top k 
+ *  @param arr  - Slots of heap
+ *  @param n    - Slots in heap
+ *  @param idx  - Idx of the hole
+ *  @param src  - Slot value to place (not in arr[idx + 1 .. n-1])
+ *  @return     - NA
+ * */
+static void top_k_sift_down(t_top_k *t, char *arr, int n, int idx, char *src)
+{
+	size_t sz = t->slot_size;
+	int child;
+
+	for (child = 2 * idx + 1; child < n; child = 2 * idx + 1) {
+		if (child + 1 < n && t->cmpr(top_k_elem(t, arr + (child + 1) * sz),
+					top_k_elem(t, arr + child * sz)) == eLESS) {
+			child++;
+		}
+		if (t->cmpr(top_k_elem(t, arr + child * sz), top_k_elem(t, src)) != eLESS) {
+			break;
+		}
+		memcpy(arr + idx * sz, arr + child * sz, sz);
+		idx = child;
+	}
+	memcpy(arr + idx * sz, src, sz);
+}
+
+/*! @brief  
+ *  Offer an elem to top k, O(1) if rejected else O(log k)
+ *  @param d    - Pointer to instance of top k 
+ *  @param data - Pointer to data, copied if elems are inline
+ *  @return     - true if kept, false if not greater than the kth greatest
+ * */
+bool top_k_add(t_gen d, t_gen data)
+{
+	t_top_k *t = (t_top_k*)d;
+	size_t sz = t->slot_size;
+	char *src = (t->elem_size != 0)? (char*)data : (char*)&data;
+	int idx, parent;
+
+	if (t->count == t->k) {
+		// one compare with the kth greatest rejects most elems
+		if (t->k == 0 || t->cmpr(data, top_k_elem(t, t->data)) != eGREAT) {
+			return false;
+		}
+		top_k_sift_down(t, t->data, t->k, 0, src);
+		return true;
+	}
+
+	// not full, sift up from the end
+	for (idx = t->count; idx > 0; idx = parent) {
+		parent = (idx - 1) / 2;
+		if (t->cmpr(top_k_elem(t, t->data + parent * sz), data) != eGREAT) {
+			break;
+		}
+		memcpy(t->data + idx * sz, t->data + parent * sz, sz);
+	}
+	memcpy(t->data + idx * sz, src, sz);
+	t->count++;
+
+	return true;
+}
+
+/*! @brief  
+ *  Least of the held elems once k are held, an elem has to be
+ *  greater than it to be kept
+ *  @param d    - Pointer to instance of top k 
+ *  @return     - Pointer to kth greatest elem, NULL if less than k held
+ * */
+t_gen top_k_threshold(t_gen d)
+{
+	t_top_k *t = (t_top_k*)d;
+
+	return (t->count == t->k && t->k > 0)? top_k_elem(t, t->data) : NULL;
+}
+
+/*! @brief  
+ *  Held elems sorted greatest first, top k carries on as is
+ *  @param d    - Pointer to instance of top k 
+ *  @return     - Array of count slots (elems inline or data ptrs) to be
+ *  		  freed by the user, NULL if none held
+ * */
+t_gen top_k_result(t_gen d)
+{
+	t_top_k *t = (t_top_k*)d;
+	size_t sz = t->slot_size;
+	char *arr;
+	int n;
+
+	if (t->count == 0) {
+		return NULL;
+	}
+
+	// heap sort of a copy, the least goes last each round
+	arr = get_mem(t->count, sz);
+	memcpy(arr, t->data, t->count * sz);
+	for (n = t->count - 1; n > 0; n--) {
+		memcpy(t->tmp, arr + n * sz, sz);
+		memcpy(arr + n * sz, arr, sz);
+		top_k_sift_down(t, arr, n, 0, t->tmp);
+	}
+
+	return (t_gen)arr;
+}
+
+/*! @brief  
+ *  top k count
+ *  @param d    - Pointer to instance of top k 
+ *  @return 	- Count of held elems
+ */
+int top_k_len(t_gen d)
+{
+	return ((t_top_k*)d)->count;
+}
+
+/*! @brief  
+ *  Destroy the instance of the top k, elems pointed to are left to the user
+ *  @param d    - Pointer to instance of top k 
+ *  @return 	- NA
+ */
+void destroy_top_k(t_gen d)
+{
+	t_top_k *t = (t_top_k*)d;
+
+	free_mem(t->data);
+	free_mem(t->tmp);
+	free_mem(t);
+}
@@ -9,20 +9,36 @@
 typedef enum {
 	eMIN_HEAP,		///< Minimum Heap	
 	eMAX_HEAP,		///< Maximum Heap
+	eMIN_HEAP4,		///< Minimum Heap with 4 children per node
+	eMAX_HEAP4,		///< Maximum Heap with 4 children per node
+	eMIN_HEAP8,		///< Minimum Heap with 8 children per node
+	eMAX_HEAP8,		///< Maximum Heap with 8 children per node
 } e_heaptype;
 
 /// heapf update key fn defn
 typedef t_gen (*f_update)(t_gen d, t_gen val, int idx);
 
+/// heap fn defn for elems known by a handle (indexed heap)
+typedef bool (*f_handle)(t_gen d, int handle, t_gen val);
+
 /// Heap struct defn
 typedef struct heap {
 	// heap info params
 	char *name;		///< Stack instance name
 	int count;		///< Total elems present in heap
-	int size;		///< Max Size of heap
+	int size;		///< Max Size of heap (current capacity if auto grow)
+	int min_size;		///< Size given at create, capacity never shrinks below it
+	bool auto_grow;		///< Capacity doubles when full, amortised O(1) array cost per insert (inline elems only)
+	int shrink_div;		///< Capacity halves when count drops to size/shrink_div (0 never)
+	bool own_data;		///< data was allocated by the heap on a resize, the user array is no longer used
 	e_heaptype type;	///< Stack Type @see types of heap
+	int arity;		///< Children per node by type, 4/8 keep the children of a ptr heap in 1-2 cache lines
+	bool max;		///< Max heap by type else min heap
 	// data on which heap operates
 	t_gen *data;		///< Ptr to array based heap 
+	size_t elem_size;	///< Bytes of an elem if the array holds elems inline (0 uses idx routines)
+	int *pos;		///< Heap idx per handle, -1 if not in heap (indexed heap else NULL)
+	int *handles;		///< Handle per heap idx (indexed heap else NULL)
 	
 	// heap  roputines
 	f_ins insert;		///< routine to insert elements in heap 
@@ -30,6 +46,8 @@ typedef struct heap {
 	f_vgen build; 		///< routine to heapify
 	f_vgen sort;  		///< routine to heap sort 
 	f_update update;	///< routine to update a key of given heap node
+	f_handle insert_handle;	///< routine to insert an elem known by handle (indexed heap)
+	f_handle decrease_key;	///< routine to move elem of handle towards root on its new key (indexed heap)
 	f_len len;    		///< routine to get heap len
 	f_full full;		///< routine to check if heap full
 	f_empty empty;		///< routine to check if heap empty
@@ -45,5 +63,214 @@ typedef struct heap {
 	f_print print_data;
 } t_heap;
 
+#define RADIX_BUCKETS	33	///< Buckets of radix heap, one per bit of a 32 bit key and one for key == last
+
+/// radix heap fn defn to add or lower the key of elem known by handle
+typedef bool (*f_radix_key)(t_gen d, int handle, unsigned int key);
+/// radix heap fn defn to extract the min elem, gets its handle and key
+typedef int (*f_radix_extract)(t_gen d, unsigned int *key);
+
+/// Radix heap struct defn, a monotone min priority queue of unsigned keys,
+/// an extracted key is never more than a key inserted later (dijkstra dists).
+/// Bucket i > 0 holds the elems whose key differs from the last extracted key
+/// first at bit i - 1, so an elem moves down buckets at most 32 times.
+/// Elems are known by a handle in 0 to size - 1 and kept in per bucket lists
+typedef struct radix_heap {
+	// radix heap info params
+	char *name;			///< Radix heap instance name
+	int count;			///< Total elems present in heap
+	int size;			///< Max elems of heap and bound of handles
+	unsigned int last;		///< Last extracted key, lower bound of all keys in heap
+
+	// elems by handle
+	int head[RADIX_BUCKETS];	///< First handle per bucket, -1 if empty
+	unsigned int *keys;		///< Key per handle
+	int *next;			///< Next handle in bucket per handle
+	int *prev;			///< Prev handle in bucket per handle
+	int *bucket;			///< Bucket per handle, -1 if not in heap
+
+	// radix heap routines
+	f_radix_key insert;		///< routine to add elem of handle with key
+	f_radix_key decrease_key;	///< routine to lower the key of elem of handle
+	f_radix_extract extract;	///< routine to extract elem with min key
+	f_len len;			///< routine to get heap len
+	f_empty empty;			///< routine to check if heap empty
+	f_destroy destroy;		///< routine to destroy
+} t_radix_heap;
+
+/// Pairing heap node, a child list per node linked by sibling
+typedef struct pairing_node {
+	struct pairing_node *child;	///< First child
+	struct pairing_node *sibling;	///< Next sibling (next free node if in free list)
+	struct pairing_node *prev;	///< Parent if first child else previous sibling
+	t_gen data;			///< Elem ptr, points past the node if elem is inline
+} t_pairing_node;
+
+/// pairing heap fn defn to change the key of elem of a node (handle from insert)
+typedef bool (*f_pairing_key)(t_gen d, t_gen node, t_gen val);
+
+/// Pairing heap struct defn, a heap ordered tree of nodes with O(1) insert,
+/// meld and decrease key and O(log n) amortised extract. Insert returns the
+/// node of the elem, it is the handle for decrease key till the elem is
+/// extracted. Nodes come from a pool, an arena plus a list of extracted nodes
+typedef struct pairing_heap {
+	// pairing heap info params
+	char *name;			///< Pairing heap instance name
+	int count;			///< Total elems present in heap
+	e_heaptype type;		///< Heap Type, min or max by type (arity unused)
+	bool max;			///< Max heap by type else min heap
+	size_t elem_size;		///< Bytes of an elem if held inline in the node (0 holds data ptr)
+	t_pairing_node *root;		///< Root node, NULL if empty
+	t_pairing_node *free_list;	///< Extracted nodes for reuse
+	t_pairing_node *free_tail;	///< Last node of free list, lets meld splice free lists in O(1)
+	t_arena *pool;			///< Arena nodes are allocated from
+
+	// pairing heap routines
+	f_gen2 insert;			///< routine to insert elem, returns its node
+	f_gen extract;			///< routine to extract min/max root elem
+	f_gen peek;			///< routine to get root elem
+	f_vgen2 meld;			///< routine to move all elems of another pairing heap in
+	f_pairing_key decrease_key;	///< routine to move elem of node towards root on its new key
+	f_len len;			///< routine to get heap len
+	f_empty empty;			///< routine to check if heap empty
+	f_destroy destroy;		///< routine to destroy
+
+	// routines for operating on data
+	f_cmpr cmpr;
+	f_print print_data;
+} t_pairing_heap;
+
+/// top k fn defn to offer an elem, true if it is kept
+typedef bool (*f_top_k_add)(t_gen d, t_gen data);
+
+/// Streaming top k struct defn, keeps the k greatest elems offered in a min
+/// heap of k slots, an elem not greater than the root (the kth greatest so
+/// far) is rejected with one compare
+typedef struct top_k {
+	char *name;			///< Top k instance name
+	int k;				///< Elems kept
+	int count;			///< Elems held, k once k elems were offered
+	size_t elem_size;		///< Bytes of an elem held inline (0 holds data ptr)
+	size_t slot_size;		///< Bytes of a slot, elem_size or size of ptr
+	char *data;			///< Min heap of held elems, k slots
+	char *tmp;			///< Scratch slot for sorting
+
+	// top k routines
+	f_top_k_add add;		///< routine to offer an elem
+	f_gen threshold;		///< routine to get the least held elem, NULL if less than k held
+	f_gen result;			///< routine to get held elems, greatest first
+	f_len len;			///< routine to get count of held elems
+	f_destroy destroy;		///< routine to destroy
+
+	// routines for operating on data
+	f_cmpr cmpr;
+} t_top_k;
+
 // Heap interface API
 t_gen create_heap(char *name, t_gen data,int size, e_heaptype htype, t_dparams *prm);
+t_gen create_indexed_heap(char *name, t_gen data,int size, e_heaptype htype, t_dparams *prm);
+t_gen create_radix_heap(char *name, int size);
+t_gen create_pairing_heap(char *name, e_heaptype htype, t_dparams *prm);
+t_gen create_top_k(char *name, int k, t_dparams *prm);
+int heap_top_k(t_gen a, int n, int k, t_dparams *prm);
+
+/// Heap of T specialised at compile time, CMP(x, y) returns <0, 0 or >0 and is
+/// expanded in place of the cmpr_idx call, the root is the least elem by CMP
+/// (swap the args of CMP for a max heap), elems are held by value in data
+#define DEFINE_HEAP(T, NAME, CMP)							\
+typedef struct NAME {									\
+	T *data;			/* array based heap */				\
+	int count;			/* total elems present in heap */		\
+	int size;			/* max size of heap */				\
+} t_##NAME;										\
+											\
+static inline void NAME##_init(t_##NAME *h, T *data, int size)				\
+{											\
+	h->data  = data;								\
+	h->count = 0;									\
+	h->size  = size;								\
+}											\
+											\
+static inline void NAME##_heapify_up(t_##NAME *h, int idx)				\
+{											\
+	T tmp = h->data[idx];								\
+	int parent;									\
+											\
+	/* move parents down till the hole reaches the place of tmp */		\
+	for (; idx; idx = parent) {							\
+		parent = (idx - 1) / 2;							\
+		if (CMP(h->data[parent], tmp) <= 0) {					\
+			break;								\
+		}									\
+		h->data[idx] = h->data[parent];						\
+	}										\
+	h->data[idx] = tmp;								\
+}											\
+											\
+static inline void NAME##_heapify(t_##NAME *h, int idx)					\
+{											\
+	T tmp = h->data[idx];								\
+	int child;									\
+											\
+	/* move the lesser child up till the hole reaches the place of tmp */	\
+	for (child = 2 * idx + 1; child < h->count; child = 2 * idx + 1) {		\
+		if (child + 1 < h->count &&						\
+				CMP(h->data[child + 1], h->data[child]) < 0) {		\
+			child++;							\
+		}									\
+		if (CMP(tmp, h->data[child]) <= 0) {					\
+			break;								\
+		}									\
+		h->data[idx] = h->data[child];						\
+		idx = child;								\
+	}										\
+	h->data[idx] = tmp;								\
+}											\
+											\
+static inline bool NAME##_insert(t_##NAME *h, T val)					\
+{											\
+	if (h->count >= h->size) {							\
+		LOG_WARN("HEAP", "%s: HEAP_FULL\n", #NAME);				\
+		return false;								\
+	}										\
+	h->data[h->count] = val;							\
+	NAME##_heapify_up(h, h->count++);						\
+	return true;									\
+}											\
+											\
+static inline bool NAME##_extract(t_##NAME *h, T *out)					\
+{											\
+	if (h->count == 0) {								\
+		LOG_WARN("HEAP", "%s: HEAP EMPTY\n", #NAME);				\
+		return false;								\
+	}										\
+	/* root is swapped with last node, the old root stays past count */	\
+	*out = h->data[0];								\
+	h->data[0] = h->data[--h->count];						\
+	h->data[h->count] = *out;							\
+	if (h->count) {									\
+		NAME##_heapify(h, 0);							\
+	}										\
+	return true;									\
+}											\
+											\
+static inline void NAME##_build(t_##NAME *h)						\
+{											\
+	int idx;									\
+											\
+	h->count = h->size;								\
+	for (idx = h->size / 2 - 1; idx >= 0; idx--) {					\
+		NAME##_heapify(h, idx);							\
+	}										\
+}											\
+											\
+/* sorted in reverse CMP order as with heap_sort */					\
+static inline void NAME##_sort(t_##NAME *h)						\
+{											\
+	T tmp;										\
+											\
+	NAME##_build(h);								\
+	while (h->count) {								\
+		NAME##_extract(h, &tmp);						\
+	}										\
+}
@@ -47,17 +47,59 @@ t_gen linklist_get_node_data(t_gen);
 
 t_gen xor(t_gen x, t_gen y);
 
-/// Look Up function ptrs for add based on type of list
-f_ins add[] = {add_begin_sll,add_begin_dll,add_begin_scll,add_begin_dcll, add_begin_xor_dll};
-
-/// Look Up function ptrs for apend (add end) based on type of list
-f_ins append[] = {add_end_sll,add_end_dll,add_end_scll,add_end_dcll, add_end_xor_dll};
-
-/// Look Up function ptrs for delete node based on type of list
-f_del del[] = {del_node_sll, del_node_dll, del_node_scll, del_node_dcll, del_node_xor_dll};
-
-/// Look Up function ptrs for delete ith node based on type of list
-f_del_idx del_idx[] = {del_node_sll_idx, del_node_dll_idx, del_node_scll_idx, del_node_dcll_idx, del_node_xor_idx};
+/// Routines common to all types of list
+#define LINKLIST_COMMON_OPS				\
+	.get_idx  	 = linklist_getnode,		\
+	.len 	    	 = linklist_length,		\
+	.find     	 = linklist_find,		\
+	.head_node	 = linklist_get_head,		\
+	.tail_node	 = linklist_get_tail,		\
+	.end_node 	 = linklist_get_end,		\
+	.next_node	 = linklist_get_next,		\
+	.prev_node	 = linklist_get_prev,		\
+	.destroy  	 = destroy_link_list,		\
+	.print    	 = linklist_print,		\
+	.print_info    = linklist_print_info,		\
+	.get_node_data = linklist_get_node_data
+
+/// Look Up table of routines based on type of list
+static const t_linklist_ops linklist_ops[] = {
+	[eSINGLE_LINKLIST] = {
+		.append   	 = add_end_sll,
+		.add      	 = add_begin_sll,
+		.del      	 = del_node_sll,
+		.del_idx  	 = del_node_sll_idx,
+		LINKLIST_COMMON_OPS,
+	},
+	[eDOUBLE_LINKLIST] = {
+		.append   	 = add_end_dll,
+		.add      	 = add_begin_dll,
+		.del      	 = del_node_dll,
+		.del_idx  	 = del_node_dll_idx,
+		LINKLIST_COMMON_OPS,
+	},
+	[eSINGLE_CIRCULAR_LINKLIST] = {
+		.append   	 = add_end_scll,
+		.add      	 = add_begin_scll,
+		.del      	 = del_node_scll,
+		.del_idx  	 = del_node_scll_idx,
+		LINKLIST_COMMON_OPS,
+	},
+	[eDOUBLE_CIRCULAR_LINKLIST] = {
+		.append   	 = add_end_dcll,
+		.add      	 = add_begin_dcll,
+		.del      	 = del_node_dcll,
+		.del_idx  	 = del_node_dcll_idx,
+		LINKLIST_COMMON_OPS,
+	},
+	[eXOR_LINKLIST] = {
+		.append   	 = add_end_xor_dll,
+		.add      	 = add_begin_xor_dll,
+		.del      	 = del_node_xor_dll,
+		.del_idx  	 = del_node_xor_idx,
+		LINKLIST_COMMON_OPS,
+	},
+};
 
 /*! @brief  
  *  Create an instance of link list
@@ -68,40 +110,85 @@ f_del_idx del_idx[] = {del_node_sll_idx, del_node_dll_idx, del_node_scll_idx, de
  * */
 t_gen create_link_list (char *name, e_lltype type, t_dparams *prm)
 {
-	t_linklist *l = (t_linklist*)get_mem(1, sizeof(t_linklist));
+	return create_link_list_in_arena(name, type, prm, NULL);
+}
+
+/*! @brief  
+ *  Create an instance of link list with all its nodes
+ *  allocated from the given arena, the list owns the arena
+ *  and destroying the list releases the arena in one go
+ *  @param name  - Name of link list instance
+ *  @param type  - Type of link list to be created
+ *  @param prm   - Data type specific parameters
+ *  @param arena - Arena to allocate from (NULL for tagged mem)
+ *  @return      - Pointer to instance of link list 
+ * */
+t_gen create_link_list_in_arena (char *name, e_lltype type, t_dparams *prm, t_arena *arena)
+{
+	t_linklist *l = (t_linklist*)arena_get_mem(arena, 1, sizeof(t_linklist));
 	
 	// Initailze LL Params
 	l->name  = name;
 	l->type  = type;
 	l->count = 0;
 	l->tail  = l->head = NULL;
+	l->arena = arena;
 
 	// Select Functions based on type of list
-	l->append   	 = append[type];
-	l->add      	 = add[type];
-	l->del      	 = del[type];
-	l->del_idx  	 = del_idx[type];
-	l->get_idx  	 = linklist_getnode;
-	l->len 	    	 = linklist_length;
-	l->find     	 = linklist_find;
-	l->head_node	 = linklist_get_head;
-	l->tail_node	 = linklist_get_tail;
-	l->end_node 	 = linklist_get_end;
-	l->next_node	 = linklist_get_next;
-	l->prev_node	 = linklist_get_prev;
-	l->destroy  	 = destroy_link_list;
-	l->print    	 = linklist_print;
-	l->print_info    = linklist_print_info;
-	l->get_node_data = linklist_get_node_data;
+	l->ops      	 = &linklist_ops[type];
 
 	l->cmpr      	 = prm->cmpr;
 	l->swap      	 = prm->swap;
 	l->print_data	 = prm->print_data;
 	l->free      	 = prm->free;
 
+	// inline elems live in the nodes, nothing to free per elem
+	l->elem_size	 = prm->elem_size;
+	l->out		 = NULL;
+	if (l->elem_size != 0) {
+		l->out  = arena_get_mem(arena, 1, l->elem_size);
+		l->free = dummy_free;
+	}
+
 	return (t_gen)l;
 }
 
+/*! @brief  
+ *  Allocate a node and store data in it, inline elems
+ *  are copied right after the node in the same alloc
+ *  @param l    - Pointer to instance of link list 
+ *  @param data - Pointer to the data to be stored
+ *  @return 	- New node (links not set)
+ * */
+static t_llnode *linklist_new_node(t_linklist *l, t_gen data)
+{
+	t_llnode *node = (t_llnode*)arena_get_mem(l->arena, 1, sizeof(t_llnode) + l->elem_size);
+
+	if (l->elem_size == 0) {
+		node->data = data;
+	} else {
+		node->data = node + 1;
+		memcpy(node->data, data, l->elem_size);
+	}
+	return node;
+}
+
+/*! @brief  
+ *  Get the data of a node about to be freed, inline elems
+ *  are copied out to l->out which holds till the next delete
+ *  @param l    - Pointer to instance of link list 
+ *  @param node - Node being unlinked
+ *  @return 	- Pointer to the data
+ * */
+static t_gen linklist_take(t_linklist *l, t_llnode *node)
+{
+	if (l->elem_size == 0) {
+		return node->data;
+	}
+	memcpy(l->out, node->data, l->elem_size);
+	return l->out;
+}
+
 /*! @brief  
  *  Fetch node data;
  *  @param data - Pointer to the node whose data to fetch
@@ -123,10 +210,7 @@ t_gen linklist_get_node_data(t_gen n)
 void add_begin_sll(t_gen d, t_gen data)
 {
 	t_linklist *l = (t_linklist*)d;
-	t_llnode *node = (t_llnode*)get_mem(1, sizeof(t_llnode));
-	
-	// Create a node and assign data
-	node->data = data;
+	t_llnode *node = linklist_new_node(l, data);
 	
 	// Link cur head to new node
 	node->nxt = l->head; 
@@ -149,10 +233,7 @@ void add_begin_sll(t_gen d, t_gen data)
 void add_begin_dll(t_gen d, t_gen data)
 {
 	t_linklist *l = (t_linklist*)d;
-	t_llnode *node = (t_llnode*)get_mem(1, sizeof(t_llnode));
-	
-	// Create a node and assign data
-	node->data = data;
+	t_llnode *node = linklist_new_node(l, data);
 
 	// Link cur head to new node
 	node->nxt = l->head;
@@ -181,10 +262,7 @@ void add_begin_dll(t_gen d, t_gen data)
 void add_begin_scll(t_gen d,t_gen data)
 {
 	t_linklist *l = (t_linklist*)d;
-	t_llnode *node = (t_llnode*)get_mem(1, sizeof(t_llnode));
-
-	// Create a node and assign data
-	node->data = data;
+	t_llnode *node = linklist_new_node(l, data);
 
 	// Link cur head to new node
 	node->nxt = l->head;
@@ -211,10 +289,7 @@ void add_begin_scll(t_gen d,t_gen data)
 void add_begin_dcll(t_gen d,t_gen data)
 {
 	t_linklist *l = (t_linklist*)d;
-	t_llnode *node = (t_llnode*)get_mem(1, sizeof(t_llnode));
-
-	// Create a node and assign data
-	node->data = data;
+	t_llnode *node = linklist_new_node(l, data);
 
 	// Circ Link new node prv & nxt with tail and head respect 
 	node->nxt = l->head;
@@ -254,8 +329,7 @@ void add_begin_xor_dll(t_gen d, t_gen data)
 	t_llnode *node;
 	
 	// create node and store data
-	node = (t_llnode*)get_mem(1, sizeof(t_llnode));
-	node->data = data;
+	node = linklist_new_node(l, data);
 	//node->nxt = l->head ^ NULL 
 	node->nxt = xor(l->head ,NULL);
 
@@ -285,10 +359,7 @@ void add_begin_xor_dll(t_gen d, t_gen data)
 void add_end_sll(t_gen d,t_gen data) 
 {
 	t_linklist *l = (t_linklist*)d;
-	t_llnode *node = (t_llnode*)get_mem(1, sizeof(t_llnode));
-	
-	// Create a node and assign data
-	node->data = data;
+	t_llnode *node = linklist_new_node(l, data);
 	node->nxt = NULL;
 	
 	if (l->head == NULL) {
@@ -312,10 +383,7 @@ void add_end_sll(t_gen d,t_gen data)
 void add_end_dll(t_gen d,t_gen data) 
 {
 	t_linklist *l = (t_linklist*)d;
-	t_llnode *node = (t_llnode*)get_mem(1, sizeof(t_llnode));
-	
-	// Create a node and assign data
-	node->data = data;
+	t_llnode *node = linklist_new_node(l, data);
 	node->prv = node->nxt = NULL;
 
 	if (l->head == NULL) {
@@ -341,10 +409,7 @@ void add_end_dll(t_gen d,t_gen data)
 void add_end_scll(t_gen d,t_gen data) 
 {
 	t_linklist *l = (t_linklist*)d;
-	t_llnode *node = (t_llnode*)get_mem(1, sizeof(t_llnode));
-	
-	// Create a node and assign data
-	node->data = data;
+	t_llnode *node = linklist_new_node(l, data);
 	node->nxt = NULL;
 	
 	if (l->head == NULL) {
@@ -370,10 +435,7 @@ void add_end_scll(t_gen d,t_gen data)
 void add_end_dcll(t_gen d,t_gen data) 
 {
 	t_linklist *l = (t_linklist*)d;
-	t_llnode *node = (t_llnode*)get_mem(1, sizeof(t_llnode));
-	
-	// Create a node and assign data
-	node->data = data;
+	t_llnode *node = linklist_new_node(l, data);
 	node->prv = node->nxt = NULL;
 
 	if (l->head == NULL) {
@@ -403,8 +465,7 @@ void add_end_xor_dll(t_gen d, t_gen data)
 	t_llnode *node;
 
 	// Create a node and assign data
-	node = (t_llnode*)get_mem(1, sizeof(t_llnode));
-	node->data = data;
+	node = linklist_new_node(l, data);
 	
 	// node->nxt = l->tail ^ NULL;
 	node->nxt = xor(l->tail, NULL);
@@ -445,8 +506,8 @@ t_gen del_node_sll(t_gen d, t_gen data)
 	if (l->cmpr(cur->data, data) == eEQUAL) {
 		l->head = cur->nxt;
 		cur->nxt = NULL;
-		tmp = cur->data;
-		free_mem(cur);
+		tmp = linklist_take(l, cur);
+		arena_free_mem(l->arena, cur);
 		l->count--;
 		// Reset Tail to NULL if list empty
 		l->tail = l->head? l->tail : NULL;
@@ -473,8 +534,8 @@ t_gen del_node_sll(t_gen d, t_gen data)
 	l->count--;
 	// Free node
 	cur->nxt = NULL;
-	tmp = cur->data;
-	free_mem(cur);
+	tmp = linklist_take(l, cur);
+	arena_free_mem(l->arena, cur);
 
 	return tmp;
 }
@@ -510,8 +571,8 @@ t_gen del_node_dll(t_gen d, t_gen data)
 		// Reset Tail to NULL if list empty
 		l->tail = l->head? l->tail : NULL;
 		cur->nxt = cur->prv = NULL;
-		tmp = cur->data;
-		free_mem(cur);
+		tmp = linklist_take(l, cur);
+		arena_free_mem(l->arena, cur);
 		return tmp;
 	}
 
@@ -538,8 +599,8 @@ t_gen del_node_dll(t_gen d, t_gen data)
 	// Free node
 	l->count--;
 	cur->nxt = cur->prv = NULL;
-	tmp = cur->data;
-	free_mem(cur);
+	tmp = linklist_take(l, cur);
+	arena_free_mem(l->arena, cur);
 
 	return tmp;
 }
@@ -575,8 +636,8 @@ t_gen del_node_scll(t_gen d, t_gen data)
 			l->tail = l->head = NULL;
 		}
 		cur->nxt = NULL;
-		tmp = cur->data;
-		free_mem(cur);
+		tmp = linklist_take(l, cur);
+		arena_free_mem(l->arena, cur);
 		return tmp;
 	}
 
@@ -601,8 +662,8 @@ t_gen del_node_scll(t_gen d, t_gen data)
 	}
 	// Free node
 	cur->nxt = NULL;
-	tmp = cur->data;
-	free_mem(cur);
+	tmp = linklist_take(l, cur);
+	arena_free_mem(l->arena, cur);
 
 	return tmp;
 }
@@ -640,8 +701,8 @@ t_gen del_node_dcll(t_gen d, t_gen data)
 			l->tail = l->head = NULL;
 		}
 		cur->nxt = cur->prv = NULL;
-		tmp = cur->data;
-		free_mem(cur);
+		tmp = linklist_take(l, cur);
+		arena_free_mem(l->arena, cur);
 		return tmp;
 	}
 
@@ -667,8 +728,8 @@ t_gen del_node_dcll(t_gen d, t_gen data)
 	l->count--;
 	// Free node
 	cur->nxt = cur->prv = NULL;
-	tmp = cur->data;
-	free_mem(cur);
+	tmp = linklist_take(l, cur);
+	arena_free_mem(l->arena, cur);
 	return tmp;
 }
 
@@ -708,9 +769,9 @@ t_gen del_node_xor_dll(t_gen d, t_gen data)
 
 		l->count--;
 		// Free node
-		tmp = cur->data;
+		tmp = linklist_take(l, cur);
 		cur->nxt =  NULL;
-		free_mem(cur);
+		arena_free_mem(l->arena, cur);
 
 		return tmp;
 	}
@@ -745,9 +806,9 @@ t_gen del_node_xor_dll(t_gen d, t_gen data)
 	
 	// free node
 	l->count --;
-	tmp = cur->data;
+	tmp = linklist_take(l, cur);
 	cur->nxt = NULL; 
-	free_mem(cur);
+	arena_free_mem(l->arena, cur);
 
 	return tmp;
 
@@ -800,8 +861,8 @@ t_gen del_node_sll_idx(t_gen d, int idx)
 	l->count--;
 	// Free node
 	cur->nxt = NULL;
-	tmp = cur->data;
-	free_mem(cur);
+	tmp = linklist_take(l, cur);
+	arena_free_mem(l->arena, cur);
 
 	return tmp;
 }
@@ -862,8 +923,8 @@ t_gen del_node_dll_idx(t_gen d, int idx)
 	// Free node
 	l->count--;
 	cur->nxt = cur->prv = NULL;
-	tmp = cur->data;
-	free_mem(cur);
+	tmp = linklist_take(l, cur);
+	arena_free_mem(l->arena, cur);
 
 	return tmp;
 }
@@ -914,8 +975,8 @@ t_gen del_node_scll_idx(t_gen d, int idx)
 			l->tail = l->head = NULL;
 		}
 		cur->nxt = NULL;
-		tmp = cur->data;
-		free_mem(cur);
+		tmp = linklist_take(l, cur);
+		arena_free_mem(l->arena, cur);
 		return tmp;
 	}
 
@@ -931,8 +992,8 @@ t_gen del_node_scll_idx(t_gen d, int idx)
 	// Free node
 	l->count--;
 	cur->nxt = NULL;
-	tmp = cur->data;
-	free_mem(cur);
+	tmp = linklist_take(l, cur);
+	arena_free_mem(l->arena, cur);
 
 	return tmp;
 }
@@ -982,8 +1043,8 @@ t_gen del_node_dcll_idx(t_gen d, int idx)
 			l->tail = l->head = NULL;
 		}
 		cur->nxt = cur->prv = NULL;
-		tmp = cur->data;
-		free_mem(cur);
+		tmp = linklist_take(l, cur);
+		arena_free_mem(l->arena, cur);
 		
 		return tmp;
 	}
@@ -1002,8 +1063,8 @@ t_gen del_node_dcll_idx(t_gen d, int idx)
 	l->count--;
 	// Free node
 	cur->nxt = cur->prv = NULL;
-	tmp = cur->data;
-	free_mem(cur);
+	tmp = linklist_take(l, cur);
+	arena_free_mem(l->arena, cur);
 	
 	return tmp;
 
@@ -1036,7 +1097,7 @@ t_gen del_node_xor_idx(t_gen d, int idx)
 
 	for(int i = 0; i < idx; i++) {
 		prv = cur;
-		cur = l->next_node(l, prv);
+		cur = l->ops->next_node(l, prv);
 	}
   
 	// delete for head node
@@ -1074,9 +1135,9 @@ t_gen del_node_xor_idx(t_gen d, int idx)
 	}
   l->count--;
   // Free node
-  tmp = cur->data;
+  tmp = linklist_take(l, cur);
   cur->nxt =  NULL;
-  free_mem(cur);
+  arena_free_mem(l->arena, cur);
 
 	return tmp;
 	
@@ -1112,10 +1173,10 @@ t_gen linklist_getnode(t_gen d, int idx)
 	if ((idx < 0) || (idx >= l->count)) {
 		return NULL;
 	}
-	ptr = l->head_node(l);
+	ptr = l->ops->head_node(l);
 	
 	for (i = 0; i < idx; i++) {
-		ptr = l->next_node(l, ptr);
+		ptr = l->ops->next_node(l, ptr);
 	}
 
 	return ptr;
@@ -1132,16 +1193,16 @@ t_gen linklist_find (t_gen d, t_gen data)
 	t_linklist *l = (t_linklist*)d;
 	t_llnode *ptr, *end;
 	
-	ptr = l->head_node(l);
+	ptr = l->ops->head_node(l);
 	// if empty list, return NULL
 	if (ptr == NULL) {
 		return NULL;
 	}
 	
-	end = l->end_node(l);
+	end = l->ops->end_node(l);
 	
 	while (l->cmpr(ptr->data, data) != eEQUAL) {
-		ptr = l->next_node(l, ptr);
+		ptr = l->ops->next_node(l, ptr);
 
 		//reach end of the linked list and node not present, return NULL
 		if (ptr == end) {
@@ -1311,14 +1372,14 @@ void linklist_print (t_gen d)
 	printf("%s : [", l->name);
 
 	// get head ptr of ll
-	ptr = l->head_node(l);
+	ptr = l->ops->head_node(l);
 	// exit for Circ or non circ linked list
-	end = l->end_node(l);
+	end = l->ops->end_node(l);
 
 	while (ptr) {
 		l->print_data(ptr->data);
 		printf(" ");
-		ptr = l->next_node(l, ptr);
+		ptr = l->ops->next_node(l, ptr);
 
 		// exit if end of list
 		if (ptr == end) {
@@ -1345,16 +1406,16 @@ void linklist_print_info (t_gen d)
 			get_lltype_name(l->type),(long)l->head,(long)l->tail, l->count);
 
 	// get head of link list
-	ptr = l->head_node(l);
+	ptr = l->ops->head_node(l);
 	// exit for Circ or non circ linked list
-	end = l->end_node(l);
+	end = l->ops->end_node(l);
 
 	while (ptr) {
 		printf("[ %lx ", (long)ptr->prv);
 		l->print_data(ptr->data);
 		printf(" %lx]", (long)ptr->nxt);
 	
-		ptr = l->next_node(l, ptr);
+		ptr = l->ops->next_node(l, ptr);
 		// exit if end of list
 		if (ptr == end) {
 			break;
@@ -1376,32 +1437,45 @@ void destroy_link_list (t_gen d)
 	t_llnode *tmp,*ptr,*end;
 	int i;
 
+	// arena nodes need no walk unless data has to be freed
+	if (l->arena != NULL && l->free == dummy_free) {
+		destroy_arena(l->arena);
+		return;
+	}
+
 	// delete all node in llist
-	ptr = l->head_node(l);
+	ptr = l->ops->head_node(l);
 
 	// exit for Circ or non circ linked list
-	end = l->end_node(l);
+	end = l->ops->end_node(l);
 
 	while (ptr) {
 		tmp = ptr;	
-		ptr = l->next_node(l, ptr);
+		ptr = l->ops->next_node(l, ptr);
 		l->count--;
 		// free node
 		tmp->nxt = tmp->prv = NULL;
 		l->free(tmp->data, __FILE__, __LINE__);
-		free_mem(tmp);	
+		arena_free_mem(l->arena, tmp);	
 		if(ptr == end) {
 			break;
 		}
 	}
 	
 	if (l->count != 0) {
-		LOG_ERROR(l->name, "%d nodes remain\n", l->count);
+		LOG_ERROR("LINK_LIST", "%s: %d nodes remain\n", l->name, l->count);
 	}
 	// Reset count, head and tail ptrs
 	l->tail = l->head  = NULL;
 
+	// release the arena along with the list
+	if (l->arena != NULL) {
+		destroy_arena(l->arena);
+		return;
+	}
+
+	if (l->out != NULL) {
+		free_mem(l->out);
+	}
 	free_mem(l);
 }
-
-
@@ -22,18 +22,8 @@ typedef struct llnode {
 	struct llnode *prv;		///< Pointer to prev node in list
 } t_llnode;
 
-/// Link List main structure
-typedef struct linklist {
-	char *name; 			///< Name of link list instance */
-	e_lltype type;			///< Type of link list
-	int count;			///< Total no of elems stored in link list
-	e_data_types dtype;		///< Type of data elemnts to be stored
-
-	// linklist head and tail ref
-	t_llnode *head;			///< Head node reference
-	t_llnode *tail;			///< Tail node reference
-	
-	// linklist routines
+/// Link list routines, one const table per type of list shared by all its instances
+typedef struct linklist_ops {
 	f_ins append;			///< routine to Add elem at end of link list
 	f_ins add;			///< routine to Add elem at begin of link list
 	f_del del;			///< routine to del node with matching elem of link list
@@ -50,6 +40,24 @@ typedef struct linklist {
 	f_gen2 prev_node;		///< routine to get the prev node of the given node
 	f_gen get_node_data;		///< routine to get data in given node
 	f_destroy destroy;		///< routine destroy the link list instance
+} t_linklist_ops;
+
+/// Link List main structure
+typedef struct linklist {
+	char *name; 			///< Name of link list instance */
+	e_lltype type;			///< Type of link list
+	int count;			///< Total no of elems stored in link list
+	e_data_types dtype;		///< Type of data elemnts to be stored
+
+	// linklist head and tail ref
+	t_llnode *head;			///< Head node reference
+	t_llnode *tail;			///< Tail node reference
+	t_arena *arena;			///< Arena nodes are allocated from (NULL for tagged mem)
+	size_t elem_size;		///< Bytes of elem copied inline after each node (0 stores data ptr)
+	t_gen out;			///< Holds the elem last removed when stored inline
+	
+	// linklist routines
+	const t_linklist_ops *ops;	///< Routines of the type of list, called as l->ops->append(l, x)
 
 	/// routies for operating on data
 	f_print print_data;		
@@ -62,3 +70,4 @@ typedef struct linklist {
 
 //API
 t_gen create_link_list (char *name, e_lltype type, t_dparams *dprm);
+t_gen create_link_list_in_arena (char *name, e_lltype type, t_dparams *dprm, t_arena *arena);
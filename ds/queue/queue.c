@@ -41,6 +41,9 @@ t_gen create_queue (char *name, int max_size, e_queuetype qtype, t_dparams *prm)
 	// Init queue variables
 	q->name 	= name;
 	q->max_size	= max_size;
+	q->min_size	= max_size;
+	q->auto_grow	= prm->auto_grow;
+	q->shrink_div	= (prm->shrink_div >= 2)? prm->shrink_div : 0;
 	q->type 	= qtype;
 	q->count	= 0;
 	q->front 	= q->rear = -1;
@@ -59,7 +62,7 @@ t_gen create_queue (char *name, int max_size, e_queuetype qtype, t_dparams *prm)
 	switch (qtype) 
 	{
 		case eARRAY_QUEUE_CIRC:
-			q->data = get_mem(max_size, sizeof(t_gen));
+			q->data = get_mem(max_size, (prm->elem_size != 0)? prm->elem_size : sizeof(t_gen));
 		break;
 		case eLL_QUEUE_CIRC:
 			q->data = create_link_list("queue_data", 
@@ -69,9 +72,78 @@ t_gen create_queue (char *name, int max_size, e_queuetype qtype, t_dparams *prm)
 	q->print_data	= prm->print_data;
 	q->free 	= prm->free;
 
+	// inline elems live in the array, nothing to free per elem
+	q->elem_size	= prm->elem_size;
+	if (q->elem_size != 0) {
+		q->free = dummy_free;
+	}
+
 	return (t_gen)q;
 }
 
+/*! @brief  
+ *  Get elem at given array idx of array based queue
+ *  @param q    - Pointer to instance of queue 
+ *  @param idx  - Index in the array
+ *  @return 	- data pointer (address of the slot if inline)
+*/
+static inline t_gen queue_slot(t_queue *q, int idx)
+{
+	if (q->elem_size == 0) {
+		return q->data[idx];
+	}
+	return (char*)q->data + (size_t)idx * q->elem_size;
+}
+
+/*! @brief  
+ *  Move the elems of array based queue in order to the start of an
+ *  array of given size
+ *  @param q    - Pointer to instance of queue 
+ *  @param size - New size of array, not less than count
+ *  @return 	- NA
+*/
+static void queue_resize(t_queue *q, int size)
+{
+	size_t esize = (q->elem_size != 0)? q->elem_size : sizeof(t_gen);
+	char *data = get_mem(size, esize);
+	int first;
+
+	// elems from front to end of array then wrapped ones from start
+	if (q->count != 0) {
+		first = (q->max_size - q->front < q->count)? q->max_size - q->front : q->count;
+		memcpy(data, (char*)q->data + (size_t)q->front * esize, (size_t)first * esize);
+		memcpy(data + (size_t)first * esize, q->data, (size_t)(q->count - first) * esize);
+		q->front = 0;
+		q->rear  = q->count - 1;
+	}
+	free_mem(q->data);
+	q->data = (t_gen*)data;
+	q->max_size = size;
+}
+
+/*! @brief  
+ *  Make room for one more elem, doubles the capacity if full and
+ *  auto grow is set (a link list queue only raises its max size)
+ *  @param q    - Pointer to instance of queue 
+ *  @return 	- true if there is room for an elem
+*/
+static bool queue_grow(t_queue *q)
+{
+	if (q->count < q->max_size) {
+		return true;
+	}
+	if (q->auto_grow == false) {
+		return false;
+	}
+
+	if (q->type == eLL_QUEUE_CIRC) {
+		q->max_size = (q->max_size > 0)? 2 * q->max_size : 1;
+	} else {
+		queue_resize(q, (q->max_size > 0)? 2 * q->max_size : 1);
+	}
+
+	return true;
+}
 
 /*! @brief  
  *  add element in queue
@@ -84,8 +156,9 @@ void queue_enqueue_arr(t_gen d, t_gen data)
 	t_queue *q = (t_queue*)d;
 
 	// return if queue full
-	if (q->full(q) == true) {
+	if (queue_grow(q) == false) {
 		LOG_WARN("QUEUES", "%s: Queue Full\n",q->name);
+		return;
 	}
 
 	// queue empty (added first element)
@@ -93,7 +166,11 @@ void queue_enqueue_arr(t_gen d, t_gen data)
 
 	// Incr Rear and add data to queue
 	q->rear = (q->rear + 1) % q->max_size;
-	q->data[q->rear] = data;
+	if (q->elem_size == 0) {
+		q->data[q->rear] = data;
+	} else {
+		memcpy(queue_slot(q, q->rear), data, q->elem_size);
+	}
 	q->count++;
 	
 }
@@ -114,8 +191,14 @@ t_gen queue_dequeue_arr(t_gen d)
 		return NULL;
 	}
 
+	// Halve on low occupancy before the front slot is handed out
+	if (q->shrink_div > 0 && q->max_size / 2 >= q->min_size &&
+			q->count <= q->max_size / q->shrink_div) {
+		queue_resize(q, q->max_size / 2);
+	}
+
 	// get queue element 
-	data = q->data[q->front];
+	data = queue_slot(q, q->front);
 	
 	// if last element read reset front and rear of queue to -1
 	q->count--;
@@ -155,14 +238,14 @@ t_gen queue_peek(t_gen d, int idx)
 
 	// get queue element for array based queue
 	if (q->type ==eARRAY_QUEUE_CIRC) {
-		return q->data[idx];
+		return queue_slot(q, idx);
 	}
 	
 	// get queue element for linklist based queue
 	l = (t_linklist*)q->data;
-	node = l->get_idx(l, idx);
+	node = l->ops->get_idx(l, idx);
 
-	return l->get_node_data(node);
+	return l->ops->get_node_data(node);
 	
 }
 
@@ -178,13 +261,14 @@ void queue_enqueue_ll(t_gen d, t_gen data)
 	t_linklist *l = (t_linklist*)q->data;
 
 	// return if queue full
-	if (q->full(q) == true) {
+	if (queue_grow(q) == false) {
 		LOG_WARN("QUEUES", "%s: Queue Full\n",q->name);
+		return;
 	}
 	
 	// Incr Rear and add data to queue
 	q->count++;
-	l->append(l, data);
+	l->ops->append(l, data);
 }
 
 /*! @brief  
@@ -197,15 +281,16 @@ t_gen queue_dequeue_ll(t_gen d)
 	t_queue *q = (t_queue*)d;
 	t_linklist *l = (t_linklist*)q->data;
 
-	// return if queue full
-	if (q->full(q) == true) {
-		LOG_WARN("QUEUES", "%s: Queue Full\n",q->name);
+	// return if queue empty
+	if (q->empty(q) == true) {
+		LOG_WARN("QUEUES", "%s: Queue Empty\n",q->name);
+		return NULL;
 	}
 	
 	// Decr count and pop first node in linklist
 	q->count--;
 
-	return l->del_idx(l, 0);
+	return l->ops->del_idx(l, 0);
 }
 
 /*! @brief  
@@ -271,14 +356,14 @@ void queue_print(t_gen d)
 		case eARRAY_QUEUE_CIRC:
 			printf("[");
 			for (i = q->front; (i != -1) && (i <= q->rear); i ++) {
-				q->print_data(q->data[i]);
+				q->print_data(queue_slot(q, i));
 				printf(", ");
 			}
 			printf("]\n");
 		break;
 		case eLL_QUEUE_CIRC:
 			l = (t_linklist*)q->data;
-			l->print(l);
+			l->ops->print(l);
 		break;
 	}
 }
@@ -294,6 +379,9 @@ void destroy_queue (t_gen d)
 	t_linklist *l;
 	int i;
 
+	// No shrinking while emptying the queue
+	q->shrink_div = 0;
+
 	// Free created queue space
 	switch (q->type) 
 	{
@@ -305,7 +393,7 @@ void destroy_queue (t_gen d)
 		break;
 		case eLL_QUEUE_CIRC:
 			l = (t_linklist*)q->data;
-			l->destroy(l);
+			l->ops->destroy(l);
 		break;
 	}
 
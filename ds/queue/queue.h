@@ -17,7 +17,10 @@ typedef enum {
 typedef struct {
 	// queue prams
 	char *name;		///< Stack instance name
-	int max_size;		///< Max Size of queue
+	int max_size;		///< Max Size of queue (current capacity if auto grow)
+	int min_size;		///< Size given at create, capacity never shrinks below it
+	bool auto_grow;		///< Capacity doubles when full, amortised O(1) enqueue
+	int shrink_div;		///< Capacity halves when count drops to max_size/shrink_div (0 never)
 	int count;		///< Total elems present in queue
 	int front;		///< Queue Front Pointer
 	int rear;		///< Queue Rear Pointer
@@ -25,6 +28,7 @@ typedef struct {
 
 	// link List or array based queue
 	t_gen *data;		///< Ptr to link List or array based on type of queue
+	size_t elem_size;	///< Bytes of an elem stored inline in the array (0 stores data ptr)
 	
 	f_ins enq;		///< routine to push elements to queue
 	f_gen deq;		///< routine to pop elements out of queue
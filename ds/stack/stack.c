@@ -41,6 +41,9 @@ t_gen create_stack (char *name, int max_size, e_stacktype stype, t_dparams *prm)
 	// Init stack variables
         s->name 	= name;
         s->max_size 	= max_size;
+        s->min_size 	= max_size;
+        s->auto_grow 	= prm->auto_grow;
+        s->shrink_div 	= (prm->shrink_div >= 2)? prm->shrink_div : 0;
         s->type 	= stype;
         s->count 	= 0;
 	
@@ -65,16 +68,113 @@ t_gen create_stack (char *name, int max_size, e_stacktype stype, t_dparams *prm)
 		break;
 		case eARRAY_STACK:
 		case eARRAY_STACK_DOWN:
-			s->data = get_mem(max_size, sizeof(t_gen));
+			s->data = get_mem(max_size, (prm->elem_size != 0)? prm->elem_size : sizeof(t_gen));
 		break;
         }
 
 	s->print_data	= prm->print_data;
 	s->free 	= prm->free;
 
+	// inline elems live in the array, nothing to free per elem
+	s->elem_size	= prm->elem_size;
+	if (s->elem_size != 0) {
+		s->free = dummy_free;
+	}
+
         return (t_gen) s;
 }
 
+/*! @brief  
+ *  Get elem at given array idx of array based stack
+ *  @param s    - Pointer to instance of stack 
+ *  @param idx  - Index in the array
+ *  @return 	- data pointer (address of the slot if inline)
+*/
+static inline t_gen stack_slot(t_stack *s, int idx)
+{
+	if (s->elem_size == 0) {
+		return s->data[idx];
+	}
+	return (char*)s->data + (size_t)idx * s->elem_size;
+}
+
+/*! @brief  
+ *  Store data at given array idx of array based stack
+ *  @param s    - Pointer to instance of stack 
+ *  @param idx  - Index in the array
+ *  @param data - Pointer to the data, copied if inline
+ *  @return 	- NA
+*/
+static inline void stack_store(t_stack *s, int idx, t_gen data)
+{
+	if (s->elem_size == 0) {
+		s->data[idx] = data;
+	} else {
+		memcpy((char*)s->data + (size_t)idx * s->elem_size, data, s->elem_size);
+	}
+}
+
+/*! @brief  
+ *  Move the elems of array based stack to an array of given size,
+ *  a down growing stack keeps its elems at the end of the array
+ *  @param s    - Pointer to instance of stack 
+ *  @param size - New size of array, not less than count
+ *  @return 	- NA
+*/
+static void stack_resize(t_stack *s, int size)
+{
+	size_t esize = (s->elem_size != 0)? s->elem_size : sizeof(t_gen);
+	int from = (s->type == eARRAY_STACK_DOWN)? s->top : 0;
+	int to = (s->type == eARRAY_STACK_DOWN)? size - s->count : 0;
+	char *data = get_mem(size, esize);
+
+	memcpy(data + (size_t)to * esize, (char*)s->data + (size_t)from * esize, (size_t)s->count * esize);
+	free_mem(s->data);
+	s->data = (t_gen*)data;
+	s->max_size = size;
+	if (s->type == eARRAY_STACK_DOWN) {
+		s->top = to;
+	}
+}
+
+/*! @brief  
+ *  Make room for one more elem, doubles the capacity if full and
+ *  auto grow is set (a link list stack only raises its max size)
+ *  @param s    - Pointer to instance of stack 
+ *  @return 	- true if there is room for an elem
+*/
+static bool stack_grow(t_stack *s)
+{
+	if (s->count < s->max_size) {
+		return true;
+	}
+	if (s->auto_grow == false) {
+		return false;
+	}
+
+	if (s->type == eLL_STACK) {
+		s->max_size = (s->max_size > 0)? 2 * s->max_size : 1;
+	} else {
+		stack_resize(s, (s->max_size > 0)? 2 * s->max_size : 1);
+	}
+
+	return true;
+}
+
+/*! @brief  
+ *  Halve the capacity of array based stack on low occupancy, done
+ *  before an elem is popped so the popped slot stays valid
+ *  @param s    - Pointer to instance of stack 
+ *  @return 	- NA
+*/
+static void stack_shrink(t_stack *s)
+{
+	if (s->shrink_div > 0 && s->type != eLL_STACK && s->max_size / 2 >= s->min_size &&
+			s->count <= s->max_size / s->shrink_div) {
+		stack_resize(s, s->max_size / 2);
+	}
+}
+
 /*! @brief  
  *  Check stack full 
  *  @param d    - Pointer to instance of stack 
@@ -116,12 +216,12 @@ t_gen stack_push_arr_up(t_gen d, t_gen data)
 	t_stack *s = (t_stack*)d; 
 	
 	// Return id stack full
-	if (s->count >= s->max_size) {
+	if (stack_grow(s) == false) {
 		LOG_WARN("STACKS", "%s: Stack Full\n",s->name);
 		return NULL;
 	}
 	// Incr top and push to stack
-	s->data[++(s->top)] =  data;
+	stack_store(s, ++(s->top), data);
 	s->count++;
 
 	return data;
@@ -141,9 +241,10 @@ t_gen stack_pop_arr_up(t_gen d)
 		LOG_WARN("STACKS", "%s: Stack empty\n",s->name);
 		return data;
 	}
+	stack_shrink(s);
 	
 	// Incr top and push to stack
-	data = s->data[(s->top)--];
+	data = stack_slot(s, (s->top)--);
 	s->count--;
 
 	return data;
@@ -160,12 +261,12 @@ t_gen stack_push_arr_down(t_gen d, t_gen data)
 	t_stack *s = (t_stack*)d; 
 	
 	// Return id stack full
-	if (s->count >= s->max_size) {
+	if (stack_grow(s) == false) {
 		LOG_WARN("STACKS", "%s: Stack Full\n",s->name);
 		return NULL;
 	}
 	// Incr top and push to stack
-	s->data[--(s->top)] =  data;
+	stack_store(s, --(s->top), data);
 	s->count++;
 
 	return data;
@@ -185,9 +286,10 @@ t_gen stack_pop_arr_down(t_gen d)
 		LOG_WARN("STACKS", "%s: Stack empty\n",s->name);
 		return data;
 	}
+	stack_shrink(s);
 	
 	// Incr top and push to stack
-	data = s->data[s->top++];
+	data = stack_slot(s, s->top++);
 	s->count--;
 
 	return data;
@@ -205,13 +307,13 @@ t_gen stack_push_ll(t_gen d, t_gen data)
 	t_linklist * l = (t_linklist *)s->data;
 
 	// Return id stack full
-	if (s->count >= s->max_size) {
+	if (stack_grow(s) == false) {
 		LOG_WARN("STACKS", "%s: Stack Full\n",s->name);
 		return NULL;
 	}
 
 	// add in begining of the link list
-	l->add(l, data);
+	l->ops->add(l, data);
 	s->count++;
 
 	return data;
@@ -234,7 +336,7 @@ t_gen stack_pop_ll(t_gen d)
 	}
 
 	// deleting the head node of link list i.e top of stack
-	data = l->del_idx(l, 0);
+	data = l->ops->del_idx(l, 0);
 	s->count--;
 
 	return data;
@@ -276,16 +378,16 @@ void stack_print(t_gen d)
 	if (s->type != eLL_STACK) {
 		i = (s->type != eARRAY_STACK_DOWN)? 0:(s->max_size-1);
 		do {
-			s->print_data(s->data[i]);
+			s->print_data(stack_slot(s, i));
 			printf(", ");
 			(s->type != eARRAY_STACK_DOWN)? i++:i--;
 		} while(i != s->top);
-		s->print_data(s->data[i]);
+		s->print_data(stack_slot(s, i));
 		printf("]\n");
 	}
 	else {
 		l = (t_linklist *)s->data;
-		l->print(l);
+		l->ops->print(l);
 	}
 }
 
@@ -309,14 +411,14 @@ t_gen stack_peek(t_gen d,int idx)
 
 	// Return data for array based stack
 	if (s->type != eLL_STACK) {
-		return s->data[idx];
+		return stack_slot(s, idx);
 	}
 
 	// Return data for link list based stack
 	l = (t_linklist*)s->data;
-	n = l->get_idx(l, idx);
+	n = l->ops->get_idx(l, idx);
 
-	return l->get_node_data(n);
+	return l->ops->get_node_data(n);
 }
 
 /*! @brief  
@@ -330,12 +432,15 @@ void destroy_stack (t_gen d)
 	t_linklist *l = NULL;
 	int i;
 
+	// No shrinking while emptying the stack
+	s->shrink_div = 0;
+
 	// Free created stack space
         switch (s->type) 
 	{
 		case eLL_STACK:
 			l = (t_linklist*)s->data;
-			l->destroy(l);
+			l->ops->destroy(l);
 		break;
 		case eARRAY_STACK:
 		case eARRAY_STACK_DOWN:
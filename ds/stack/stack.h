@@ -20,11 +20,15 @@ typedef struct stack {
 	// stack count, size and top refr
 	char *name;				///< Stack instance name
 	int count;				///< Total elems present in stack
-	int max_size;				///< Max Size of stack
+	int max_size;				///< Max Size of stack (current capacity if auto grow)
+	int min_size;				///< Size given at create, capacity never shrinks below it
+	bool auto_grow;				///< Capacity doubles when full, amortised O(1) push
+	int shrink_div;				///< Capacity halves when count drops to max_size/shrink_div (0 never)
 	int top;				///< Stack Top
 	e_stacktype type;			///< Stack Type @see types of stack
 	// link List or array based stack
 	t_gen *data;				///< Ptr to link List or array based on type of stack
+	size_t elem_size;			///< Bytes of an elem stored inline in the array (0 stores data ptr)
 	/// stack operations
 	f_gen2 push;				///< routine to push element into stack
 	f_gen pop;				///< routine to pop element into stack
@@ -44,13 +44,29 @@ f_len tree_height[] = {tree_height_bst, tree_height_avl};
  * */
 t_gen create_tree(char *name, e_treetype ttype, t_dparams *prm)
 {
-	t_tree *t = get_mem(1, sizeof(t_tree));
+	return create_tree_in_arena(name, ttype, prm, NULL);
+}
+
+/*! @brief  
+ *  Create an instance of tree with all its nodes allocated
+ *  from the given arena, the tree owns the arena and
+ *  destroying the tree releases the arena in one go
+ *  @param name	 - Name of tree instance
+ *  @param ttype - Type of tree to be created
+ *  @param prm   - Data type specific parameters
+ *  @param arena - Arena to allocate from (NULL for tagged mem)
+ *  @return 	 - Pointer to instance of tree
+ * */
+t_gen create_tree_in_arena(char *name, e_treetype ttype, t_dparams *prm, t_arena *arena)
+{
+	t_tree *t = arena_get_mem(arena, 1, sizeof(t_tree));
 
 	// Initailze tree Params
 	t->name       = name;
 	t->type       = ttype;
 	t->count      = 0;
 	t->root       = NULL;
+	t->arena      = arena;
 	
 	// Initailze tree routines
 	t->insert     = tree_insert[ttype]; 
@@ -74,10 +90,93 @@ t_gen create_tree(char *name, e_treetype ttype, t_dparams *prm)
 	t->print_data = prm->print_data;
 	t->free       = prm->free;
 
+	// inline keys live in the nodes, nothing to free per key
+	t->elem_size  = prm->elem_size;
+	t->out        = NULL;
+	if (t->elem_size != 0) {
+		t->out  = arena_get_mem(arena, 1, t->elem_size);
+		t->free = dummy_free;
+	}
+
 	return (t_gen)t;
 }                  
                    
 
+/*! @brief  
+ *   Allocate a tree node and store the key in it, inline
+ *   keys are copied right after the node in the same alloc
+ *  @param t	- Pointer instance of tree
+ *  @param data - Pointer to the key
+ *  @return 	- New leaf node
+ */
+static t_tree_node *tree_new_node(t_tree *t, t_gen data)
+{
+	t_tree_node *new = arena_get_mem(t->arena, 1, sizeof(t_tree_node) + t->elem_size);
+
+	if (t->elem_size == 0) {
+		new->key = data;
+	} else {
+		// inline key always stays in its own node
+		new->key = new + 1;
+		memcpy(new->key, data, t->elem_size);
+	}
+	new->lchild = new->rchild = NULL;
+	new->height = 0;
+	return new;
+}
+
+/*! @brief  
+ *   Swap keys of two nodes, inline keys are swapped in place
+ *  @param t	- Pointer instance of tree
+ *  @param x	- Pointer to node
+ *  @param y	- Pointer to node
+ *  @return 	- NA
+ */
+static void tree_swap_keys(t_tree *t, t_tree_node *x, t_tree_node *y)
+{
+	t_gen tmp;
+
+	if (t->elem_size != 0) {
+		swap_bytes(x->key, y->key, t->elem_size);
+		return;
+	}
+	tmp = x->key;
+	x->key = y->key;
+	y->key = tmp;
+}
+
+/*! @brief  
+ *   Get the key of node being deleted, inline keys are
+ *   copied out to t->out which holds till the next delete
+ *  @param t	- Pointer instance of tree
+ *  @param n	- Node with the key to be deleted
+ *  @return 	- Pointer to the key
+ */
+static t_gen tree_take_key(t_tree *t, t_tree_node *n)
+{
+	if (t->elem_size == 0) {
+		return n->key;
+	}
+	memcpy(t->out, n->key, t->elem_size);
+	return t->out;
+}
+
+/*! @brief  
+ *   Move key of src node to dst node
+ *  @param t	- Pointer instance of tree
+ *  @param dst	- Node getting the key
+ *  @param src	- Node the key is taken from
+ *  @return 	- NA
+ */
+static void tree_move_key(t_tree *t, t_tree_node *dst, t_tree_node *src)
+{
+	if (t->elem_size != 0) {
+		memcpy(dst->key, src->key, t->elem_size);
+	} else {
+		dst->key = src->key;
+	}
+}
+
 /*! @brief  
  *   get_num_nodes in tree;
  *  @param d	- Pointer instance of tree
@@ -104,15 +203,13 @@ void tree_insert_node_bst(t_gen d,t_gen data)
 
 	// key already present
 	if (t->find(t, data) != NULL) {
-		LOG_WARN("TREES", "%s: Key not present\n");
+		LOG_WARN("TREES", "%s: Key already present\n",t->name);
 		return;
 	} 
 
 	t->count++;
 	// Create Node and add data
-	new = get_mem(1, sizeof(t_tree_node));
-	new->key = data;
-	new->lchild = new->rchild = NULL;
+	new = tree_new_node(t, data);
 
 	// tree is empty
 	if (t->root == NULL) {
@@ -409,7 +506,7 @@ t_gen tree_delete_node_bst(t_gen d,t_gen data)
 	} 
 
 	// store the key to be returned	
-	ret = cur->key;
+	ret = tree_take_key(t, cur);
 
 	// node to be  has just one child
 	if (cur->lchild == NULL || cur->rchild == NULL) {
@@ -446,13 +543,13 @@ t_gen tree_delete_node_bst(t_gen d,t_gen data)
 			cur->rchild = tmp->rchild;
 		}
 		
-		cur->key = tmp->key;
+		tree_move_key(t, cur, tmp);
 		cur = tmp;
 	}
 	// Delete node
 	cur->lchild = cur->rchild = NULL;
 	cur->key = NULL;
-	free_mem(cur);
+	arena_free_mem(t->arena, cur);
 
 	return ret;
 }
@@ -522,6 +619,8 @@ void destroy_tree(t_gen d)
 	// Empty tree
 	if (cur == NULL) {
 		LOG_WARN("TREES", "%s: TREE Empty\n",t->name);
+	} else if (t->arena != NULL && t->free == dummy_free) {
+		// arena nodes need no walk unless keys have to be freed
 	} else {
 		init_data_params(&dp, eINT32);
 		q = create_queue("Qdel_tree", t->count,
@@ -545,11 +644,20 @@ void destroy_tree(t_gen d)
 
 			cur->lchild = cur->rchild = NULL;
 			t->free(cur->key, __FILE__, __LINE__);
-			free_mem(cur);
+			arena_free_mem(t->arena, cur);
 		}
 		q->destroy(q);
 	}
+
+	// release the arena along with the tree
+	if (t->arena != NULL) {
+		destroy_arena(t->arena);
+		return;
+	}
 	
+	if (t->out != NULL) {
+		free_mem(t->out);
+	}
 	free_mem(t);
 }
 
@@ -797,26 +905,23 @@ int tree_slope(t_gen n)
 
 /*! @brief  
  *   rotate subtree right
+ *  @param t    - Pointer instance of tree
  *  @param n    - Pointer to node
  *  @return 	- NA
  */
-void tree_rotate_right(t_gen n)
+void tree_rotate_right(t_tree *t, t_gen n)
 {
 	t_tree_node *root = (t_tree_node*)n;
 	t_tree_node *TLL, *TLR, *TR;
-	t_gen x, y;
 
 	// update all ptrs;
-	x = root->key;
-	y = root->lchild->key;
 	TLL = root->lchild->lchild;
 	TLR = root->lchild->rchild;
 	TR = root->rchild;
 
-	// rotate right
-	root->key = y;
+	// rotate right, root and its lchild trade keys
+	tree_swap_keys(t, root, root->lchild);
 	root->rchild = root->lchild;
-	root->rchild->key = x;
 	root->lchild = TLL;
 	root->rchild->lchild = TLR;
 	root->rchild->rchild = TR;
@@ -825,26 +930,23 @@ void tree_rotate_right(t_gen n)
 
 /*! @brief  
  *   rotate subtree left
+ *  @param t    - Pointer instance of tree
  *  @param n    - Pointer to node
  *  @return 	- NA
  */
-void tree_rotate_left(t_gen n)
+void tree_rotate_left(t_tree *t, t_gen n)
 {
 	t_tree_node *root = (t_tree_node*)n;
 	t_tree_node *TLL, *TLRL, *TLRR;
-	t_gen y, z;
 
 	// update all ptrs;
-	y = root->key;
-	z = root->rchild->key;
 	TLL = root->lchild;
 	TLRL = root->rchild->lchild;
 	TLRR = root->rchild->rchild;
 
-	// rotate left
-	root->key = z;
+	// rotate left, root and its rchild trade keys
+	tree_swap_keys(t, root, root->rchild);
 	root->lchild = root->rchild;
-	root->lchild->key = y;
 	root->lchild->lchild = TLL;
 	root->lchild->rchild = TLRL;
 	root->rchild = TLRR;
@@ -852,25 +954,26 @@ void tree_rotate_left(t_gen n)
 
 /*! @brief  
  *   rebalance subtree
+ *  @param t    - Pointer instance of tree
  *  @param n    - Pointer to node
  *  @return 	- NA
  */
-void tree_rebalance(t_gen n)
+void tree_rebalance(t_tree *t, t_gen n)
 {
 	t_tree_node *root = (t_tree_node*)n;
 
 	if (tree_slope(root) == 2) {
 		if (tree_slope(root->lchild) == -1) {
-			tree_rotate_left(root->lchild);
+			tree_rotate_left(t, root->lchild);
 		}
-		tree_rotate_right(root);
+		tree_rotate_right(t, root);
 	}
 		
 	if (tree_slope(root) == -2) {
 		if (tree_slope(root->rchild) == 1) {
-			tree_rotate_right(root->rchild);
+			tree_rotate_right(t, root->rchild);
 		}
-		tree_rotate_left(root);
+		tree_rotate_left(t, root);
 	}
 		
 }
@@ -892,16 +995,13 @@ void tree_insert_node_avl(t_gen d,t_gen data)
 
 	// key already present
 	if (t->find(t, data) != NULL) {
-		LOG_WARN("TREES", "%s: Key not present\n");
+		LOG_WARN("TREES", "%s: Key already present\n",t->name);
 		return;
 	} 
 
 	t->count++;
 	// Create Node and add data
-	new = get_mem(1, sizeof(t_tree_node));
-	new->key = data;
-	new->lchild = new->rchild = NULL;
-	new->height = 0;
+	new = tree_new_node(t, data);
 
 	// tree is empty
 	if (t->root == NULL) {
@@ -945,7 +1045,7 @@ void tree_insert_node_avl(t_gen d,t_gen data)
 	while (s->empty(s) != true) {
 		cur  = s->pop(s);
 		// rebalance the paraent
-		tree_rebalance(cur);
+		tree_rebalance(t, cur);
 		cur->height = tree_height_avl(cur);	
 	}
 
@@ -1005,7 +1105,7 @@ t_gen tree_delete_node_avl(t_gen d,t_gen data)
 	} 
 
 	// store the key to be returned	
-	ret = cur->key;
+	ret = tree_take_key(t, cur);
 
 	// node to be  has just one child
 	if (cur->lchild == NULL || cur->rchild == NULL) {
@@ -1042,19 +1142,19 @@ t_gen tree_delete_node_avl(t_gen d,t_gen data)
 			cur->rchild = tmp->rchild;
 		}
 		
-		cur->key = tmp->key;
+		tree_move_key(t, cur, tmp);
 		cur = tmp;
 	}
 	// Delete node
 	cur->lchild = cur->rchild = NULL;
 	cur->key = NULL;
-	free_mem(cur);
+	arena_free_mem(t->arena, cur);
 
 	// check for rebalance and update height
 	while (s->empty(s) != true) {
 		cur  = s->pop(s);
 		// rebalance the paraent
-		tree_rebalance(cur);
+		tree_rebalance(t, cur);
 		cur->height = tree_height_avl(cur);	
 	}
 
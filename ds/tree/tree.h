@@ -29,6 +29,9 @@ typedef struct tree {
 	
 	// tree root
 	t_gen root;			///< Root node of the tree
+	t_arena *arena;			///< Arena nodes are allocated from (NULL for tagged mem)
+	size_t elem_size;		///< Bytes of key copied inline after each node (0 stores key ptr)
+	t_gen out;			///< Holds the key last deleted when stored inline
 	
 	// tree routines
 	f_ins insert;			///< routine to insert element in tree
@@ -55,3 +58,185 @@ typedef struct tree {
 
 /// tree interface API
 t_gen create_tree(char *name, e_treetype, t_dparams *prm);
+t_gen create_tree_in_arena(char *name, e_treetype, t_dparams *prm, t_arena *arena);
+
+#define AVL_MAX_DEPTH	64		///< Deepest path of a specialised avl tree (height < 1.45 log2 n)
+
+/// AVL tree of T keys specialised at compile time, CMP(x, y) returns <0, 0 or >0
+/// and is expanded in place of the cmpr call, keys are held by value in the
+/// nodes (a string key is the pointer, it is not copied or freed)
+#define DEFINE_AVL(T, NAME, CMP)							\
+typedef struct NAME##_node {								\
+	T key;				/* node key */					\
+	struct NAME##_node *lchild;	/* left child */				\
+	struct NAME##_node *rchild;	/* right child */				\
+	int height;			/* height of node, leaf is 0 */			\
+} t_##NAME##_node;									\
+											\
+typedef struct NAME {									\
+	t_##NAME##_node *root;		/* root node of the tree */			\
+	int count;			/* tree node count */				\
+} t_##NAME;										\
+											\
+static inline void NAME##_init(t_##NAME *t)						\
+{											\
+	t->root  = NULL;								\
+	t->count = 0;									\
+}											\
+											\
+static inline int NAME##_height(t_##NAME##_node *n)					\
+{											\
+	return (n == NULL)? -1 : n->height;						\
+}											\
+											\
+static inline void NAME##_fix_height(t_##NAME##_node *n)				\
+{											\
+	int lh = NAME##_height(n->lchild), rh = NAME##_height(n->rchild);		\
+											\
+	n->height = 1 + ((lh > rh)? lh : rh);						\
+}											\
+											\
+static inline t_##NAME##_node *NAME##_rotate_right(t_##NAME##_node *n)			\
+{											\
+	t_##NAME##_node *l = n->lchild;							\
+											\
+	n->lchild = l->rchild;								\
+	l->rchild = n;									\
+	NAME##_fix_height(n);								\
+	NAME##_fix_height(l);								\
+	return l;									\
+}											\
+											\
+static inline t_##NAME##_node *NAME##_rotate_left(t_##NAME##_node *n)			\
+{											\
+	t_##NAME##_node *r = n->rchild;							\
+											\
+	n->rchild = r->lchild;								\
+	r->lchild = n;									\
+	NAME##_fix_height(n);								\
+	NAME##_fix_height(r);								\
+	return r;									\
+}											\
+											\
+/* rebalance subtree and return its new root */						\
+static inline t_##NAME##_node *NAME##_rebalance(t_##NAME##_node *n)			\
+{											\
+	int slope = NAME##_height(n->lchild) - NAME##_height(n->rchild);		\
+											\
+	if (slope == 2) {								\
+		if (NAME##_height(n->lchild->lchild) < NAME##_height(n->lchild->rchild)) {	\
+			n->lchild = NAME##_rotate_left(n->lchild);			\
+		}									\
+		return NAME##_rotate_right(n);						\
+	}										\
+	if (slope == -2) {								\
+		if (NAME##_height(n->rchild->rchild) < NAME##_height(n->rchild->lchild)) {	\
+			n->rchild = NAME##_rotate_right(n->rchild);			\
+		}									\
+		return NAME##_rotate_left(n);						\
+	}										\
+	NAME##_fix_height(n);								\
+	return n;									\
+}											\
+											\
+static inline T *NAME##_find(t_##NAME *t, T key)					\
+{											\
+	t_##NAME##_node *cur = t->root;							\
+	int res;									\
+											\
+	while (cur != NULL) {								\
+		res = CMP(key, cur->key);						\
+		if (res == 0) {								\
+			return &cur->key;						\
+		}									\
+		cur = (res < 0)? cur->lchild : cur->rchild;				\
+	}										\
+	return NULL;									\
+}											\
+											\
+static inline bool NAME##_insert(t_##NAME *t, T key)					\
+{											\
+	t_##NAME##_node **path[AVL_MAX_DEPTH], **link = &t->root, *new;			\
+	int depth = 0, res;								\
+											\
+	/* remember the links walked to rebalance on the way back */		\
+	while (*link != NULL) {								\
+		res = CMP(key, (*link)->key);						\
+		if (res == 0) {								\
+			LOG_WARN("TREES", "%s: Key already present\n", #NAME);	\
+			return false;							\
+		}									\
+		path[depth++] = link;							\
+		link = (res < 0)? &(*link)->lchild : &(*link)->rchild;			\
+	}										\
+	new = get_mem(1, sizeof(t_##NAME##_node));					\
+	new->key = key;									\
+	new->lchild = new->rchild = NULL;						\
+	new->height = 0;								\
+	*link = new;									\
+	t->count++;									\
+											\
+	while (depth--) {								\
+		*path[depth] = NAME##_rebalance(*path[depth]);				\
+	}										\
+	return true;									\
+}											\
+											\
+static inline bool NAME##_del(t_##NAME *t, T key, T *out)				\
+{											\
+	t_##NAME##_node **path[AVL_MAX_DEPTH], **link = &t->root, **succ, *cur;		\
+	int depth = 0, res;								\
+											\
+	while (*link != NULL && (res = CMP(key, (*link)->key)) != 0) {		\
+		path[depth++] = link;							\
+		link = (res < 0)? &(*link)->lchild : &(*link)->rchild;			\
+	}										\
+	if (*link == NULL) {								\
+		LOG_WARN("TREES", "%s: Key not present\n", #NAME);			\
+		return false;								\
+	}										\
+	cur = *link;									\
+	if (out != NULL) {								\
+		*out = cur->key;							\
+	}										\
+	if (cur->lchild != NULL && cur->rchild != NULL) {				\
+		/* take over key of successor and unlink the successor */		\
+		path[depth++] = link;							\
+		succ = &cur->rchild;							\
+		while ((*succ)->lchild != NULL) {					\
+			path[depth++] = succ;						\
+			succ = &(*succ)->lchild;					\
+		}									\
+		cur->key = (*succ)->key;						\
+		link = succ;								\
+		cur = *link;								\
+	}										\
+	*link = (cur->lchild != NULL)? cur->lchild : cur->rchild;			\
+	free_mem(cur);									\
+	t->count--;									\
+											\
+	while (depth--) {								\
+		*path[depth] = NAME##_rebalance(*path[depth]);				\
+	}										\
+	return true;									\
+}											\
+											\
+static inline void NAME##_destroy(t_##NAME *t)						\
+{											\
+	t_##NAME##_node *cur = t->root, *tmp;						\
+											\
+	/* rotate left children up so the tree unrolls into a list */		\
+	while (cur != NULL) {								\
+		if (cur->lchild != NULL) {						\
+			tmp = cur->lchild;						\
+			cur->lchild = tmp->rchild;					\
+			tmp->rchild = cur;						\
+			cur = tmp;							\
+		} else {								\
+			tmp = cur->rchild;						\
+			free_mem(cur);							\
+			cur = tmp;							\
+		}									\
+	}										\
+	NAME##_init(t);									\
+}
@@ -0,0 +1,1772 @@
+/*! @file bench.c
+    @brief 
+    Contains micro benchmarks of data structure and common module operations
+    Run as "foo.out bench [name]", all benchmarks are run if no name is given
+*/
+
+#include "common.h"
+#include "link_list.h"
+#include "graph.h"
+#include "tree.h"
+#include "heap.h"
+#include "array.h"
+#include "hash_map.h"
+#include "stack.h"
+#include "queue.h"
+
+/// Benchmark routine fn defn
+typedef void (*f_bench)(void);
+
+/// Benchmark table entry
+typedef struct bench_entry {
+	char *name;		///< Name used to select the benchmark
+	f_bench run;		///< routine running the benchmark
+} t_bench;
+
+void bench_mem_free();
+void bench_mem_alloc();
+void bench_linklist();
+void bench_arena();
+void bench_mem_mt();
+void bench_mem_profile();
+void bench_mem_large();
+void bench_log();
+void bench_log_off();
+void bench_log_bin();
+void bench_profiler();
+void bench_graph_mem();
+void bench_inline();
+void bench_specialised();
+void bench_hash_map();
+void bench_graph_build();
+void bench_graph_edges();
+void bench_graph_csr();
+void bench_dijkstra_grid();
+void bench_dary_heap();
+void bench_grow();
+void bench_pairing_heap();
+void bench_top_k();
+
+/// List of all the benchmarks
+static t_bench bench_list[] = {
+	{"mem_free", bench_mem_free},
+	{"mem_alloc", bench_mem_alloc},
+	{"linklist", bench_linklist},
+	{"arena", bench_arena},
+	{"mem_mt", bench_mem_mt},
+	{"mem_profile", bench_mem_profile},
+	{"mem_large", bench_mem_large},
+	{"log", bench_log},
+	{"log_off", bench_log_off},
+	{"log_bin", bench_log_bin},
+	{"profiler", bench_profiler},
+	{"graph_mem", bench_graph_mem},
+	{"inline", bench_inline},
+	{"specialised", bench_specialised},
+	{"hash_map", bench_hash_map},
+	{"graph_build", bench_graph_build},
+	{"graph_edges", bench_graph_edges},
+	{"graph_csr", bench_graph_csr},
+	{"dijkstra_grid", bench_dijkstra_grid},
+	{"dary_heap", bench_dary_heap},
+	{"grow", bench_grow},
+	{"pairing_heap", bench_pairing_heap},
+	{"top_k", bench_top_k},
+};
+
+/*! @brief  
+ *   Monotonic time stamp
+ *  @return - time in nano seconds
+ */
+static uint64_t bench_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/*! @brief  
+ *   Run benchmarks
+ *  @param argc - Count cmd line arguments
+ *  @param argv - Pointer to cmd line arguments (argv[2] selects a benchmark)
+ *  @return 	- NA
+ */
+void run_benchmarks(int argc, char *argv[])
+{
+	int i, n = sizeof(bench_list) / sizeof(bench_list[0]);
+
+	for (i = 0; i < n; i++) {
+		if (argc > 2 && strcmp(argv[2], bench_list[i].name) != 0) {
+			continue;
+		}
+		printf("* bench %s *\n", bench_list[i].name);
+		bench_list[i].run();
+	}
+}
+
+/*! @brief  
+ *   Free cost of tagged memory
+ *   N allocations are made and freed in interleaved order (odd then even)
+ *   so that frees hit the middle of the live set
+ *  @return NA
+ */
+void bench_mem_free()
+{
+	int sizes[] = {1000, 10000, 100000, 1000000};
+	int i, j, n;
+	void **ptr;
+	uint64_t start, end;
+
+	for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+		n = sizes[i];
+		ptr = os_alloc(n, sizeof(void*));
+		for (j = 0; j < n; j++) {
+			ptr[j] = get_mem(1, 24);
+		}
+
+		start = bench_now_ns();
+		for (j = 1; j < n; j += 2) {
+			free_mem(ptr[j]);
+		}
+		for (j = 0; j < n; j += 2) {
+			free_mem(ptr[j]);
+		}
+		end = bench_now_ns();
+
+		printf("live allocs %8d: %6.1f ns/free\n", n, (double)(end - start) / n);
+		os_free(ptr);
+	}
+}
+
+/*! @brief  
+ *   Alloc + free cost of small tagged blocks (node sized)
+ *   Blocks are kept live in batches so the tracker holds a working set
+ *  @return NA
+ */
+void bench_mem_alloc()
+{
+	int i, j, rounds = 200, batch = 10000;
+	void **ptr;
+	uint64_t start, end;
+
+	ptr = os_alloc(batch, sizeof(void*));
+	start = bench_now_ns();
+	for (i = 0; i < rounds; i++) {
+		for (j = 0; j < batch; j++) {
+			ptr[j] = get_mem(1, 24);
+		}
+		for (j = 0; j < batch; j++) {
+			free_mem(ptr[j]);
+		}
+	}
+	end = bench_now_ns();
+	os_free(ptr);
+
+	printf("get_mem/free_mem of 24B: %6.1f ns/pair\n",
+			(double)(end - start) / ((double)rounds * batch));
+}
+
+/*! @brief  
+ *   Append/delete throughput of each type of link list with int elems
+ *   every op allocates (or frees) both the list node and the boxed int
+ *  @return NA
+ */
+void bench_linklist()
+{
+	char *names[] = {"SLL", "DLL", "SCLL", "DCLL", "XORLL"};
+	int i, j, n = 100000, rounds = 5;
+	t_dparams dp;
+	t_linklist *l;
+	uint64_t start, end;
+
+	init_data_params(&dp, eINT32);
+	for (i = eSINGLE_LINKLIST; i <= eXOR_LINKLIST; i++) {
+		l = create_link_list(names[i], i, &dp);
+		start = bench_now_ns();
+		for (int r = 0; r < rounds; r++) {
+			for (j = 0; j < n; j++) {
+				l->ops->append(l, assign_int(j));
+			}
+			for (j = 0; j < n; j++) {
+				free_mem(l->ops->del_idx(l, 0));
+			}
+		}
+		end = bench_now_ns();
+		l->ops->destroy(l);
+		printf("%-6s append+delete: %6.1f ns/elem\n", names[i],
+				(double)(end - start) / ((double)rounds * n));
+	}
+}
+
+/*! @brief  
+ *   Int key allocated from arena when one is given else tagged
+ *  @param a - Pointer to arena or NULL
+ *  @param v - value of key
+ *  @return  - Pointer to key
+ */
+static int *bench_arena_int(t_arena *a, int v)
+{
+	int *key = arena_get_mem(a, 1, sizeof(int));
+
+	*key = v;
+	return key;
+}
+
+/*! @brief  
+ *   Build and teardown cost of a graph and an AVL tree with nodes
+ *   from tagged memory vs from a per container arena, the arena
+ *   containers keep their keys in the arena too so destroy is O(1)
+ *  @return NA
+ */
+void bench_arena()
+{
+	int i, V = 2000, E = 20000, N = 100000, use_arena;
+	t_dparams dp;
+	t_arena *a;
+	t_graph *g;
+	t_tree *t;
+	uint64_t start, mid, end;
+
+	for (use_arena = 0; use_arena < 2; use_arena++) {
+		init_data_params(&dp, eINT32);
+		a = use_arena ? create_arena("graph arena", 0) : NULL;
+		if (use_arena) {
+			dp.free = dummy_free;
+		}
+		srand(1);
+		start = bench_now_ns();
+		g = create_graph_in_arena("bench graph", V, &dp, a);
+		for (i = 0; i < V; i++) {
+			g->ops->add_vertex(g, bench_arena_int(a, i));
+		}
+		for (i = 0; i < E; i++) {
+			int x = rand() % V, y = rand() % V;
+
+			g->ops->add_wedge(g, &x, &y, i);
+		}
+		mid = bench_now_ns();
+		g->ops->destroy(g);
+		end = bench_now_ns();
+		printf("graph V %d E %d %-6s: build %8.2f ms destroy %8.3f ms\n",
+				V, E, use_arena ? "arena" : "tagged",
+				(mid - start) / 1e6, (end - mid) / 1e6);
+	}
+
+	for (use_arena = 0; use_arena < 2; use_arena++) {
+		init_data_params(&dp, eINT32);
+		a = use_arena ? create_arena("tree arena", 0) : NULL;
+		if (use_arena) {
+			dp.free = dummy_free;
+		}
+		srand(1);
+		start = bench_now_ns();
+		t = create_tree_in_arena("bench avl", eAVL, &dp, a);
+		for (i = 0; i < N; i++) {
+			t->insert(t, bench_arena_int(a, i));
+		}
+		mid = bench_now_ns();
+		t->destroy(t);
+		end = bench_now_ns();
+		printf("avl N %d %-6s: build %8.2f ms destroy %8.3f ms\n",
+				N, use_arena ? "arena" : "tagged",
+				(mid - start) / 1e6, (end - mid) / 1e6);
+	}
+}
+
+/// Work done by each thread of the mt stress benchmark
+#define BENCH_MT_ROUNDS		200
+#define BENCH_MT_BATCH		1000
+
+/*! @brief  
+ *   Thread body of mt stress, allocs a batch of node sized
+ *   blocks of mixed sizes then frees them, over and over
+ *  @param arg - NA
+ *  @return    - NA
+ */
+static void *bench_mem_mt_worker(void *arg)
+{
+	void *ptr[BENCH_MT_BATCH];
+	int i, j;
+
+	for (i = 0; i < BENCH_MT_ROUNDS; i++) {
+		for (j = 0; j < BENCH_MT_BATCH; j++) {
+			ptr[j] = get_mem(1, 16 + (j & 7) * 8);
+		}
+		for (j = 0; j < BENCH_MT_BATCH; j++) {
+			free_mem(ptr[j]);
+		}
+	}
+
+	return NULL;
+}
+
+/*! @brief  
+ *   Multi threaded alloc/free stress of tagged memory
+ *   every thread does the same amount of work, so with enough
+ *   cores the throughput should scale with thread count
+ *  @return NA
+ */
+void bench_mem_mt()
+{
+	int threads[] = {1, 2, 4, 8};
+	int i, j, n;
+	pthread_t tid[8];
+	uint64_t start, end;
+	double ops, base = 0;
+
+	printf("online cpus %ld\n", sysconf(_SC_NPROCESSORS_ONLN));
+	for (i = 0; i < sizeof(threads) / sizeof(threads[0]); i++) {
+		n = threads[i];
+		start = bench_now_ns();
+		for (j = 0; j < n; j++) {
+			pthread_create(&tid[j], NULL, bench_mem_mt_worker, NULL);
+		}
+		for (j = 0; j < n; j++) {
+			pthread_join(tid[j], NULL);
+		}
+		end = bench_now_ns();
+
+		// alloc + free pairs per second
+		ops = (double)n * BENCH_MT_ROUNDS * BENCH_MT_BATCH * 1e3 / (end - start);
+		base = (i == 0) ? ops : base;
+		printf("threads %d: %7.2f M pairs/s speedup %4.2fx\n", n, ops, ops / base);
+	}
+}
+
+/*! @brief  
+ *   Per call site memory profile of a graph and an AVL tree,
+ *   shows what neigh lists, edges, vertices and boxed keys own
+ *  @return NA
+ */
+void bench_mem_profile()
+{
+	int i, V = 1000, E = 5000, N = 10000;
+	t_dparams dp;
+	t_graph *g;
+	t_tree *t;
+
+	init_data_params(&dp, eINT32);
+	srand(1);
+	g = create_graph("profile graph", V, &dp);
+	for (i = 0; i < V; i++) {
+		g->ops->add_vertex(g, assign_int(i));
+	}
+	for (i = 0; i < E; i++) {
+		int x = rand() % V, y = rand() % V;
+
+		g->ops->add_wedge(g, &x, &y, i);
+	}
+	t = create_tree("profile avl", eAVL, &dp);
+	for (i = 0; i < N; i++) {
+		t->insert(t, assign_int(i));
+	}
+
+	mem_profile_dump(stdout, eMEM_DUMP_TABLE);
+	mem_profile_dump(stdout, eMEM_DUMP_JSON);
+
+	t->destroy(t);
+	g->ops->destroy(g);
+}
+
+/*! @brief  
+ *   Large array from os_alloc vs get_mem (huge page mapping above
+ *   MEM_LARGE_THRESHOLD), timing alloc + first touch and random reads
+ *  @return NA
+ */
+void bench_mem_large()
+{
+	char *names[] = {"os_alloc", "get_mem"};
+	int i, j, n = 16 << 20, reads = 1 << 24;
+	unsigned int r;
+	long sum;
+	int *arr;
+	uint64_t start, mid, end;
+
+	for (i = 0; i < 2; i++) {
+		start = bench_now_ns();
+		arr = (i == 0) ? os_alloc(n, sizeof(int)) : get_mem(n, sizeof(int));
+		for (j = 0; j < n; j++) {
+			arr[j] = j;
+		}
+		mid = bench_now_ns();
+		r = 1;
+		sum = 0;
+		for (j = 0; j < reads; j++) {
+			r = r * 1103515245 + 12345;
+			sum += arr[r % n];
+		}
+		end = bench_now_ns();
+		if (i == 0) {
+			os_free(arr);
+		} else {
+			free_mem(arr);
+		}
+		printf("%-8s %dMB: alloc+touch %6.1f ms random read %5.1f ns (sum %ld)\n",
+				names[i], (int)(n * sizeof(int) >> 20), (mid - start) / 1e6,
+				(double)(end - mid) / reads, sum);
+	}
+}
+
+/*! @brief  
+ *   Caller side cost of LOG_WARN, sync vs async mode, output to /dev/null
+ *   bursts of 256 calls (fit in the ring) with a pause, then a flood
+ *   that overruns the ring and gets dropped, the fastest burst is taken
+ *   so that bursts the background thread cut into are not counted
+ *  @return NA
+ */
+void bench_log()
+{
+	char *names[] = {"sync", "async"};
+	struct timespec nap = {0, 2000000};
+	int i, j, b, bursts = 200, burst = 256, flood = 100000;
+	uint64_t start, end, took, flood_took;
+	FILE *fp;
+	size_t dropped;
+
+	fp = fopen("/dev/null", "w");
+	if (fp == NULL) {
+		return;
+	}
+	logger_finit();
+	logger_set_file(fp);
+	for (i = 0; i < 2; i++) {
+		dropped = logger_dropped();
+		if (i == 1) {
+			logger_start_async();
+		}
+		took = UINT64_MAX;
+		for (b = 0; b < bursts; b++) {
+			start = bench_now_ns();
+			for (j = 0; j < burst; j++) {
+				LOG_WARN("BENCH", "%s: burst %d msg %d val %f\n", names[i], b, j, j * 0.5);
+			}
+			end = bench_now_ns();
+			took = (end - start < took) ? end - start : took;
+			nanosleep(&nap, NULL);
+		}
+		start = bench_now_ns();
+		for (j = 0; j < flood; j++) {
+			LOG_WARN("BENCH", "%s: flood msg %d\n", names[i], j);
+		}
+		flood_took = bench_now_ns() - start;
+
+		logger_finit();
+		printf("%-5s burst %6.1f ns/call flood %6.1f ns/call dropped %lu\n", names[i],
+				(double)took / burst,
+				(double)flood_took / flood, logger_dropped() - dropped);
+	}
+	logger_set_file(NULL);
+	fclose(fp);
+#ifdef LOG_ASYNC
+	logger_start_async();
+#endif
+}
+
+/// Count of bench_log_arg calls, shows when log args get evaluated
+static int bench_log_evals;
+
+/*! @brief  
+ *   Log argument with a side effect
+ *  @param v - value
+ *  @return  - v
+ */
+static int bench_log_arg(int v)
+{
+	bench_log_evals++;
+	return v;
+}
+
+/*! @brief  
+ *   Cost of disabled LOG_DEBUG in a loop, off at run time for its module
+ *   and compiled out, against the bare loop
+ *  @return NA
+ */
+void bench_log_off()
+{
+	char *names[] = {"no log", "runtime off", "compiled out"};
+	int i, j, n = 10000000;
+	volatile long sum;
+	uint64_t start, end;
+
+	logger_set_level("BENCH_OFF", __LOG_DEBUG__, false);
+	for (i = 0; i < 3; i++) {
+		bench_log_evals = 0;
+		sum = 0;
+		start = bench_now_ns();
+		for (j = 0; j < n; j++) {
+			sum += j;
+			if (i == 1) {
+				LOG_DEBUG("BENCH_OFF", "elem %d sum %ld\n", bench_log_arg(j), sum);
+			} else if (i == 2) {
+				LOG_NOP("BENCH_OFF", __LOG_DEBUG__, "elem %d sum %ld\n", bench_log_arg(j), sum);
+			}
+		}
+		end = bench_now_ns();
+		printf("%-12s: %5.2f ns/iter args evaluated %d\n", names[i],
+				(double)(end - start) / n, bench_log_evals);
+	}
+	logger_set_level("BENCH_OFF", __LOG_DEBUG__, true);
+}
+
+/*! @brief  
+ *   LOG_DEBUG cost in text (sync to /dev/null) vs binary mode, and the
+ *   cost of decoding the binary log offline
+ *  @return NA
+ */
+void bench_log_bin()
+{
+	char *path = "bench_log.bin";
+	int i, n = 1000000, decoded;
+	uint64_t start, text, bin, dec;
+	FILE *fp;
+
+	fp = fopen("/dev/null", "w");
+	if (fp == NULL) {
+		return;
+	}
+	logger_finit();
+	logger_set_file(fp);
+
+	start = bench_now_ns();
+	for (i = 0; i < n; i++) {
+		LOG_DEBUG("BENCH", "graph %s vertex %d dist %d\n", "g1", i, i * 3);
+	}
+	text = bench_now_ns() - start;
+
+	if (logger_start_binary(path, LOG_BIN_SIZE) != 0) {
+		fclose(fp);
+		return;
+	}
+	start = bench_now_ns();
+	for (i = 0; i < n; i++) {
+		LOG_DEBUG("BENCH", "graph %s vertex %d dist %d\n", "g1", i, i * 3);
+	}
+	bin = bench_now_ns() - start;
+	logger_finit();
+
+	start = bench_now_ns();
+	decoded = logger_decode(path, fp);
+	dec = bench_now_ns() - start;
+	remove(path);
+	logger_set_file(NULL);
+	fclose(fp);
+
+	printf("text %6.1f ns/call binary %6.1f ns/call decode %6.1f ns/msg (%d msgs)\n",
+			(double)text / n, (double)bin / n, (double)dec / n, decoded);
+#ifdef LOG_ASYNC
+	logger_start_async();
+#endif
+#ifdef LOG_BINARY
+	logger_start_binary(LOG_BIN_FILE, LOG_BIN_SIZE);
+#endif
+}
+
+/*! @brief  
+ *   Cpu bound work for the profiler bench, appends and deletes from a list
+ *  @return - time taken in nano seconds
+ */
+static uint64_t bench_profiler_work(void)
+{
+	int i, r, n = 100000, rounds = 5;
+	t_dparams dp;
+	t_linklist *l;
+	uint64_t start;
+
+	init_data_params(&dp, eINT32);
+	l = create_link_list("prof list", eDOUBLE_LINKLIST, &dp);
+	start = bench_now_ns();
+	for (r = 0; r < rounds; r++) {
+		for (i = 0; i < n; i++) {
+			l->ops->append(l, assign_int(i));
+		}
+		for (i = 0; i < n; i++) {
+			free_mem(l->ops->del_idx(l, 0));
+		}
+	}
+	start = bench_now_ns() - start;
+	l->ops->destroy(l);
+
+	return start;
+}
+
+/*! @brief  
+ *   Overhead of the sampling profiler at PROF_HZ on a cpu bound loop
+ *  @return NA
+ */
+void bench_profiler()
+{
+	char *path = "bench_prof.folded";
+	uint64_t off = UINT64_MAX, on = UINT64_MAX, t;
+	int i, stacks = 0;
+	FILE *fp;
+	char line[1024];
+
+	for (i = 0; i < 5; i++) {
+		t = bench_profiler_work();
+		off = (t < off) ? t : off;
+		if (profiler_start(path, PROF_HZ) != 0) {
+			printf("profiler already running\n");
+			return;
+		}
+		t = bench_profiler_work();
+		on = (t < on) ? t : on;
+		profiler_stop();
+	}
+
+	fp = fopen(path, "r");
+	if (fp != NULL) {
+		while (fgets(line, sizeof(line), fp) != NULL) {
+			stacks++;
+		}
+		fclose(fp);
+		remove(path);
+	}
+	printf("off %6.1f ms on %6.1f ms overhead %4.1f%% (%d hz, %d distinct stacks)\n",
+			off / 1e6, on / 1e6, 100.0 * ((double)on - off) / off, PROF_HZ, stacks);
+}
+
+/*! @brief  
+ *   Resident memory of the process
+ *  @return - resident bytes
+ */
+static size_t bench_rss_bytes(void)
+{
+	long pages = 0, rss = 0;
+	FILE *fp = fopen("/proc/self/statm", "r");
+
+	if (fp != NULL) {
+		if (fscanf(fp, "%ld %ld", &pages, &rss) != 2) {
+			rss = 0;
+		}
+		fclose(fp);
+	}
+	return (size_t)rss * sysconf(_SC_PAGESIZE);
+}
+
+/*! @brief  
+ *   Memory footprint of graph construction, every vertex owns a neigh list
+ *  @return NA
+ */
+void bench_graph_mem()
+{
+	int i, V = 20000, E = 20000;
+	t_dparams dp;
+	t_graph *g;
+	size_t before, after;
+	int *ids;
+
+	init_data_params(&dp, eINT32);
+	dp.free = dummy_free;
+	ids = os_alloc(V, sizeof(int));
+	srand(1);
+
+	before = bench_rss_bytes();
+	g = create_graph("mem graph", V, &dp);
+	for (i = 0; i < V; i++) {
+		ids[i] = i;
+		g->ops->add_vertex(g, &ids[i]);
+	}
+	for (i = 0; i < E; i++) {
+		g->ops->add_wedge(g, &ids[rand() % V], &ids[rand() % V], i);
+	}
+	after = bench_rss_bytes();
+
+	printf("sizeof graph %lu linklist %lu\n", sizeof(t_graph), sizeof(t_linklist));
+	printf("%d vertices %d edges: rss +%lu MB (%.1f B/vertex)\n", V, E,
+			(after - before) >> 20, (double)(after - before) / V);
+
+	g->ops->destroy(g);
+	os_free(ids);
+}
+
+/*! @brief  
+ *   Compare boxed ints at given idx of a t_gen array
+ *  @param x    - t_gen array
+ *  @param idx1 - idx of first elem
+ *  @param idx2 - idx of second elem
+ *  @return     - compare result
+ */
+static e_cmpr bench_boxed_cmpr_idx(t_gen x, int idx1, int idx2)
+{
+	t_gen *arr = (t_gen*)x;
+
+	return compare_int(arr[idx1], arr[idx2]);
+}
+
+/*! @brief  
+ *   Heap and AVL throughput with int keys boxed (every key is an
+ *   assign_int alloc held by pointer) vs stored inline (elem_size)
+ *  @return NA
+ */
+void bench_inline()
+{
+	int i, N = 200000, rounds = 3, boxed, *keys, *arr;
+	t_dparams dp;
+	t_heap *h;
+	t_tree *t;
+	uint64_t start, mid, end, best_ins, best_out;
+
+	// distinct keys in random order
+	keys = os_alloc(N, sizeof(int));
+	srand(1);
+	for (i = 0; i < N; i++) {
+		keys[i] = i;
+	}
+	for (i = N - 1; i > 0; i--) {
+		int j = rand() % (i + 1), tmp = keys[i];
+
+		keys[i] = keys[j];
+		keys[j] = tmp;
+	}
+
+	for (boxed = 1; boxed >= 0; boxed--) {
+		init_data_params(&dp, eINT32);
+		if (boxed) {
+			dp.cmpr_idx = bench_boxed_cmpr_idx;
+			dp.swap_idx = gen_swp_idx;
+			dp.copy_idx = gen_cpy_idx;
+			dp.get_idx  = gen_get_idx;
+		} else {
+			dp.elem_size = sizeof(int);
+		}
+		arr = os_alloc(N, boxed ? sizeof(t_gen) : sizeof(int));
+		best_ins = best_out = UINT64_MAX;
+		for (int r = 0; r < rounds; r++) {
+			h = create_heap("bench heap", arr, N, eMIN_HEAP, &dp);
+			start = bench_now_ns();
+			for (i = 0; i < N; i++) {
+				h->insert(h, boxed ? assign_int(keys[i]) : &keys[i]);
+			}
+			mid = bench_now_ns();
+			for (i = 0; i < N; i++) {
+				t_gen v = h->extract(h);
+				if (boxed) {
+					free_mem(v);
+				}
+			}
+			end = bench_now_ns();
+			h->destroy(h);
+			best_ins = (mid - start < best_ins) ? mid - start : best_ins;
+			best_out = (end - mid < best_out) ? end - mid : best_out;
+		}
+		os_free(arr);
+		printf("heap %-6s: insert %6.1f ns/op extract %6.1f ns/op\n",
+				boxed ? "boxed" : "inline",
+				(double)best_ins / N, (double)best_out / N);
+	}
+
+	N /= 2;
+	for (boxed = 1; boxed >= 0; boxed--) {
+		init_data_params(&dp, eINT32);
+		dp.elem_size = boxed ? 0 : sizeof(int);
+		best_ins = best_out = UINT64_MAX;
+		for (int r = 0; r < rounds; r++) {
+			t = create_tree("bench avl", eAVL, &dp);
+			start = bench_now_ns();
+			for (i = 0; i < N; i++) {
+				t->insert(t, boxed ? assign_int(keys[i]) : &keys[i]);
+			}
+			mid = bench_now_ns();
+			for (i = 0; i < N; i++) {
+				t->find(t, &keys[i]);
+			}
+			end = bench_now_ns();
+			t->destroy(t);
+			best_ins = (mid - start < best_ins) ? mid - start : best_ins;
+			best_out = (end - mid < best_out) ? end - mid : best_out;
+		}
+		printf("avl  %-6s: insert %6.1f ns/op find    %6.1f ns/op\n",
+				boxed ? "boxed" : "inline",
+				(double)best_ins / N, (double)best_out / N);
+	}
+	os_free(keys);
+}
+
+DEFINE_HEAP(int, heap_int, CMP_NUM)
+DEFINE_HEAP(float, heap_flt, CMP_NUM)
+DEFINE_HEAP(char*, heap_str, CMP_STR)
+DEFINE_SORT(int, sort_int, CMP_NUM)
+DEFINE_SORT(float, sort_flt, CMP_NUM)
+DEFINE_SORT(char*, sort_str, CMP_STR)
+DEFINE_AVL(int, avl_int, CMP_NUM)
+DEFINE_AVL(float, avl_flt, CMP_NUM)
+DEFINE_AVL(char*, avl_str, CMP_STR)
+
+/// Ops timed for each key type by the specialised benchmark
+enum {eSPEC_HEAP, eSPEC_SORT, eSPEC_AVL, eSPEC_OPS};
+
+/*! @brief  
+ *   Time heap insert+extract, quick sort and avl insert+find of the
+ *   specialised containers of a key type, best of 3 rounds
+ *  @param T    - key type
+ *  @param NAME - suffix of the specialised containers
+ */
+#define BENCH_SPEC(T, NAME)								\
+static void bench_spec_##NAME(T *keys, int n, uint64_t ns[eSPEC_OPS])			\
+{											\
+	t_heap_##NAME h;								\
+	t_avl_##NAME t;									\
+	T *arr = os_alloc(n, sizeof(T));						\
+	T tmp;										\
+	uint64_t start, dt[eSPEC_OPS];							\
+	int i, r;									\
+											\
+	for (i = 0; i < eSPEC_OPS; i++) {						\
+		ns[i] = UINT64_MAX;							\
+	}										\
+	for (r = 0; r < 3; r++) {							\
+		start = bench_now_ns();							\
+		heap_##NAME##_init(&h, arr, n);						\
+		for (i = 0; i < n; i++) {						\
+			heap_##NAME##_insert(&h, keys[i]);				\
+		}									\
+		for (i = 0; i < n; i++) {						\
+			heap_##NAME##_extract(&h, &tmp);				\
+		}									\
+		dt[eSPEC_HEAP] = bench_now_ns() - start;				\
+											\
+		memcpy(arr, keys, n * sizeof(T));					\
+		start = bench_now_ns();							\
+		sort_##NAME(arr, n);							\
+		dt[eSPEC_SORT] = bench_now_ns() - start;				\
+											\
+		start = bench_now_ns();							\
+		avl_##NAME##_init(&t);							\
+		for (i = 0; i < n; i++) {						\
+			avl_##NAME##_insert(&t, keys[i]);				\
+		}									\
+		for (i = 0; i < n; i++) {						\
+			avl_##NAME##_find(&t, keys[i]);					\
+		}									\
+		dt[eSPEC_AVL] = bench_now_ns() - start;					\
+		avl_##NAME##_destroy(&t);						\
+											\
+		for (i = 0; i < eSPEC_OPS; i++) {					\
+			ns[i] = (dt[i] < ns[i])? dt[i] : ns[i];				\
+		}									\
+	}										\
+	os_free(arr);									\
+}
+
+BENCH_SPEC(int, int)
+BENCH_SPEC(float, flt)
+BENCH_SPEC(char*, str)
+
+/*! @brief  
+ *   Compare string keys at given idx of a t_gen array
+ *  @param x    - t_gen array
+ *  @param idx1 - idx of first elem
+ *  @param idx2 - idx of second elem
+ *  @return     - compare result
+ */
+static e_cmpr bench_str_cmpr_idx(t_gen x, int idx1, int idx2)
+{
+	t_gen *arr = (t_gen*)x;
+
+	return compare_string(arr[idx1], arr[idx2]);
+}
+
+/*! @brief  
+ *   Same work as bench_spec_* done by the generic heap, quick_sort
+ *   and avl tree, every compare is an indirect call through dp
+ *  @param keys  - array of keys
+ *  @param size  - bytes of a key
+ *  @param boxed - keys are pointers passed as is (strings) else by address
+ *  @param n     - number of keys
+ *  @param dp    - data params of the key type
+ *  @param ns    - best time of each op
+ *  @return NA
+ */
+static void bench_spec_generic(char *keys, size_t size, bool boxed, int n,
+		t_dparams *dp, uint64_t ns[eSPEC_OPS])
+{
+	t_gen arr = os_alloc(n, size);
+	uint64_t start, dt[eSPEC_OPS];
+	t_dparams hp = *dp;
+	t_heap *h;
+	t_tree *t;
+	int i, r;
+
+	// heap goes through the idx routines, only the tree keeps keys inline
+	hp.elem_size = 0;
+
+	for (i = 0; i < eSPEC_OPS; i++) {
+		ns[i] = UINT64_MAX;
+	}
+	for (r = 0; r < 3; r++) {
+		start = bench_now_ns();
+		h = create_heap("generic heap", arr, n, eMIN_HEAP, &hp);
+		for (i = 0; i < n; i++) {
+			h->insert(h, boxed ? *(t_gen*)(keys + i * size) : keys + i * size);
+		}
+		for (i = 0; i < n; i++) {
+			h->extract(h);
+		}
+		h->destroy(h);
+		dt[eSPEC_HEAP] = bench_now_ns() - start;
+
+		memcpy(arr, keys, n * size);
+		start = bench_now_ns();
+		quick_sort(arr, n, dp);
+		dt[eSPEC_SORT] = bench_now_ns() - start;
+
+		start = bench_now_ns();
+		t = create_tree("generic avl", eAVL, dp);
+		for (i = 0; i < n; i++) {
+			t->insert(t, boxed ? *(t_gen*)(keys + i * size) : keys + i * size);
+		}
+		for (i = 0; i < n; i++) {
+			t->find(t, boxed ? *(t_gen*)(keys + i * size) : keys + i * size);
+		}
+		dt[eSPEC_AVL] = bench_now_ns() - start;
+		t->destroy(t);
+
+		for (i = 0; i < eSPEC_OPS; i++) {
+			ns[i] = (dt[i] < ns[i])? dt[i] : ns[i];
+		}
+	}
+	os_free(arr);
+}
+
+/*! @brief  
+ *   Generic containers (cmpr through fn ptrs of t_dparams) vs the
+ *   DEFINE_HEAP/DEFINE_SORT/DEFINE_AVL specialisations for int,
+ *   float and string keys, generic avl keeps int/float keys inline
+ *  @return NA
+ */
+void bench_specialised()
+{
+	char *ops[] = {"heap insert+extract", "quick sort", "avl insert+find"};
+	char *types[] = {"int", "float", "string"};
+	int i, j, k, n = 100000;
+	uint64_t gen[eSPEC_OPS], spec[eSPEC_OPS];
+	int *ikeys = os_alloc(n, sizeof(int));
+	float *fkeys = os_alloc(n, sizeof(float));
+	char **skeys = os_alloc(n, sizeof(char*));
+	char *sbuf = os_alloc(n, 16);
+	t_dparams dp;
+
+	// distinct keys in random order
+	srand(1);
+	for (i = 0; i < n; i++) {
+		ikeys[i] = i;
+	}
+	for (i = n - 1; i > 0; i--) {
+		int r = rand() % (i + 1), tmp = ikeys[i];
+
+		ikeys[i] = ikeys[r];
+		ikeys[r] = tmp;
+	}
+	for (i = 0; i < n; i++) {
+		fkeys[i] = ikeys[i] * 0.5f;
+		skeys[i] = sbuf + 16 * i;
+		snprintf(skeys[i], 16, "key%08d", ikeys[i]);
+	}
+
+	for (k = 0; k < 3; k++) {
+		init_data_params(&dp, (k == 0)? eINT32 : (k == 1)? eFLOAT : eSTRING);
+		switch (k) {
+			case 0:
+				dp.elem_size = sizeof(int);
+				bench_spec_generic((char*)ikeys, sizeof(int), false, n, &dp, gen);
+				bench_spec_int(ikeys, n, spec);
+				break;
+			case 1:
+				dp.elem_size = sizeof(float);
+				bench_spec_generic((char*)fkeys, sizeof(float), false, n, &dp, gen);
+				bench_spec_flt(fkeys, n, spec);
+				break;
+			case 2:
+				dp.free     = dummy_free;
+				dp.cmpr_idx = bench_str_cmpr_idx;
+				dp.swap_idx = gen_swp_idx;
+				dp.copy_idx = gen_cpy_idx;
+				dp.get_idx  = gen_get_idx;
+				bench_spec_generic((char*)skeys, sizeof(char*), true, n, &dp, gen);
+				bench_spec_str(skeys, n, spec);
+				break;
+		}
+		for (j = 0; j < eSPEC_OPS; j++) {
+			printf("%-6s %-20s: generic %8.2f ms specialised %8.2f ms (%4.1fx)\n",
+					types[k], ops[j], gen[j] / 1e6, spec[j] / 1e6,
+					(double)gen[j] / spec[j]);
+		}
+	}
+	os_free(ikeys);
+	os_free(fkeys);
+	os_free(skeys);
+	os_free(sbuf);
+}
+
+/*! @brief  
+ *   Hash map insert, find (hit and miss), iterate and delete of int keys
+ *   (inline) and string keys, avl find of the same int keys for reference
+ *  @return NA
+ */
+void bench_hash_map()
+{
+	int i, k, n = 200000, *ikeys, miss;
+	char *sbuf, **skeys;
+	t_dparams dp;
+	t_hash_map *m;
+	t_tree *t;
+	t_gen key, val;
+	uint64_t start, ins, hit, out, iter, del;
+	long sum;
+
+	// distinct keys in random order
+	ikeys = os_alloc(n, sizeof(int));
+	skeys = os_alloc(n, sizeof(char*));
+	sbuf = os_alloc(n, 16);
+	srand(1);
+	for (i = 0; i < n; i++) {
+		ikeys[i] = i;
+	}
+	for (i = n - 1; i > 0; i--) {
+		int r = rand() % (i + 1), tmp = ikeys[i];
+
+		ikeys[i] = ikeys[r];
+		ikeys[r] = tmp;
+	}
+	for (i = 0; i < n; i++) {
+		skeys[i] = sbuf + 16 * i;
+		snprintf(skeys[i], 16, "key%08d", ikeys[i]);
+	}
+
+	for (k = 0; k < 2; k++) {
+		init_data_params(&dp, (k == 0)? eINT32 : eSTRING);
+		if (k == 0) {
+			dp.elem_size = sizeof(int);
+		} else {
+			dp.free = dummy_free;
+		}
+		m = create_hash_map("bench map", 0, &dp);
+
+		start = bench_now_ns();
+		for (i = 0; i < n; i++) {
+			m->insert(m, (k == 0)? (t_gen)&ikeys[i] : skeys[i], (t_gen)(long)i);
+		}
+		ins = bench_now_ns() - start;
+
+		start = bench_now_ns();
+		for (i = 0; i < n; i++) {
+			m->find(m, (k == 0)? (t_gen)&ikeys[i] : skeys[i]);
+		}
+		hit = bench_now_ns() - start;
+
+		start = bench_now_ns();
+		for (i = 0, miss = n; i < n; i++, miss++) {
+			char str[16];
+
+			if (k == 0) {
+				m->find(m, &miss);
+			} else {
+				snprintf(str, sizeof(str), "key%08d", miss);
+				m->find(m, str);
+			}
+		}
+		out = bench_now_ns() - start;
+
+		start = bench_now_ns();
+		sum = 0;
+		for (i = m->next(m, -1, &key, &val); i >= 0; i = m->next(m, i, &key, &val)) {
+			sum += (long)val;
+		}
+		iter = bench_now_ns() - start;
+
+		start = bench_now_ns();
+		for (i = 0; i < n; i++) {
+			m->del(m, (k == 0)? (t_gen)&ikeys[i] : skeys[i]);
+		}
+		del = bench_now_ns() - start;
+
+		printf("%-6s n %d capacity %d: insert %5.1f find %5.1f miss %5.1f "
+				"iterate %4.1f delete %5.1f ns/op (sum %ld)\n",
+				(k == 0)? "int" : "string", n, m->capacity,
+				(double)ins / n, (double)hit / n, (double)out / n,
+				(double)iter / n, (double)del / n, sum);
+		m->destroy(m);
+	}
+
+	init_data_params(&dp, eINT32);
+	dp.elem_size = sizeof(int);
+	t = create_tree("bench avl", eAVL, &dp);
+	for (i = 0; i < n; i++) {
+		t->insert(t, &ikeys[i]);
+	}
+	start = bench_now_ns();
+	for (i = 0; i < n; i++) {
+		t->find(t, &ikeys[i]);
+	}
+	hit = bench_now_ns() - start;
+	t->destroy(t);
+	printf("avl    n %d: find %5.1f ns/op\n", n, (double)hit / n);
+
+	os_free(ikeys);
+	os_free(skeys);
+	os_free(sbuf);
+}
+
+/*! @brief  
+ *   Build of a graph with random weighted edges, vertex lookup by
+ *   linear scan (no hash in dparams) vs the vertex index, the scan is
+ *   only run on the small graph as its cost grows with V per edge
+ *  @return NA
+ */
+void bench_graph_build()
+{
+	int i, j, *ids, V[] = {10000, 100000}, E[] = {100000, 1000000};
+	t_dparams dp;
+	t_arena *a;
+	t_graph *g;
+	uint64_t start, mid, end;
+
+	ids = os_alloc(V[1], sizeof(int));
+	for (i = 0; i < V[1]; i++) {
+		ids[i] = i;
+	}
+
+	for (j = 0; j < 3; j++) {
+		int v = V[j / 2], e = E[j / 2];
+
+		init_data_params(&dp, eINT32);
+		dp.free = dummy_free;
+		if (j == 0) {
+			dp.hash = NULL;
+		}
+		srand(1);
+		a = create_arena("graph arena", 0);
+		start = bench_now_ns();
+		g = create_graph_in_arena("bench graph", v, &dp, a);
+		for (i = 0; i < v; i++) {
+			g->ops->add_vertex(g, &ids[i]);
+		}
+		for (i = 0; i < e; i++) {
+			g->ops->add_wedge(g, &ids[rand() % v], &ids[rand() % v], i);
+		}
+		mid = bench_now_ns();
+		g->ops->destroy(g);
+		end = bench_now_ns();
+		printf("graph V %6d E %7d %-6s: build %9.2f ms (%6.1f ns/edge) destroy %6.2f ms\n",
+				v, e, (j == 0)? "scan" : "index", (mid - start) / 1e6,
+				(double)(mid - start) / e, (end - mid) / 1e6);
+	}
+
+	os_free(ids);
+}
+
+/*! @brief  
+ *   Edge insertion (with duplicate check), has_edge and vertex delete on
+ *   a dense graph, neigh list scan vs the per graph edge set
+ *  @return NA
+ */
+void bench_graph_edges()
+{
+	int i, use_set, *ids, V = 1000, E = 200000, Q = 200000;
+	t_dparams dp;
+	t_arena *a;
+	t_graph *g;
+	uint64_t start, add, query, del;
+
+	ids = os_alloc(V, sizeof(int));
+	for (i = 0; i < V; i++) {
+		ids[i] = i;
+	}
+
+	for (use_set = 0; use_set < 2; use_set++) {
+		init_data_params(&dp, eINT32);
+		dp.free = dummy_free;
+		srand(1);
+		a = create_arena("graph arena", 0);
+		g = create_graph_in_arena("bench graph", V, &dp, a);
+		graph_index_edges(g, use_set);
+		for (i = 0; i < V; i++) {
+			g->ops->add_vertex(g, &ids[i]);
+		}
+
+		// a has_edge miss in the neigh scan logs at INFO, keep it out of the timing
+		logger_set_level("LINK_LIST", __LOG_INFO__, false);
+		start = bench_now_ns();
+		for (i = 0; i < E; i++) {
+			g->ops->add_wedge(g, &ids[rand() % V], &ids[rand() % V], i);
+		}
+		add = bench_now_ns() - start;
+
+		start = bench_now_ns();
+		for (i = 0; i < Q; i++) {
+			g->ops->has_edge(g, &ids[rand() % V], &ids[rand() % V]);
+		}
+		query = bench_now_ns() - start;
+
+		start = bench_now_ns();
+		for (i = 0; i < V / 10; i++) {
+			g->ops->del_vertex(g, &ids[i]);
+		}
+		del = bench_now_ns() - start;
+		logger_set_level("LINK_LIST", __LOG_INFO__, true);
+
+		printf("graph V %d E %d (%d unique) %-10s: add_wedge %7.1f has_edge %7.1f ns/op "
+				"del_vertex %7.1f us/op\n", V, E, g->total_edges,
+				use_set ? "edge set" : "neigh scan", (double)add / E,
+				(double)query / Q, (double)del / (V / 10) / 1e3);
+		g->ops->destroy(g);
+	}
+
+	os_free(ids);
+}
+
+/*! @brief  
+ *   Traversals and shortest paths on the neigh lists of a graph vs on
+ *   its frozen csr snapshot, time of the freeze itself is included
+ *  @return NA
+ */
+void bench_graph_csr()
+{
+	int i, j, *ids, V = 100000, E = 500000;
+	char *names[] = {"bfs", "dfs", "dijkstra", "bellman_ford"};
+	t_dparams dp;
+	t_arena *a;
+	t_graph *g;
+	t_csr *c;
+	t_gen res;
+	uint64_t start, list_ns, csr_ns;
+
+	ids = os_alloc(V, sizeof(int));
+	for (i = 0; i < V; i++) {
+		ids[i] = i;
+	}
+
+	init_data_params(&dp, eINT32);
+	dp.free = dummy_free;
+	srand(1);
+	a = create_arena("graph arena", 0);
+	g = create_graph_in_arena("bench graph", V, &dp, a);
+	for (i = 0; i < V; i++) {
+		g->ops->add_vertex(g, &ids[i]);
+	}
+	for (i = 0; i < E; i++) {
+		g->ops->add_wedge(g, &ids[rand() % V], &ids[rand() % V], 1 + rand() % 100);
+	}
+
+	start = bench_now_ns();
+	c = graph_freeze(g);
+	printf("freeze V %d E %d: %8.2f ms\n", V, c->total_edges, (bench_now_ns() - start) / 1e6);
+
+	for (j = 0; j < 4; j++) {
+		start = bench_now_ns();
+		switch (j) {
+		case 0: res = g->ops->bfs(g, &ids[0]); break;
+		case 1: res = g->ops->dfs(g, &ids[0]); break;
+		case 2: res = dijkstra(g, &ids[0]); break;
+		default: res = bellman_ford(g, &ids[0]); break;
+		}
+		list_ns = bench_now_ns() - start;
+		free_mem(res);
+
+		start = bench_now_ns();
+		switch (j) {
+		case 0: res = c->ops->bfs(c, &ids[0]); break;
+		case 1: res = c->ops->dfs(c, &ids[0]); break;
+		case 2: res = csr_dijkstra(c, &ids[0]); break;
+		default: res = csr_bellman_ford(c, &ids[0]); break;
+		}
+		csr_ns = bench_now_ns() - start;
+		free_mem(res);
+
+		printf("%-12s: neigh list %8.2f ms csr %8.2f ms (%.1fx)\n", names[j],
+				list_ns / 1e6, csr_ns / 1e6, (double)list_ns / csr_ns);
+	}
+
+	c->ops->destroy(c);
+	g->ops->destroy(g);
+	os_free(ids);
+}
+
+/*! @brief  
+ *   Build a road network like grid graph, 4 neighbors with random
+ *   segment costs in an arena owned by the graph
+ *  @param W	- Vertices per side
+ *  @param ids	- Ids of the W * W vertices
+ *  @return 	- Pointer to graph
+ */
+static t_graph *bench_grid_graph(int W, int *ids)
+{
+	int x, y;
+	t_dparams dp;
+	t_graph *g;
+
+	init_data_params(&dp, eINT32);
+	dp.free = dummy_free;
+	srand(1);
+	g = create_graph_in_arena("grid graph", W * W, &dp, create_arena("grid arena", 0));
+	for (x = 0; x < W * W; x++) {
+		g->ops->add_vertex(g, &ids[x]);
+	}
+	for (y = 0; y < W; y++) {
+		for (x = 0; x < W; x++) {
+			if (x + 1 < W) {
+				g->ops->add_wedge_sym(g, &ids[y * W + x], &ids[y * W + x + 1], 1 + rand() % 1000);
+			}
+			if (y + 1 < W) {
+				g->ops->add_wedge_sym(g, &ids[y * W + x], &ids[(y + 1) * W + x], 1 + rand() % 1000);
+			}
+		}
+	}
+
+	return g;
+}
+
+/*! @brief  
+ *   Dijkstra on a road network like grid (4 neighbors, random segment
+ *   costs) with the binary heap vs the radix heap dijkstra picks for
+ *   non negative weights
+ *  @return NA
+ */
+void bench_dijkstra_grid()
+{
+	int i, x, *ids, W = 300, V = W * W, runs = 3;
+	t_graph *g;
+	t_distinfo *dist;
+	uint64_t start, heap_ns = UINT64_MAX, radix_ns = UINT64_MAX, ns;
+	long sum[2] = {0, 0};
+
+	ids = os_alloc(V, sizeof(int));
+	for (i = 0; i < V; i++) {
+		ids[i] = i;
+	}
+
+	g = bench_grid_graph(W, ids);
+
+	// min of runs, the sum of dists checks both agree
+	for (i = 0; i < runs; i++) {
+		start = bench_now_ns();
+		dist = dijkstra_heap(g, &ids[0]);
+		ns = bench_now_ns() - start;
+		heap_ns = (ns < heap_ns)? ns : heap_ns;
+		for (sum[0] = x = 0; x < V; x++) {
+			sum[0] += dist[x].edge.weight;
+		}
+		free_mem(dist);
+
+		start = bench_now_ns();
+		dist = dijkstra(g, &ids[0]);
+		ns = bench_now_ns() - start;
+		radix_ns = (ns < radix_ns)? ns : radix_ns;
+		for (sum[1] = x = 0; x < V; x++) {
+			sum[1] += dist[x].edge.weight;
+		}
+		free_mem(dist);
+	}
+
+	printf("grid %dx%d E %d: binary heap %8.2f ms radix heap %8.2f ms (%.1fx) dist sum %ld %ld\n",
+			W, W, g->total_edges, heap_ns / 1e6, radix_ns / 1e6,
+			(double)heap_ns / radix_ns, sum[0], sum[1]);
+
+	g->ops->destroy(g);
+	os_free(ids);
+}
+
+/*! @brief  
+ *   Binary vs 4-ary vs 8-ary heap layout on extract heavy work, heap
+ *   sort and insert/extract all of boxed ints (ptr per elem so the
+ *   children of a node span 16/32/64 bytes), dijkstra_heap and
+ *   prims_mst on a grid graph, min of runs
+ *  @return NA
+ */
+void bench_dary_heap()
+{
+	int i, j, k, *vals, *ids, N = 300000, W = 300, runs = 3;
+	e_heaptype types[] = {eMIN_HEAP, eMIN_HEAP4, eMIN_HEAP8};
+	char *names[] = {"binary", "4-ary", "8-ary"};
+	uint64_t start, ns, best[4];
+	t_dparams dp;
+	t_gen *arr;
+	t_heap *h;
+	t_graph *g;
+
+	vals = os_alloc(N, sizeof(int));
+	arr  = os_alloc(N, sizeof(t_gen));
+	ids  = os_alloc(W * W, sizeof(int));
+	srand(1);
+	for (i = 0; i < N; i++) {
+		vals[i] = rand();
+	}
+	for (i = 0; i < W * W; i++) {
+		ids[i] = i;
+	}
+	g = bench_grid_graph(W, ids);
+
+	init_data_params(&dp, eINT32);
+	dp.cmpr_idx = bench_boxed_cmpr_idx;
+	dp.swap_idx = gen_swp_idx;
+	dp.copy_idx = gen_cpy_idx;
+	dp.get_idx  = gen_get_idx;
+
+	for (j = 0; j < 3; j++) {
+		best[0] = best[1] = best[2] = best[3] = UINT64_MAX;
+		g->heap_type = types[j];
+		for (k = 0; k < runs; k++) {
+			for (i = 0; i < N; i++) {
+				arr[i] = &vals[i];
+			}
+			h = create_heap("bench heap", arr, N, types[j], &dp);
+			start = bench_now_ns();
+			h->sort(h);
+			ns = bench_now_ns() - start;
+			best[0] = (ns < best[0])? ns : best[0];
+
+			start = bench_now_ns();
+			for (i = 0; i < N; i++) {
+				h->insert(h, &vals[i]);
+			}
+			while (h->empty(h) != true) {
+				h->extract(h);
+			}
+			ns = bench_now_ns() - start;
+			best[1] = (ns < best[1])? ns : best[1];
+			h->destroy(h);
+
+			start = bench_now_ns();
+			free_mem(dijkstra_heap(g, &ids[0]));
+			ns = bench_now_ns() - start;
+			best[2] = (ns < best[2])? ns : best[2];
+
+			start = bench_now_ns();
+			free_mem(prims_mst(g));
+			ns = bench_now_ns() - start;
+			best[3] = (ns < best[3])? ns : best[3];
+		}
+		printf("%-6s: heap_sort %7.2f ms insert+extract %7.2f ms (N %d) "
+				"dijkstra_heap %6.2f ms prims_mst %6.2f ms (grid %dx%d)\n",
+				names[j], best[0] / 1e6, best[1] / 1e6, N,
+				best[2] / 1e6, best[3] / 1e6, W, W);
+	}
+
+	g->ops->destroy(g);
+	os_free(vals);
+	os_free(arr);
+	os_free(ids);
+}
+
+/*! @brief  
+ *   Array stack, queue and heap of inline ints filled past a 16 elem
+ *   create size with auto grow (and drained with shrink at 1/4) vs
+ *   created with the full size, min of runs
+ *  @return NA
+ */
+void bench_grow()
+{
+	int i, j, k, v, N = 1000000, runs = 3;
+	int init[] = {0, 16, 16};
+	char *names[] = {"presized", "grow", "grow+shrink"};
+	uint64_t start, ns, best[3];
+	t_dparams dp;
+	t_stack *s;
+	t_queue *q;
+	t_heap *h;
+	int *arr;
+
+	init_data_params(&dp, eINT32);
+	dp.elem_size = sizeof(int);
+	dp.free = dummy_free;
+
+	for (j = 0; j < 3; j++) {
+		best[0] = best[1] = best[2] = UINT64_MAX;
+		dp.auto_grow  = (j > 0);
+		dp.shrink_div = (j == 2)? 4 : 0;
+		for (k = 0; k < runs; k++) {
+			s = create_stack("bench stack", init[j]? init[j] : N, eARRAY_STACK, &dp);
+			start = bench_now_ns();
+			for (i = 0; i < N; i++) {
+				s->push(s, &i);
+			}
+			while (s->empty(s) != true) {
+				s->pop(s);
+			}
+			ns = bench_now_ns() - start;
+			best[0] = (ns < best[0])? ns : best[0];
+			s->destroy(s);
+
+			q = create_queue("bench queue", init[j]? init[j] : N, eARRAY_QUEUE_CIRC, &dp);
+			start = bench_now_ns();
+			for (i = 0; i < N; i++) {
+				q->enq(q, &i);
+			}
+			while (q->empty(q) != true) {
+				q->deq(q);
+			}
+			ns = bench_now_ns() - start;
+			best[1] = (ns < best[1])? ns : best[1];
+			q->destroy(q);
+
+			arr = get_mem(init[j]? init[j] : N, sizeof(int));
+			h = create_heap("bench heap", arr, init[j]? init[j] : N, eMIN_HEAP, &dp);
+			start = bench_now_ns();
+			for (i = 0; i < N; i++) {
+				v = N - i;
+				h->insert(h, &v);
+			}
+			while (h->empty(h) != true) {
+				h->extract(h);
+			}
+			ns = bench_now_ns() - start;
+			best[2] = (ns < best[2])? ns : best[2];
+			h->destroy(h);
+			free_mem(arr);
+		}
+		printf("%-11s: stack %6.1f ns/op queue %6.1f ns/op heap %6.1f ns/op (N %d)\n",
+				names[j], best[0] / (2.0 * N), best[1] / (2.0 * N),
+				best[2] / (2.0 * N), N);
+	}
+}
+
+/*! @brief  
+ *   Mixed insert, decrease key and extract ops on an indexed array heap
+ *   or a pairing heap, elem i is keys[i] held by pointer
+ *  @param hp      - Pointer to the heap
+ *  @param pairing - true if hp is a pairing heap
+ *  @param keys    - Keys of elems, lowered in place on decrease key
+ *  @param N       - Elems inserted in all
+ *  @return        - time taken in ns
+ */
+static uint64_t bench_heap_mixed(t_gen hp, bool pairing, int *keys, int N)
+{
+	t_heap *h = (t_heap*)hp;
+	t_pairing_heap *ph = (t_pairing_heap*)hp;
+	int i, j, r, next = 0, nlive = 0;
+	int *live = os_alloc(N, sizeof(int));
+	int *where = os_alloc(N, sizeof(int));
+	t_gen *nodes = os_alloc(N, sizeof(t_gen));
+	uint64_t start, ns;
+	t_gen data;
+
+	srand(7);
+	start = bench_now_ns();
+	while (next < N || nlive > 0) {
+		r = rand() % 4;
+		if (next < N && (r < 2 || nlive == 0)) {
+			// insert next elem
+			keys[next] = rand() % N;
+			if (pairing) {
+				nodes[next] = ph->insert(ph, &keys[next]);
+			} else {
+				h->insert_handle(h, next, &keys[next]);
+			}
+			live[nlive] = next;
+			where[next] = nlive++;
+			next++;
+		} else if (r == 2 && nlive > 0) {
+			// lower key of a live elem
+			i = live[rand() % nlive];
+			keys[i] -= rand() % 64 + 1;
+			if (pairing) {
+				ph->decrease_key(ph, nodes[i], NULL);
+			} else {
+				h->decrease_key(h, i, &keys[i]);
+			}
+		} else if (nlive > 0) {
+			data = (pairing)? ph->extract(ph) : h->extract(h);
+			i = (int*)data - keys;
+			j = where[i];
+			live[j] = live[--nlive];
+			where[live[j]] = j;
+		}
+	}
+	ns = bench_now_ns() - start;
+
+	os_free(live);
+	os_free(where);
+	os_free(nodes);
+	return ns;
+}
+
+/*! @brief  
+ *   Pairing heap vs array heap (binary, elems by pointer), min of runs
+ *   of insert + extract all, a mixed insert / decrease key / extract
+ *   workload on the indexed heap and the meld of W heaps into one
+ *   (array heaps merged by extract + insert)
+ *  @return NA
+ */
+void bench_pairing_heap()
+{
+	int i, j, k, *keys, N = 200000, W = 64, runs = 3;
+	uint64_t start, ns, best[6];
+	t_pairing_heap *ph, *pw[64];
+	t_heap *h, *hw[64];
+	t_gen *arr, *warr;
+	t_dparams dp;
+
+	keys = os_alloc(N, sizeof(int));
+	arr  = os_alloc(N, sizeof(t_gen));
+	warr = os_alloc(N, sizeof(t_gen));
+	init_data_params(&dp, eINT32);
+	dp.cmpr_idx = bench_boxed_cmpr_idx;
+	dp.swap_idx = gen_swp_idx;
+	dp.copy_idx = gen_cpy_idx;
+	dp.get_idx  = gen_get_idx;
+
+	for (k = 0; k < 6; k++) {
+		best[k] = UINT64_MAX;
+	}
+	for (k = 0; k < runs; k++) {
+		srand(1);
+		for (i = 0; i < N; i++) {
+			keys[i] = rand();
+		}
+
+		// insert all then extract all
+		h = create_heap("bench heap", arr, N, eMIN_HEAP, &dp);
+		start = bench_now_ns();
+		for (i = 0; i < N; i++) {
+			h->insert(h, &keys[i]);
+		}
+		while (h->empty(h) != true) {
+			h->extract(h);
+		}
+		ns = bench_now_ns() - start;
+		best[0] = (ns < best[0])? ns : best[0];
+		h->destroy(h);
+
+		ph = create_pairing_heap("bench pairing", eMIN_HEAP, &dp);
+		start = bench_now_ns();
+		for (i = 0; i < N; i++) {
+			ph->insert(ph, &keys[i]);
+		}
+		while (ph->empty(ph) != true) {
+			ph->extract(ph);
+		}
+		ns = bench_now_ns() - start;
+		best[1] = (ns < best[1])? ns : best[1];
+		ph->destroy(ph);
+
+		// mixed ops with decrease key
+		h = create_indexed_heap("bench heap", arr, N, eMIN_HEAP, &dp);
+		ns = bench_heap_mixed(h, false, keys, N);
+		best[2] = (ns < best[2])? ns : best[2];
+		h->destroy(h);
+
+		ph = create_pairing_heap("bench pairing", eMIN_HEAP, &dp);
+		ns = bench_heap_mixed(ph, true, keys, N);
+		best[3] = (ns < best[3])? ns : best[3];
+		ph->destroy(ph);
+
+		// W heaps of N / W elems melded into the first
+		for (j = 0; j < W; j++) {
+			hw[j] = create_heap("bench heap", (j == 0)? arr : warr + j * (N / W),
+					(j == 0)? N : N / W, eMIN_HEAP, &dp);
+			pw[j] = create_pairing_heap("bench pairing", eMIN_HEAP, &dp);
+			for (i = j * (N / W); i < (j + 1) * (N / W); i++) {
+				hw[j]->insert(hw[j], &keys[i]);
+				pw[j]->insert(pw[j], &keys[i]);
+			}
+		}
+		start = bench_now_ns();
+		for (j = 1; j < W; j++) {
+			while (hw[j]->empty(hw[j]) != true) {
+				hw[0]->insert(hw[0], hw[j]->extract(hw[j]));
+			}
+		}
+		ns = bench_now_ns() - start;
+		best[4] = (ns < best[4])? ns : best[4];
+
+		start = bench_now_ns();
+		for (j = 1; j < W; j++) {
+			pw[0]->meld(pw[0], pw[j]);
+		}
+		ns = bench_now_ns() - start;
+		best[5] = (ns < best[5])? ns : best[5];
+
+		for (j = 0; j < W; j++) {
+			hw[j]->destroy(hw[j]);
+			pw[j]->destroy(pw[j]);
+		}
+	}
+
+	printf("insert+extract: array %7.2f ms pairing %7.2f ms (N %d)\n",
+			best[0] / 1e6, best[1] / 1e6, N);
+	printf("mixed ins/dec/ext: array %7.2f ms pairing %7.2f ms (N %d)\n",
+			best[2] / 1e6, best[3] / 1e6, N);
+	printf("meld %d heaps: array %7.2f ms pairing %7.3f ms (N %d)\n",
+			W, best[4] / 1e6, best[5] / 1e6, N);
+
+	os_free(keys);
+	os_free(arr);
+	os_free(warr);
+}
+
+/*! @brief  
+ *   Top k = 1000 of N random ints by full heap sort, heap_top_k,
+ *   nth_element and streaming top k, and nth_element on N equal ints,
+ *   min of runs
+ *  @return NA
+ */
+void bench_top_k()
+{
+	int i, k, *vals, *arr, N = 2000000, K = 1000, runs = 3;
+	uint64_t start, ns, best[5];
+	t_dparams dp, dpi;
+	t_heap *h;
+	t_top_k *t;
+
+	vals = os_alloc(N, sizeof(int));
+	arr  = os_alloc(N, sizeof(int));
+	srand(1);
+	for (i = 0; i < N; i++) {
+		vals[i] = rand();
+	}
+	init_data_params(&dp, eINT32);
+	init_data_params(&dpi, eINT32);
+	dpi.elem_size = sizeof(int);
+
+	for (i = 0; i < 5; i++) {
+		best[i] = UINT64_MAX;
+	}
+	for (k = 0; k < runs; k++) {
+		memcpy(arr, vals, N * sizeof(int));
+		h = create_heap("bench heap", arr, N, eMIN_HEAP, &dp);
+		start = bench_now_ns();
+		h->sort(h);
+		ns = bench_now_ns() - start;
+		best[0] = (ns < best[0])? ns : best[0];
+		h->destroy(h);
+
+		memcpy(arr, vals, N * sizeof(int));
+		start = bench_now_ns();
+		heap_top_k(arr, N, K, &dp);
+		ns = bench_now_ns() - start;
+		best[1] = (ns < best[1])? ns : best[1];
+
+		memcpy(arr, vals, N * sizeof(int));
+		start = bench_now_ns();
+		nth_element(arr, N, N - K, &dp);
+		ns = bench_now_ns() - start;
+		best[2] = (ns < best[2])? ns : best[2];
+
+		t = create_top_k("bench top k", K, &dpi);
+		start = bench_now_ns();
+		for (i = 0; i < N; i++) {
+			t->add(t, &vals[i]);
+		}
+		free_mem(t->result(t));
+		ns = bench_now_ns() - start;
+		best[3] = (ns < best[3])? ns : best[3];
+		t->destroy(t);
+
+		for (i = 0; i < N; i++) {
+			arr[i] = 7;
+		}
+		start = bench_now_ns();
+		nth_element(arr, N, N / 2, &dp);
+		ns = bench_now_ns() - start;
+		best[4] = (ns < best[4])? ns : best[4];
+	}
+
+	printf("top %d of %d: heap_sort %7.2f ms heap_top_k %6.2f ms nth_element %6.2f ms "
+			"streaming %6.2f ms\n", K, N, best[0] / 1e6, best[1] / 1e6,
+			best[2] / 1e6, best[3] / 1e6);
+	printf("nth_element on %d equal keys %6.2f ms\n", N, best[4] / 1e6);
+
+	os_free(vals);
+	os_free(arr);
+}
@@ -0,0 +1,1047 @@
+/*! @file check.c
+    @brief
+    Contains deterministic correctness checks of data structure operations,
+    each result is compared against a plain reference (a brute force scan,
+    a full sort or the list based graph algorithm) and a mismatch is logged
+    with the check and line it failed at
+*/
+
+#include "common.h"
+#include "slab_allocator.h"
+#include "link_list.h"
+#include "stack.h"
+#include "queue.h"
+#include "heap.h"
+#include "tree.h"
+#include "graph.h"
+#include "array.h"
+#include "hash_map.h"
+
+/// Count a failed check and log where it failed, later checks still run
+#define CHECK(cond, fmt, args...)						\
+	do {									\
+		if (!(cond)) {							\
+			check_failed++;						\
+			LOG_ERROR("CHECK", "%s:%d " fmt, __func__, __LINE__, ##args);	\
+		}								\
+	} while (0)
+
+#define CHECK_GRAPH_SIZE	300	///< Max vertices of the random graphs checked
+
+static int check_failed;		///< Checks failed so far
+
+void check_slab();
+void check_arena();
+void check_inline();
+void check_hash_map();
+void check_graph_index();
+void check_graph_csr();
+void check_indexed_heap();
+void check_radix_heap();
+void check_dijkstra_bounds();
+void check_dary_heap();
+void check_grow();
+void check_pairing_heap();
+void check_top_k();
+
+/*! @brief
+ *   Run all correctness checks
+ *  @return 	- Count of failed checks, 0 if all passed
+ */
+int run_checks()
+{
+	check_failed = 0;
+
+	// missing elems are looked up on purpose and random graphs have
+	// isolated vertices with empty neigh lists, keep those logs out
+	logger_set_level("LINK_LIST", __LOG_WARN__, false);
+	logger_set_level("LINK_LIST", __LOG_INFO__, false);
+	logger_set_level("HASH_MAP", __LOG_INFO__, false);
+
+	check_slab();
+	check_arena();
+	check_inline();
+	check_hash_map();
+	check_graph_index();
+	check_graph_csr();
+	check_indexed_heap();
+	check_radix_heap();
+	check_dijkstra_bounds();
+	check_dary_heap();
+	check_grow();
+	check_pairing_heap();
+	check_top_k();
+
+	logger_set_level("LINK_LIST", __LOG_WARN__, true);
+	logger_set_level("LINK_LIST", __LOG_INFO__, true);
+	logger_set_level("HASH_MAP", __LOG_INFO__, true);
+
+	printf("checks failed = %d\n", check_failed);
+
+	return check_failed;
+}
+
+/*! @brief
+ *   Check slab allocs whose nmemb * size overflows fail as calloc does,
+ *   a product wrapping to a small class size included
+ *  @return NA
+ */
+void check_slab()
+{
+	CHECK(slab_alloc(((size_t)1 << (sizeof(size_t) * 8 - 1)) + 1, 2) == NULL, "wrapped small alloc\n");
+	CHECK(slab_alloc(SIZE_MAX / 3, 4) == NULL, "wrapped large alloc\n");
+	CHECK(slab_alloc(SIZE_MAX, 1) == NULL, "alloc past header room\n");
+}
+
+/*! @brief
+ *   Check arena allocs are aligned, zeroed, span chunks and survive a merge,
+ *   and a tree in an arena keeps its keys till destroy releases the arena
+ *  @return NA
+ */
+void check_arena()
+{
+	int keys[64], i, j, dirty;
+	t_tree_node *node;
+	t_dparams dp;
+	t_arena *a, *b;
+	size_t total;
+	t_tree *t;
+	char *p;
+
+	a = create_arena("check arena a", 1024);
+	b = create_arena("check arena b", 1024);
+
+	// sizes grow past the chunk size, those get a chunk of their own
+	for (i = 1; i <= 200; i++) {
+		p = arena_alloc((i % 2)? a : b, i, 7);
+		CHECK(((uintptr_t)p % ARENA_ALIGN) == 0, "alloc %d not aligned\n", i);
+		for (j = 0, dirty = 0; j < i * 7; j++) {
+			dirty |= p[j];
+		}
+		CHECK(dirty == 0, "alloc %d not zeroed\n", i);
+		memset(p, 0xa5, i * 7);
+	}
+
+	// merge moves all chunks of b, both stay usable
+	total = a->total + b->total;
+	arena_merge(a, b);
+	CHECK(a->total == total, "merged total %zu expected %zu\n", a->total, total);
+	CHECK(b->chunk == NULL && b->tail == NULL && b->total == 0, "merged arena not empty\n");
+	CHECK(a->tail != NULL && a->tail->nxt == NULL, "merged arena tail not last chunk\n");
+
+	p = arena_alloc(b, 1, 64);
+	CHECK(p != NULL && ((uintptr_t)p % ARENA_ALIGN) == 0, "alloc after merge not aligned\n");
+	p = arena_alloc(a, 1, 64);
+	CHECK(p != NULL && p[0] == 0 && p[63] == 0, "alloc after merge not zeroed\n");
+
+	// merge into an arena of one chunk and from an empty one
+	total = a->total + b->total;
+	arena_merge(b, a);
+	arena_merge(b, a);
+	CHECK(b->total == total, "merged total %zu expected %zu\n", b->total, total);
+
+	// a wrapped nmemb * size or round up fails, the arena stays usable
+	logger_set_level("ARENA", __LOG_ERROR__, false);
+	CHECK(arena_alloc(a, ((size_t)1 << (sizeof(size_t) * 8 - 1)) + 1, 2) == NULL, "wrapped alloc\n");
+	CHECK(arena_alloc(a, SIZE_MAX - 3, 1) == NULL, "wrapped round up\n");
+	logger_set_level("ARENA", __LOG_ERROR__, true);
+	total = a->total;
+	p = arena_alloc(a, 1, 16);
+	CHECK(p != NULL && a->total == total + 16, "alloc after overflow\n");
+	destroy_arena(a);
+	destroy_arena(b);
+
+	// deleted nodes stay in the arena, the tree owns the arena
+	init_data_params(&dp, eINT32);
+	dp.free = dummy_free;
+	t = create_tree_in_arena("check arena tree", eAVL, &dp, create_arena("check tree arena", 1024));
+	for (i = 0; i < 64; i++) {
+		keys[i] = (i * 37) % 64;
+		t->insert(t, &keys[i]);
+	}
+	for (i = 0; i < 64; i += 2) {
+		t->del(t, &keys[i]);
+	}
+	for (i = 0; i < 64; i++) {
+		node = t->find(t, &keys[i]);
+		CHECK((node != NULL) == (i % 2 == 1), "tree find key %d\n", keys[i]);
+		CHECK(node == NULL || node->key == &keys[i], "tree key %d\n", keys[i]);
+	}
+	t->destroy(t);
+}
+
+/*! @brief
+ *   Check containers holding elems inline keep a copy of the elem
+ *  @return NA
+ */
+void check_inline()
+{
+	e_stacktype stypes[] = {eLL_STACK, eARRAY_STACK, eARRAY_STACK_DOWN};
+	e_queuetype qtypes[] = {eLL_QUEUE_CIRC, eARRAY_QUEUE_CIRC};
+	e_lltype ltypes[] = {eSINGLE_LINKLIST, eDOUBLE_LINKLIST, eSINGLE_CIRCULAR_LINKLIST,
+				eDOUBLE_CIRCULAR_LINKLIST, eXOR_LINKLIST};
+	e_treetype ttypes[] = {eBST, eAVL};
+	t_dparams dp;
+	t_stack *s;
+	t_queue *q;
+	t_linklist *l;
+	t_tree *t;
+	t_tree_node *node;
+	int i, j, v;
+
+	init_data_params(&dp, eINT32);
+	dp.elem_size = sizeof(int);
+
+	// the same local is pushed each time, only a copy keeps the value
+	for (j = 0; j < 3; j++) {
+		s = create_stack("check inline stack", 64, stypes[j], &dp);
+		for (i = 0; i < 50; i++) {
+			v = i * 3;
+			s->push(s, &v);
+		}
+		for (i = 49; i >= 0; i--) {
+			v = *(int*)s->pop(s);
+			CHECK(v == i * 3, "stack type %d popped %d expected %d\n", stypes[j], v, i * 3);
+		}
+		s->destroy(s);
+	}
+
+	for (j = 0; j < 2; j++) {
+		q = create_queue("check inline queue", 64, qtypes[j], &dp);
+		for (i = 0; i < 50; i++) {
+			v = i * 3;
+			q->enq(q, &v);
+		}
+		for (i = 0; i < 50; i++) {
+			v = *(int*)q->deq(q);
+			CHECK(v == i * 3, "queue type %d dequeued %d expected %d\n", qtypes[j], v, i * 3);
+		}
+		q->destroy(q);
+	}
+
+	for (j = 0; j < 5; j++) {
+		l = create_link_list("check inline list", ltypes[j], &dp);
+		for (i = 0; i < 50; i++) {
+			v = i;
+			l->ops->append(l, &v);
+		}
+		for (i = 0; i < 50; i++) {
+			v = *(int*)l->ops->get_node_data(l->ops->get_idx(l, i));
+			CHECK(v == i, "list type %d elem %d is %d\n", ltypes[j], i, v);
+		}
+		for (i = 0; i < 50; i += 2) {
+			v = i;
+			CHECK(*(int*)l->ops->del(l, &v) == i, "list type %d del %d\n", ltypes[j], i);
+			CHECK(l->ops->find(l, &v) == NULL, "list type %d found deleted %d\n", ltypes[j], i);
+		}
+		CHECK(l->ops->len(l) == 25, "list type %d len %d\n", ltypes[j], l->ops->len(l));
+		l->ops->destroy(l);
+	}
+
+	// keys in a permutation order, 37 is coprime to 64
+	for (j = 0; j < 2; j++) {
+		t = create_tree("check inline tree", ttypes[j], &dp);
+		for (i = 0; i < 64; i++) {
+			v = (i * 37) % 64;
+			t->insert(t, &v);
+		}
+		node = t->min(t->root);
+		CHECK(node != NULL && *(int*)node->key == 0, "tree type %d min\n", ttypes[j]);
+		for (i = 0; i < 64; i += 2) {
+			v = i;
+			CHECK(*(int*)t->del(t, &v) == i, "tree type %d del %d\n", ttypes[j], i);
+		}
+		for (i = 0; i < 64; i++) {
+			v = i;
+			node = t->find(t, &v);
+			CHECK((node != NULL) == (i % 2 == 1), "tree type %d find %d\n", ttypes[j], i);
+			CHECK(node == NULL || *(int*)node->key == i, "tree type %d key %d\n", ttypes[j], i);
+		}
+		t->destroy(t);
+	}
+}
+
+/*! @brief
+ *   Check hash map insert, find, del and reinsert across resizes
+ *  @return NA
+ */
+void check_hash_map()
+{
+	t_hash_map *m;
+	t_dparams dp;
+	t_gen *val, key, v;
+	int i, k, n = 3000, idx, seen;
+
+	// keys step by 3, so key + 1 is never present
+	init_data_params(&dp, eINT32);
+	dp.elem_size = sizeof(int);
+	m = create_hash_map("check map", 8, &dp);
+
+	// the first half grows the map from one group
+	for (i = 0; i < n / 2; i++) {
+		k = i * 3 - 1000;
+		m->insert(m, &k, (t_gen)(intptr_t)(i + 1));
+	}
+	CHECK(m->len(m) == n / 2, "len %d expected %d\n", m->len(m), n / 2);
+
+	for (i = 0; i < n / 2; i++) {
+		k = i * 3 - 1000;
+		val = m->find(m, &k);
+		CHECK(val != NULL && *val == (t_gen)(intptr_t)(i + 1), "find key %d\n", k);
+		k++;
+		CHECK(m->find(m, &k) == NULL, "found absent key %d\n", k);
+	}
+
+	// deleted slots are left behind as tombstones
+	for (i = 0; i < n / 2; i += 3) {
+		k = i * 3 - 1000;
+		v = m->del(m, &k);
+		CHECK(v == (t_gen)(intptr_t)(i + 1), "del key %d\n", k);
+		CHECK(m->find(m, &k) == NULL, "found deleted key %d\n", k);
+		CHECK(m->del(m, &k) == NULL, "deleted key %d twice\n", k);
+	}
+
+	// reinsert the deleted keys negated, then the second half resizes again
+	for (i = 0; i < n / 2; i += 3) {
+		k = i * 3 - 1000;
+		m->insert(m, &k, (t_gen)(intptr_t)(-(i + 1)));
+	}
+	for (i = n / 2; i < n; i++) {
+		k = i * 3 - 1000;
+		m->insert(m, &k, (t_gen)(intptr_t)(i + 1));
+	}
+
+	// insert of a present key replaces its value
+	k = -1000;
+	m->insert(m, &k, (t_gen)(intptr_t)(-1));
+	CHECK(m->len(m) == n, "len %d expected %d\n", m->len(m), n);
+
+	for (i = 0; i < n; i++) {
+		k = i * 3 - 1000;
+		val = m->find(m, &k);
+		v = (t_gen)(intptr_t)((i < n / 2 && i % 3 == 0)? -(i + 1) : i + 1);
+		CHECK(val != NULL && *val == v, "find key %d after resize\n", k);
+	}
+
+	// every elem is visited once
+	seen = 0;
+	for (idx = m->next(m, -1, &key, &v); idx >= 0; idx = m->next(m, idx, &key, &v)) {
+		k = *(int*)key;
+		i = (k + 1000) / 3;
+		CHECK(i >= 0 && i < n && (k + 1000) % 3 == 0, "iterated absent key %d\n", k);
+		CHECK(v == (t_gen)(intptr_t)((i < n / 2 && i % 3 == 0)? -(i + 1) : i + 1),
+			"iterated key %d value\n", k);
+		seen++;
+	}
+	CHECK(seen == n, "iterated %d expected %d\n", seen, n);
+
+	m->destroy(m);
+}
+
+/*! @brief
+ *   Check a graph with vertex index and edge set against one scanning lists,
+ *   after the same random adds and deletes of edges and vertices
+ *  @return NA
+ */
+void check_graph_index()
+{
+	int ids[CHECK_GRAPH_SIZE], i, x, y, w, n = 64;
+	bool gone[CHECK_GRAPH_SIZE] = {false};
+	t_graph *g1, *g2;
+	t_gnode *n1, *n2;
+	t_dparams dp;
+
+	srand(17);
+	init_data_params(&dp, eINT32);
+	dp.free = dummy_free;
+	g1 = create_graph("check indexed graph", n, &dp);
+	graph_index_edges(g1, true);
+	dp.hash = NULL;
+	g2 = create_graph("check scan graph", n, &dp);
+	CHECK(g1->index != NULL && g1->edges != NULL, "indexed graph without index\n");
+	CHECK(g2->index == NULL && g2->edges == NULL, "scan graph with index\n");
+
+	for (i = 0; i < n; i++) {
+		ids[i] = i;
+		g1->ops->add_vertex(g1, &ids[i]);
+		g2->ops->add_vertex(g2, &ids[i]);
+	}
+
+	for (i = 0; i < 3000; i++) {
+		x = rand() % n;
+		y = rand() % n;
+		if (gone[x] || gone[y]) {
+			continue;
+		}
+		if (rand() % 3) {
+			w = rand() % 100;
+			g1->ops->add_wedge(g1, &ids[x], &ids[y], w);
+			g2->ops->add_wedge(g2, &ids[x], &ids[y], w);
+		} else if (g2->ops->has_edge(g2, &ids[x], &ids[y]) != NULL) {
+			g1->ops->del_edge(g1, &ids[x], &ids[y]);
+			g2->ops->del_edge(g2, &ids[x], &ids[y]);
+		}
+		// deleting a vertex moves the last vertex to its idx
+		if (i % 300 == 299) {
+			g1->ops->del_vertex(g1, &ids[x]);
+			g2->ops->del_vertex(g2, &ids[x]);
+			gone[x] = true;
+		}
+	}
+
+	CHECK(g1->count == g2->count, "vertices %d vs %d\n", g1->count, g2->count);
+	CHECK(g1->total_edges == g2->total_edges, "edges %d vs %d\n", g1->total_edges, g2->total_edges);
+
+	for (x = 0; x < n; x++) {
+		n1 = g1->ops->find(g1, &ids[x]);
+		n2 = g2->ops->find(g2, &ids[x]);
+		CHECK((n1 == NULL) == gone[x] && (n2 == NULL) == gone[x], "find vertex %d\n", x);
+		CHECK(n1 == NULL || (*(int*)n1->id == x && &g1->nodes[n1->idx] == n1),
+			"index of vertex %d\n", x);
+		if (gone[x]) {
+			continue;
+		}
+		for (y = 0; y < n; y++) {
+			if (gone[y]) {
+				continue;
+			}
+			CHECK((g1->ops->has_edge(g1, &ids[x], &ids[y]) != NULL) ==
+				(g2->ops->has_edge(g2, &ids[x], &ids[y]) != NULL), "edge %d to %d\n", x, y);
+		}
+	}
+
+	g1->ops->destroy(g1);
+	g2->ops->destroy(g2);
+}
+
+/*! @brief
+ *   Check the csr algorithms against the list based ones on random graphs,
+ *   radix heap dijkstra against heap dijkstra on every d-ary heap layout,
+ *   and the parents of dijkstra and prim lead back to their source
+ *  @return NA
+ */
+void check_graph_csr()
+{
+	e_heaptype htypes[] = {eMIN_HEAP, eMIN_HEAP4, eMIN_HEAP8};
+	int ids[CHECK_GRAPH_SIZE], i, j, h, t, n, m, s, x, y, p;
+	long wk1, wk2, wkc, wp;
+	t_bfsinfo *b1, *b2;
+	t_dfsinfo *d2;
+	t_distinfo *x1, *x2, *x3, *k1, *k2;
+	t_daginfo *a1, *a2;
+	t_dparams dp;
+	t_graph *g;
+	t_csr *c;
+
+	for (i = 0; i < CHECK_GRAPH_SIZE; i++) {
+		ids[i] = i;
+	}
+
+	// even rounds are weighted DAGs, odd rounds undirected graphs
+	for (t = 0; t < 12; t++) {
+		srand(t);
+		init_data_params(&dp, eINT32);
+		dp.free = dummy_free;
+		g = create_graph("check csr graph", CHECK_GRAPH_SIZE, &dp);
+		n = 50 + rand() % (CHECK_GRAPH_SIZE - 50);
+		m = rand() % (4 * n);
+		for (i = 0; i < n; i++) {
+			g->ops->add_vertex(g, &ids[i]);
+		}
+		for (i = 0; i < m; i++) {
+			x = rand() % n;
+			y = rand() % n;
+			if (t % 2) {
+				g->ops->add_wedge_sym(g, &ids[x], &ids[y], 1 + rand() % 100);
+			} else if (x < y) {
+				g->ops->add_wedge(g, &ids[x], &ids[y], rand() % 100);
+			}
+		}
+		c = graph_freeze(g);
+		s = rand() % n;
+
+		b1 = g->ops->bfs(g, &ids[s]);
+		b2 = c->ops->bfs(c, &ids[s]);
+		for (i = 0; i < n; i++) {
+			CHECK(b1[i].level == b2[i].level && b1[i].parent == b2[i].parent &&
+				b1[i].comp == b2[i].comp, "round %d bfs vertex %d\n", t, i);
+		}
+		free_mem(b1);
+		free_mem(b2);
+
+		// visit order follows the neigh lists, so only the intervals are checked
+		d2 = c->ops->dfs(c, &ids[s]);
+		for (i = 0; i < n; i++) {
+			if (d2[i].parent != NULL) {
+				p = *(int*)d2[i].parent;
+				CHECK(d2[p].pre < d2[i].pre && d2[i].post < d2[p].post,
+					"round %d dfs vertex %d not in parent interval\n", t, i);
+			}
+		}
+		free_mem(d2);
+
+		// no negative weights, dijkstra takes the radix heap
+		x1 = dijkstra(g, &ids[s]);
+		x2 = csr_dijkstra(c, &ids[s]);
+		for (i = 0; i < n; i++) {
+			CHECK(x1[i].edge.weight == x2[i].edge.weight, "round %d csr dijkstra vertex %d\n", t, i);
+		}
+		free_mem(x2);
+
+		for (h = 0; h < 3; h++) {
+			g->heap_type = htypes[h];
+			x2 = dijkstra_heap(g, &ids[s]);
+			for (i = 0; i < n; i++) {
+				CHECK(x1[i].edge.weight == x2[i].edge.weight,
+					"round %d heap type %d dijkstra vertex %d\n", t, htypes[h], i);
+			}
+			free_mem(x2);
+		}
+
+		// a parent cycle never reaches the source
+		for (i = 0; i < n; i++) {
+			for (p = i, j = 0; x1[p].parent != NULL && j < n; j++) {
+				p = x1[p].parent->idx;
+			}
+			CHECK(x1[i].edge.weight == INT_MAX || p == s, "round %d dijkstra path of vertex %d\n", t, i);
+		}
+
+		x2 = bellman_ford(g, &ids[s]);
+		x3 = csr_bellman_ford(c, &ids[s]);
+		for (i = 0; i < n; i++) {
+			CHECK(x1[i].edge.weight == x2[i].edge.weight && x2[i].edge.weight == x3[i].edge.weight,
+				"round %d bellman ford vertex %d\n", t, i);
+		}
+		free_mem(x1);
+		free_mem(x2);
+		free_mem(x3);
+
+		if (t % 2 == 0) {
+			a1 = g->ops->topo_order_dag(g);
+			a2 = c->ops->topo_order_dag(c);
+			for (i = 0; i < n; i++) {
+				CHECK(a1[i].node == a2[i].node && a1[i].longest_path == a2[i].longest_path,
+					"round %d topo order %d\n", t, i);
+			}
+			free_mem(a1);
+			free_mem(a2);
+		} else {
+			// trees may differ on equal weights, their weights may not
+			k1 = kruskals_mst(g);
+			k2 = csr_kruskals_mst(c);
+			for (i = 0, wk1 = 0, wk2 = 0; i < n; i++) {
+				wk1 += (k1[i].parent != NULL)? k1[i].edge.weight : 0;
+				wk2 += (k2[i].parent != NULL)? k2[i].edge.weight : 0;
+			}
+			CHECK(wk1 == wk2, "round %d kruskal weight %ld vs %ld\n", t, wk1, wk2);
+			free_mem(k2);
+
+			// prim spans the component of the first vertex only, so it weighs
+			// as the kruskal forest edges (a list of edges) within that component
+			k2 = csr_prims_mst(c);
+			for (i = 0, wp = 0, wkc = 0; i < n; i++) {
+				wp += (k2[i].edge.weight != INT_MAX)? k2[i].edge.weight : 0;
+				if (k1[i].parent != NULL && k2[k1[i].parent->idx].edge.weight != INT_MAX) {
+					wkc += k1[i].edge.weight;
+				}
+			}
+			CHECK(wp == wkc, "round %d prim weight %ld kruskal %ld\n", t, wp, wkc);
+			free_mem(k1);
+
+			// list and csr prim may pick other trees on equal weights, not other weights
+			for (h = 0; h < 3; h++) {
+				g->heap_type = htypes[h];
+				k1 = prims_mst(g);
+				for (i = 0, wkc = 0; i < n; i++) {
+					CHECK((k1[i].edge.weight == INT_MAX) == (k2[i].edge.weight == INT_MAX),
+						"round %d heap type %d prim reach vertex %d\n", t, htypes[h], i);
+					wkc += (k1[i].edge.weight != INT_MAX)? k1[i].edge.weight : 0;
+					for (p = i, j = 0; k1[p].parent != NULL && j < n; j++) {
+						CHECK(g->ops->has_edge(g, k1[p].parent->id, g->nodes[p].id) != NULL,
+							"round %d prim edge of vertex %d\n", t, p);
+						p = k1[p].parent->idx;
+					}
+					CHECK(k1[i].edge.weight == INT_MAX || p == 0,
+						"round %d prim path of vertex %d\n", t, i);
+				}
+				CHECK(wp == wkc, "round %d heap type %d prim weight %ld vs %ld\n",
+					t, htypes[h], wkc, wp);
+				free_mem(k1);
+			}
+			free_mem(k2);
+		}
+
+		c->ops->destroy(c);
+		g->ops->destroy(g);
+	}
+}
+
+/*! @brief
+ *   Check indexed heap extract and decrease key against a brute force min
+ *  @return NA
+ */
+void check_indexed_heap()
+{
+	int keys[256], *data, i, j, r, hd, best, n = 256;
+	bool in[256] = {false};
+	t_dparams dp;
+	t_heap *h;
+
+	srand(3);
+	init_data_params(&dp, eINT32);
+	dp.elem_size = sizeof(int);
+	data = get_mem(n, sizeof(int));
+	h = create_indexed_heap("check indexed heap", data, n, eMIN_HEAP, &dp);
+
+	for (j = 0; j < 5000; j++) {
+		r = rand() % 4;
+		i = rand() % n;
+		if (r < 2 && in[i] == false) {
+			keys[i] = rand() % 10000;
+			CHECK(h->insert_handle(h, i, &keys[i]), "insert handle %d\n", i);
+			in[i] = true;
+		} else if (r == 2 && in[i]) {
+			keys[i] -= rand() % 100;
+			CHECK(h->decrease_key(h, i, &keys[i]), "decrease key handle %d\n", i);
+		} else if (r == 3 && h->count) {
+			for (i = 0, best = INT_MAX; i < n; i++) {
+				best = (in[i] && keys[i] < best)? keys[i] : best;
+			}
+			r = *(int*)h->extract(h);
+			hd = h->handles[h->count];
+			CHECK(in[hd] && r == keys[hd] && r == best, "extract %d expected %d\n", r, best);
+			CHECK(h->pos[hd] == -1, "extracted handle %d still in heap\n", hd);
+			in[hd] = false;
+		}
+	}
+
+	h->destroy(h);
+	free_mem(data);
+}
+
+/*! @brief
+ *   Check radix heap extracts in key order with decrease keys above the last key
+ *  @return NA
+ */
+void check_radix_heap()
+{
+	unsigned int keys[500], k, last;
+	bool in[500], done[500];
+	int i, j, r, hd, n;
+	t_radix_heap *h;
+
+	srand(5);
+	for (r = 0; r < 50; r++) {
+		n = 1 + rand() % 500;
+		h = create_radix_heap("check radix heap", n);
+		memset(in, 0, sizeof(in));
+		memset(done, 0, sizeof(done));
+		for (i = 0; i < n; i++) {
+			keys[i] = rand() % (1u << (rand() % 31));
+			if (rand() % 2) {
+				h->insert(h, i, keys[i]);
+				in[i] = true;
+			}
+		}
+
+		// keys added later are at least the last extracted key
+		last = 0;
+		while (h->empty(h) == false) {
+			hd = h->extract(h, &k);
+			CHECK(in[hd] && k == keys[hd] && k >= last, "round %d extract handle %d\n", r, hd);
+			for (i = 0; i < n; i++) {
+				CHECK(in[i] == false || keys[i] >= k, "round %d handle %d below min\n", r, i);
+			}
+			last = k;
+			in[hd] = false;
+			done[hd] = true;
+			for (j = 0; j < 3; j++) {
+				i = rand() % n;
+				if (in[i]) {
+					keys[i] = k + (keys[i] - k) / 2;
+					h->decrease_key(h, i, keys[i]);
+				} else if (done[i] == false) {
+					keys[i] = k + rand() % 1000;
+					h->insert(h, i, keys[i]);
+					in[i] = true;
+				}
+			}
+		}
+		h->destroy(h);
+	}
+}
+
+/*! @brief
+ *   Check dijkstra leaves a vertex past INT_MAX unreached and takes the
+ *   heap once a negative weight is added
+ *  @return NA
+ */
+void check_dijkstra_bounds()
+{
+	int ids[4] = {0, 1, 2, 3}, i;
+	t_distinfo *x1, *x2;
+	t_dparams dp;
+	t_graph *g;
+
+	init_data_params(&dp, eINT32);
+	dp.free = dummy_free;
+	g = create_graph("check dijkstra bounds", 4, &dp);
+	for (i = 0; i < 4; i++) {
+		g->ops->add_vertex(g, &ids[i]);
+	}
+	g->ops->add_wedge(g, &ids[0], &ids[1], INT_MAX - 5);
+	g->ops->add_wedge(g, &ids[1], &ids[2], 100);
+	g->ops->add_wedge(g, &ids[0], &ids[3], 7);
+	CHECK(g->has_negative == false, "negative weight without one added\n");
+
+	x1 = dijkstra(g, &ids[0]);
+	CHECK(x1[1].edge.weight == INT_MAX - 5 && x1[2].edge.weight == INT_MAX && x1[3].edge.weight == 7,
+		"dists %d %d %d\n", x1[1].edge.weight, x1[2].edge.weight, x1[3].edge.weight);
+	free_mem(x1);
+
+	// the flag stays once set, dijkstra then gives what the heap gives
+	g->ops->del_edge(g, &ids[1], &ids[2]);
+	g->ops->add_wedge(g, &ids[3], &ids[2], -1);
+	CHECK(g->has_negative, "negative weight not tracked\n");
+
+	x1 = dijkstra(g, &ids[0]);
+	x2 = dijkstra_heap(g, &ids[0]);
+	for (i = 0; i < 4; i++) {
+		CHECK(x1[i].edge.weight == x2[i].edge.weight, "dijkstra vertex %d\n", i);
+	}
+	CHECK(x1[2].edge.weight == 6, "dist %d expected 6\n", x1[2].edge.weight);
+	free_mem(x1);
+	free_mem(x2);
+
+	g->ops->destroy(g);
+}
+
+/*! @brief
+ *   Check heap sort and extract order of every heap layout against quick sort
+ *  @return NA
+ */
+void check_dary_heap()
+{
+	e_heaptype htypes[] = {eMIN_HEAP, eMAX_HEAP, eMIN_HEAP4, eMAX_HEAP4, eMIN_HEAP8, eMAX_HEAP8};
+	int *a, *ref, *data, i, j, v, n = 1000;
+	t_dparams dp;
+	t_heap *h;
+	bool max;
+
+	srand(7);
+	a = get_mem(n, sizeof(int));
+	ref = get_mem(n, sizeof(int));
+	data = get_mem(n, sizeof(int));
+	for (i = 0; i < n; i++) {
+		ref[i] = rand() % 500;
+	}
+	init_data_params(&dp, eINT32);
+	quick_sort(ref, n, &dp);
+
+	for (j = 0; j < 6; j++) {
+		max = (htypes[j] == eMAX_HEAP || htypes[j] == eMAX_HEAP4 || htypes[j] == eMAX_HEAP8);
+
+		// heap sort of a min heap leaves the array descending
+		for (i = 0; i < n; i++) {
+			a[i] = ref[(i * 37) % n];
+		}
+		dp.elem_size = 0;
+		h = create_heap("check heap sort", a, n, htypes[j], &dp);
+		h->sort(h);
+		for (i = 0; i < n; i++) {
+			CHECK(a[i] == ref[max? i : n - 1 - i], "heap type %d sort idx %d\n", htypes[j], i);
+		}
+		h->destroy(h);
+
+		dp.elem_size = sizeof(int);
+		h = create_heap("check heap order", data, n, htypes[j], &dp);
+		for (i = 0; i < n; i++) {
+			v = ref[(i * 37) % n];
+			h->insert(h, &v);
+		}
+		for (i = 0; i < n; i++) {
+			v = *(int*)h->extract(h);
+			CHECK(v == ref[max? n - 1 - i : i], "heap type %d extract %d\n", htypes[j], i);
+		}
+		h->destroy(h);
+	}
+
+	free_mem(a);
+	free_mem(ref);
+	free_mem(data);
+}
+
+/*! @brief
+ *   Check auto grow containers keep order across grows and shrinks
+ *  @return NA
+ */
+void check_grow()
+{
+	e_stacktype stypes[] = {eARRAY_STACK, eARRAY_STACK_DOWN, eLL_STACK};
+	int vals[5000], *data, i, j, n, v, next, expect, last;
+	t_dparams dp;
+	t_queue *q;
+	t_stack *s;
+	t_heap *h;
+
+	srand(11);
+	init_data_params(&dp, eINT32);
+	dp.elem_size = sizeof(int);
+	dp.auto_grow = true;
+	dp.shrink_div = 4;
+
+	// random runs of enq and deq wrap the ring before it grows
+	q = create_queue("check grow queue", 4, eARRAY_QUEUE_CIRC, &dp);
+	for (j = 0, next = 0, expect = 0; j < 2000; j++) {
+		for (i = 0, n = rand() % 7; i < n; i++, next++) {
+			q->enq(q, &next);
+		}
+		for (i = 0, n = rand() % 7; i < n && q->empty(q) == false; i++, expect++) {
+			v = *(int*)q->deq(q);
+			CHECK(v == expect, "queue deq %d expected %d\n", v, expect);
+		}
+	}
+	for (; q->empty(q) == false; expect++) {
+		v = *(int*)q->deq(q);
+		CHECK(v == expect, "queue deq %d expected %d\n", v, expect);
+	}
+	CHECK(expect == next, "queue deq %d of %d\n", expect, next);
+	q->destroy(q);
+
+	for (i = 0; i < 5000; i++) {
+		vals[i] = i;
+	}
+	for (j = 0; j < 3; j++) {
+		dp.elem_size = (stypes[j] == eLL_STACK)? 0 : sizeof(int);
+		s = create_stack("check grow stack", 3, stypes[j], &dp);
+		for (i = 0; i < 5000; i++) {
+			s->push(s, &vals[i]);
+		}
+		for (i = 4999; i >= 2000; i--) {
+			CHECK(*(int*)s->pop(s) == i, "stack type %d pop %d\n", stypes[j], i);
+		}
+		for (i = 2000; i < 3000; i++) {
+			s->push(s, &vals[i]);
+		}
+		for (i = 2999; i >= 0; i--) {
+			CHECK(*(int*)s->pop(s) == i, "stack type %d pop %d\n", stypes[j], i);
+		}
+		s->destroy(s);
+	}
+
+	// the heap array moves out of the user array on the first grow
+	dp.elem_size = sizeof(int);
+	data = get_mem(2, sizeof(int));
+	h = create_heap("check grow heap", data, 2, eMIN_HEAP4, &dp);
+	for (i = 0; i < 5000; i++) {
+		v = rand() % 1000;
+		h->insert(h, &v);
+	}
+	for (i = 0, last = -1; i < 5000; i++) {
+		v = *(int*)h->extract(h);
+		CHECK(v >= last, "heap extract %d after %d\n", v, last);
+		last = v;
+	}
+	CHECK(h->empty(h), "heap not empty\n");
+	h->destroy(h);
+
+	// sort covers only the elems held by a grown heap, min heap sorts
+	// descending, empty slots would show up as zeros between the elems
+	h = create_heap("check grow heap sort", data, 2, eMIN_HEAP, &dp);
+	for (i = 0; i < 10; i++) {
+		v = 50 - i * 11;
+		h->insert(h, &v);
+	}
+	h->sort(h);
+	for (i = 0; i < 10; i++) {
+		v = ((int*)h->data)[i];
+		CHECK(v == 50 - i * 11, "heap sort idx %d is %d\n", i, v);
+	}
+	h->destroy(h);
+
+	// an indexed heap is bound by its handles, plain insert must not grow it
+	h = create_indexed_heap("check grow indexed heap", data, 2, eMIN_HEAP, &dp);
+	for (i = 0; i < 2; i++) {
+		v = i;
+		h->insert_handle(h, i, &v);
+	}
+	logger_set_level("HEAP", __LOG_WARN__, false);
+	h->insert(h, &v);
+	logger_set_level("HEAP", __LOG_WARN__, true);
+	CHECK(h->size == 2 && h->count == 2, "indexed heap size %d count %d\n", h->size, h->count);
+	h->destroy(h);
+	free_mem(data);
+}
+
+/*! @brief
+ *   Check pairing heap extract, decrease key and meld against a brute force
+ *   min or max, and reuse of extracted nodes after a meld
+ *  @return NA
+ */
+void check_pairing_heap()
+{
+	static int keys[5000], live[5000];
+	static t_gen nodes[5000];
+	t_pairing_heap *a, *b, *x;
+	int i, t, r, op, best, next, ca, cb, n = 5000;
+	size_t total;
+	t_dparams dp;
+	t_gen p;
+	bool max;
+
+	// live is 0 when out, 1 in heap a and 2 in heap b
+	init_data_params(&dp, eINT32);
+	for (t = 0; t < 2; t++) {
+		srand(13 + t);
+		max = (t == 1);
+		a = create_pairing_heap("check pairing heap a", max? eMAX_HEAP : eMIN_HEAP, &dp);
+		b = create_pairing_heap("check pairing heap b", max? eMAX_HEAP : eMIN_HEAP, &dp);
+		memset(live, 0, sizeof(live));
+		for (op = 0, next = 0; op < 15000; op++) {
+			r = rand() % 5;
+			if (r < 2 && next < n) {
+				keys[next] = rand() % 100000;
+				x = (rand() % 2)? a : b;
+				nodes[next] = x->insert(x, &keys[next]);
+				live[next++] = (x == a)? 1 : 2;
+			} else if (r == 2 && next) {
+				i = rand() % next;
+				if (live[i]) {
+					keys[i] += max? rand() % 50 : -(rand() % 50);
+					x = (live[i] == 1)? a : b;
+					CHECK(x->decrease_key(x, nodes[i], NULL), "decrease key %d\n", i);
+				}
+			} else if (r == 3 && b->count && rand() % 20 == 0) {
+				a->meld(a, b);
+				for (i = 0; i < next; i++) {
+					live[i] = (live[i] == 2)? 1 : live[i];
+				}
+			} else if (r == 4 && a->empty(a) == false) {
+				for (i = 0, best = max? INT_MIN : INT_MAX; i < next; i++) {
+					if (live[i] == 1 && (max? keys[i] > best : keys[i] < best)) {
+						best = keys[i];
+					}
+				}
+				CHECK(*(int*)a->peek(a) == best, "peek %d expected %d\n", *(int*)a->peek(a), best);
+				i = (int*)a->extract(a) - keys;
+				CHECK(live[i] == 1 && keys[i] == best, "extract %d expected %d\n", keys[i], best);
+				live[i] = 0;
+			}
+		}
+		for (i = 0, ca = 0, cb = 0; i < next; i++) {
+			ca += (live[i] == 1);
+			cb += (live[i] == 2);
+		}
+		CHECK(ca == a->count && cb == b->count, "counts %d %d expected %d %d\n",
+			a->count, b->count, ca, cb);
+		a->destroy(a);
+		b->destroy(b);
+	}
+
+	// nodes extracted from the melded heap are reused by the heap melded into
+	dp.elem_size = sizeof(int);
+	a = create_pairing_heap("check pairing heap a", eMIN_HEAP, &dp);
+	b = create_pairing_heap("check pairing heap b", eMIN_HEAP, &dp);
+	for (i = 0; i < 1000; i++) {
+		keys[i] = rand();
+		a->insert(a, &keys[i]);
+		b->insert(b, &keys[i]);
+	}
+	for (i = 0; i < 800; i++) {
+		a->extract(a);
+		b->extract(b);
+	}
+	total = a->pool->total + b->pool->total;
+	a->meld(a, b);
+	for (i = 0; i < 1600; i++) {
+		a->insert(a, &keys[i]);
+	}
+	CHECK(a->pool->total == total, "pool grew from %zu to %zu\n", total, a->pool->total);
+	for (i = 0, best = INT_MIN; a->empty(a) == false; i++) {
+		p = a->extract(a);
+		CHECK(*(int*)p >= best, "extract %d after %d\n", *(int*)p, best);
+		best = *(int*)p;
+	}
+	CHECK(i == 2000, "extracted %d expected 2000\n", i);
+	a->destroy(a);
+	b->destroy(b);
+}
+
+/*! @brief
+ *   Check heap_top_k, streaming top k and nth_element against a full heap sort
+ *  @return NA
+ */
+void check_top_k()
+{
+	int *a, *b, *ref, *res, **pres, i, t, n, k, kk, m, range;
+	t_dparams dp;
+	t_top_k *s;
+	t_heap *h;
+
+	srand(19);
+	for (t = 0; t < 60; t++) {
+		n = 1 + rand() % 3000;
+		k = rand() % (n + 5);
+		kk = (k < n)? k : n;
+		range = (t % 3 == 0)? 5 : 100000;
+		a = get_mem(n, sizeof(int));
+		b = get_mem(n, sizeof(int));
+		ref = get_mem(n, sizeof(int));
+		for (i = 0; i < n; i++) {
+			a[i] = b[i] = ref[i] = rand() % range;
+		}
+
+		// heap sort of a min heap leaves the greatest first
+		init_data_params(&dp, eINT32);
+		h = create_heap("check top k ref", ref, n, eMIN_HEAP, &dp);
+		h->sort(h);
+		h->destroy(h);
+
+		CHECK(heap_top_k(a, n, k, &dp) == kk, "round %d heap_top_k count\n", t);
+		for (i = 0; i < kk; i++) {
+			CHECK(a[i] == ref[i], "round %d heap_top_k idx %d\n", t, i);
+		}
+
+		dp.elem_size = sizeof(int);
+		s = create_top_k("check top k", k, &dp);
+		for (i = 0; i < n; i++) {
+			s->add(s, &b[i]);
+		}
+		CHECK(s->len(s) == kk, "round %d top k len %d\n", t, s->len(s));
+		CHECK(kk < k || k == 0 || *(int*)s->threshold(s) == ref[k - 1], "round %d threshold\n", t);
+		res = s->result(s);
+		for (i = 0; i < kk; i++) {
+			CHECK(res[i] == ref[i], "round %d top k idx %d\n", t, i);
+		}
+		if (res != NULL) {
+			free_mem(res);
+		}
+		s->destroy(s);
+
+		dp.elem_size = 0;
+		s = create_top_k("check top k ptr", k, &dp);
+		for (i = 0; i < n; i++) {
+			s->add(s, &b[i]);
+		}
+		pres = s->result(s);
+		for (i = 0; i < kk; i++) {
+			CHECK(*pres[i] == ref[i], "round %d top k ptr idx %d\n", t, i);
+		}
+		if (pres != NULL) {
+			free_mem(pres);
+		}
+		s->destroy(s);
+
+		// mth least is at m, nothing greater before nor less after it
+		m = rand() % n;
+		nth_element(b, n, m, &dp);
+		CHECK(b[m] == ref[n - 1 - m], "round %d nth_element %d\n", t, m);
+		for (i = 0; i < n; i++) {
+			CHECK((i < m)? b[i] <= b[m] : b[i] >= b[m], "round %d nth_element idx %d\n", t, i);
+		}
+
+		free_mem(a);
+		free_mem(b);
+		free_mem(ref);
+	}
+}
@@ -21,23 +21,33 @@ void test_heap();
 void test_queue();
 void test_stack();
 void test_linklist();
+void run_benchmarks(int argc, char *argv[]);
+int run_checks();
 
 /*! @brief  
  *   Main Driver test
  *  @param argc - Count cmd line arguments
  *  @param argv - Pointer to cmd line arguments
- *  @return 	- 0 on succesfull exit
+ *  @return 	- 0 on succesfull exit, 1 if a correctness check failed
  */
 int main(int argc, char *argv[])
 {
 	size_t size = 0;
 	int *ptr[100];
-	int i;	
+	int i, failed;	
 
 	mem_init();
 	logger_init();
 	fault_manager_init(NULL);
 
+	// Run benchmarks instead of tests
+	if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+		run_benchmarks(argc, argv);
+		logger_finit();
+		mem_finit();
+		return 0;
+	}
+
 	for (i = 0; i < 100; i ++) {
 		ptr[i] = (int *)get_mem(1, sizeof(int));
 		size += sizeof(*(ptr[i]));
@@ -64,8 +74,17 @@ int main(int argc, char *argv[])
 	test_graph();
 	test_array();
 
+	// Results of the containers checked against reference results
+	failed = run_checks();
+
+	logger_finit();
 	mem_finit();
 
+	if (failed) {
+		fprintf(stderr, "FAILED: %d correctness checks, see CHECK logs\n", failed);
+		return 1;
+	}
+
 	return 0;
 
 }
@@ -189,26 +208,26 @@ void test_linklist()
 	// Add elements to link list (add elemnts to begining)
 	for (i = 0; i < 3; i++) {
 		c= 'c' + i;
-		l2->add(l2, assign_char(c));
+		l2->ops->add(l2, assign_char(c));
 
-		l1->add(l1, assign_int(i));
+		l1->ops->add(l1, assign_int(i));
 
 		f= (float)i+0.222 / 2.0f;
-		l3->add(l3, assign_float(f));
-		l5->add(l5, assign_float(f));
+		l3->ops->add(l3, assign_float(f));
+		l5->ops->add(l5, assign_float(f));
 
-		l4->add(l4, assign_string(str[i]));
+		l4->ops->add(l4, assign_string(str[i]));
 	}
 	// print elements of link list
-	l1->print(l1);
-	l2->print(l2);
-	l3->print(l3);
-	l4->print(l4);
-	l5->print(l5);
+	l1->ops->print(l1);
+	l2->ops->print(l2);
+	l3->ops->print(l3);
+	l4->ops->print(l4);
+	l5->ops->print(l5);
 
 	// find an element in the link list 
 	t_gen tmp;
-	tmp =	l4->find(l4, "SEe");
+	tmp =	l4->ops->find(l4, "SEe");
   	if (tmp != NULL) {
 		printf("Data present \n");
 	}
@@ -220,97 +239,97 @@ void test_linklist()
 	LOG_INFO("TEST", "deleting nodes in link list\n");
 	for (i = 0; i < 3; i++) {
 		c= 'c' + i;
-		cp = l2->del(l2, &c);
+		cp = l2->ops->del(l2, &c);
 		free_mem(cp);
 
-		ip = l1->del(l1, &i);
+		ip = l1->ops->del(l1, &i);
 		free_mem(ip);
 
 		f= (float)i+0.222 / 2.0f;
-		fp = l3->del(l3, &f);
+		fp = l3->ops->del(l3, &f);
 		free_mem(fp);
 
-		sp = l4->del(l4, &str[i]);
+		sp = l4->ops->del(l4, &str[i]);
 		free_mem(sp);
 
-		fp = l5->del(l5, &f);
+		fp = l5->ops->del(l5, &f);
 		free_mem(fp);
 	}
 	// print elements of link list
-	l1->print(l1);
-	l2->print(l2);
-	l3->print(l3);
-	l4->print(l4);
-	l5->print(l5);
+	l1->ops->print(l1);
+	l2->ops->print(l2);
+	l3->ops->print(l3);
+	l4->ops->print(l4);
+	l5->ops->print(l5);
 
 	// Add elements to link list (add elemnts to tail of link list)
 	for (i = 0; i < 3; i++) {
 		c= 'c' + i;
-		l2->append(l2, assign_char(c));
+		l2->ops->append(l2, assign_char(c));
 
-		l1->append(l1, assign_int(i));
+		l1->ops->append(l1, assign_int(i));
 
 		f= (float)i+0.222 / 2.0f;
-		l3->append(l3, assign_float(f));
+		l3->ops->append(l3, assign_float(f));
 
-		l4->append(l4, assign_string(str[i]));
-		l5->append(l5, assign_float(f));
+		l4->ops->append(l4, assign_string(str[i]));
+		l5->ops->append(l5, assign_float(f));
 	}
 	// print elements of link list
-	l1->print(l1);
-	l2->print(l2);
-	l3->print(l3);
-	l4->print(l4);
-	l5->print(l5);
+	l1->ops->print(l1);
+	l2->ops->print(l2);
+	l3->ops->print(l3);
+	l4->ops->print(l4);
+	l5->ops->print(l5);
 
 	// Add elements to link list (add elemnts to head of link list)
 	for (i = 3; i < 13; i++) {
 		c= 'c' + i;
-		l2->add(l2, assign_char(c));
+		l2->ops->add(l2, assign_char(c));
 
-		l1->add(l1, assign_int(i));
+		l1->ops->add(l1, assign_int(i));
 
 		f= (float)i+0.222 / 2.0f;
-		l3->add(l3, assign_float(f));
-		l5->add(l5, assign_float(f));
+		l3->ops->add(l3, assign_float(f));
+		l5->ops->add(l5, assign_float(f));
 	}
 	// print elements of link list
-	l1->print(l1);
-	l2->print(l2);
-	l3->print(l3);
-	l4->print(l4);
-	l5->print(l5);
+	l1->ops->print(l1);
+	l2->ops->print(l2);
+	l3->ops->print(l3);
+	l4->ops->print(l4);
+	l5->ops->print(l5);
 
 	// Delete the node at idx 'i'th index
 	for (i = 2; i >= 0; i--) {
-		cp = l2->del_idx(l2, i);
+		cp = l2->ops->del_idx(l2, i);
 		free_mem(cp);
 
-		ip = l1->del_idx(l1, i);
+		ip = l1->ops->del_idx(l1, i);
 		free_mem(ip);
 
-		fp = l3->del_idx(l3, i);
+		fp = l3->ops->del_idx(l3, i);
 		free_mem(fp);
 
-		sp = l4->del_idx(l4, i);
+		sp = l4->ops->del_idx(l4, i);
 		free_mem(sp);
 		
-		fp = l5->del_idx(l5, i);
+		fp = l5->ops->del_idx(l5, i);
 		free_mem(fp);
 	}
 	// print elements of link list
-	l1->print(l1);
-	l2->print(l2);
-	l3->print(l3);
-	l4->print(l4);
-	l5->print(l5);
+	l1->ops->print(l1);
+	l2->ops->print(l2);
+	l3->ops->print(l3);
+	l4->ops->print(l4);
+	l5->ops->print(l5);
 
 	// Destroy link list
-	l1->destroy(l1);
-	l2->destroy(l2);
-	l3->destroy(l3);
-	l4->destroy(l4);
-	l5->destroy(l5);
+	l1->ops->destroy(l1);
+	l2->ops->destroy(l2);
+	l3->ops->destroy(l3);
+	l4->ops->destroy(l4);
+	l5->ops->destroy(l5);
 }
 
 /*! @brief  
@@ -637,36 +656,36 @@ void test_graph()
 	g5 = create_graph("Graph 5", 10, &dp);
 
 	// Create symmetric edges between vertices
-	g1->add_wedge_sym(g1, city[0], city[1], 420);   
-	g1->add_wedge_sym(g1, city[1], city[2], 1234);   
-	g1->add_wedge(g1, city[2], city[0], 1000);   
-	g1->wprint(g1);
+	g1->ops->add_wedge_sym(g1, city[0], city[1], 420);   
+	g1->ops->add_wedge_sym(g1, city[1], city[2], 1234);   
+	g1->ops->add_wedge(g1, city[2], city[0], 1000);   
+	g1->ops->wprint(g1);
 
 	// Check whether the edge between two vertices exist?
-	if (g1->has_edge(g1, city[0], city[2]) == NULL) {
+	if (g1->ops->has_edge(g1, city[0], city[2]) == NULL) {
 		printf("%s not linked to %s\n",city[0],city[1]);
 	} else {
 		printf("%s linked to %s\n",city[0],city[1]);
 	} 
 
 	// Delete the directed edge between two nodes
-	g1->del_edge(g1, city[0], city[1]);  
+	g1->ops->del_edge(g1, city[0], city[1]);  
 
 	// Delete an undirected edge between two nodes
-	g1->del_edge_sym(g1, city[2], city[1]);  
-	g1->wprint(g1);
+	g1->ops->del_edge_sym(g1, city[2], city[1]);  
+	g1->ops->wprint(g1);
 
 	// Delete a Vertex from graph
-	g1->del_vertex(g1, city[2]);
-	g1->wprint(g1);
+	g1->ops->del_vertex(g1, city[2]);
+	g1->ops->wprint(g1);
 
-	if (g1->find(g1, city[2]) == NULL) {
+	if (g1->ops->find(g1, city[2]) == NULL) {
 		printf("%s not present in graph\n",city[2]);
 	} else {
 		printf("%s present in graph\n",city[2]);
 	} 
 	// weighted print graph
-	g1->wprint(g1);
+	g1->ops->wprint(g1);
 
 	printf("**************\n");
 
@@ -674,28 +693,28 @@ void test_graph()
 
 	// Add nodes to graph
 	for (i = 0; i < 12; i++) {
-		g3->add_vertex(g3, &a1[i]);   
+		g3->ops->add_vertex(g3, &a1[i]);   
 	}
 
 	// Create symmetric edges between vertices
-	g3->add_edge_sym(g3, &a1[0], &a1[1]);   
-	g3->add_edge_sym(g3, &a1[0], &a1[4]);   
-	g3->add_edge_sym(g3, &a1[4], &a1[8]);   
-	g3->add_edge_sym(g3, &a1[4], &a1[9]);   
-	g3->add_edge_sym(g3, &a1[2], &a1[3]);   
-	g3->add_edge_sym(g3, &a1[2], &a1[6]);   
-	g3->add_edge_sym(g3, &a1[2], &a1[7]);   
-	g3->add_edge_sym(g3, &a1[3], &a1[7]);   
-	g3->add_edge_sym(g3, &a1[6], &a1[7]);   
-	g3->add_edge_sym(g3, &a1[6], &a1[10]);   
-	g3->add_edge_sym(g3, &a1[7], &a1[10]);   
-	g3->add_edge_sym(g3, &a1[7], &a1[11]);   
-	g3->add_edge_sym(g3, &a1[8], &a1[9]);   
-	g3->print(g3);
+	g3->ops->add_edge_sym(g3, &a1[0], &a1[1]);   
+	g3->ops->add_edge_sym(g3, &a1[0], &a1[4]);   
+	g3->ops->add_edge_sym(g3, &a1[4], &a1[8]);   
+	g3->ops->add_edge_sym(g3, &a1[4], &a1[9]);   
+	g3->ops->add_edge_sym(g3, &a1[2], &a1[3]);   
+	g3->ops->add_edge_sym(g3, &a1[2], &a1[6]);   
+	g3->ops->add_edge_sym(g3, &a1[2], &a1[7]);   
+	g3->ops->add_edge_sym(g3, &a1[3], &a1[7]);   
+	g3->ops->add_edge_sym(g3, &a1[6], &a1[7]);   
+	g3->ops->add_edge_sym(g3, &a1[6], &a1[10]);   
+	g3->ops->add_edge_sym(g3, &a1[7], &a1[10]);   
+	g3->ops->add_edge_sym(g3, &a1[7], &a1[11]);   
+	g3->ops->add_edge_sym(g3, &a1[8], &a1[9]);   
+	g3->ops->print(g3);
 	
 	// Run BFS on GRAPH
 	printf("- BFS -\n");
-	bfs  = g3->bfs(g3, &a1[0]);
+	bfs  = g3->ops->bfs(g3, &a1[0]);
 
 	// Display the BFS Tree
 	for(i = 0; i < 12; i++) {
@@ -707,7 +726,7 @@ void test_graph()
 	
 	// Run DFS on GRAPH
 	printf("- DFS -\n");
-	dfs  = g3->dfs(g3, &a1[0]);
+	dfs  = g3->ops->dfs(g3, &a1[0]);
 
 	// Display the DFS Tree
 	for(i = 0; i < 12; i++) {
@@ -719,25 +738,25 @@ void test_graph()
 
 	// Add nodes to graph
 	for (i = 0; i < 8; i++) {
-		g4->add_vertex(g4, &a2[i]);   
+		g4->ops->add_vertex(g4, &a2[i]);   
 	}
 	
 	// Create asymmetric edges
-	g4->add_edge(g4, &a2[0], &a2[2]);   
-	g4->add_edge(g4, &a2[0], &a2[3]);   
-	g4->add_edge(g4, &a2[0], &a2[4]);   
-	g4->add_edge(g4, &a2[1], &a2[2]);   
-	g4->add_edge(g4, &a2[1], &a2[7]);   
-	g4->add_edge(g4, &a2[2], &a2[5]);   
-	g4->add_edge(g4, &a2[3], &a2[7]);   
-	g4->add_edge(g4, &a2[3], &a2[5]);   
-	g4->add_edge(g4, &a2[4], &a2[7]);   
-	g4->add_edge(g4, &a2[5], &a2[6]);   
-	g4->add_edge(g4, &a2[6], &a2[7]);   
-	g4->print(g4);
+	g4->ops->add_edge(g4, &a2[0], &a2[2]);   
+	g4->ops->add_edge(g4, &a2[0], &a2[3]);   
+	g4->ops->add_edge(g4, &a2[0], &a2[4]);   
+	g4->ops->add_edge(g4, &a2[1], &a2[2]);   
+	g4->ops->add_edge(g4, &a2[1], &a2[7]);   
+	g4->ops->add_edge(g4, &a2[2], &a2[5]);   
+	g4->ops->add_edge(g4, &a2[3], &a2[7]);   
+	g4->ops->add_edge(g4, &a2[3], &a2[5]);   
+	g4->ops->add_edge(g4, &a2[4], &a2[7]);   
+	g4->ops->add_edge(g4, &a2[5], &a2[6]);   
+	g4->ops->add_edge(g4, &a2[6], &a2[7]);   
+	g4->ops->print(g4);
 	
 	printf("- DAGS Sorting and Longest Path -\n");
-	dag = g4->topo_order_dag(g4);
+	dag = g4->ops->topo_order_dag(g4);
 
 	// Display the longest path and ordered/sorted edges of the DAG
 	for(i = 0; i < 8; i++) {
@@ -749,19 +768,19 @@ void test_graph()
 
 	// Add nodes to graph
 	for (i = 0; i < 10; i++) {
-		g2->add_vertex(g2, &num[i]);   
+		g2->ops->add_vertex(g2, &num[i]);   
 	}
 
 	// Create symmetric weighted edges
-	g2->add_wedge_sym(g2, &num[0], &num[1], 10);   
-	g2->add_wedge_sym(g2, &num[0], &num[2], 80);   
-	g2->add_wedge_sym(g2, &num[1], &num[2], 6);   
-	g2->add_wedge_sym(g2, &num[2], &num[3], 70);   
-	g2->add_wedge_sym(g2, &num[1], &num[4], 20);   
-	g2->add_wedge_sym(g2, &num[4], &num[5], 50);   
-	g2->add_wedge_sym(g2, &num[4], &num[6], 10);   
-	g2->add_wedge_sym(g2, &num[5], &num[6], 5);   
-	g2->wprint(g2);
+	g2->ops->add_wedge_sym(g2, &num[0], &num[1], 10);   
+	g2->ops->add_wedge_sym(g2, &num[0], &num[2], 80);   
+	g2->ops->add_wedge_sym(g2, &num[1], &num[2], 6);   
+	g2->ops->add_wedge_sym(g2, &num[2], &num[3], 70);   
+	g2->ops->add_wedge_sym(g2, &num[1], &num[4], 20);   
+	g2->ops->add_wedge_sym(g2, &num[4], &num[5], 50);   
+	g2->ops->add_wedge_sym(g2, &num[4], &num[6], 10);   
+	g2->ops->add_wedge_sym(g2, &num[5], &num[6], 5);   
+	g2->ops->wprint(g2);
 
 	// Run Dijkstra's algo for src node '1'
 	printf("* Dijkstra's Algo *\n");
@@ -805,22 +824,22 @@ void test_graph()
 
 	// Add nodes to graph
 	for (i = 0; i < 10; i++) {
-		g5->add_vertex(g5, &a3[i]);   
+		g5->ops->add_vertex(g5, &a3[i]);   
 	}
 
 	// Add nodes to graph
-	g5->add_wedge(g5, &a3[0], &a3[1], 10);   
-	g5->add_wedge(g5, &a3[0], &a3[7], 8);   
-	g5->add_wedge(g5, &a3[1], &a3[5], 2);   
-	g5->add_wedge(g5, &a3[2], &a3[1], 1);   
-	g5->add_wedge(g5, &a3[2], &a3[3], 1);   
-	g5->add_wedge(g5, &a3[3], &a3[4], 3);   
-	g5->add_wedge(g5, &a3[4], &a3[5], -1);   
-	g5->add_wedge(g5, &a3[5], &a3[2], -2);   
-	g5->add_wedge(g5, &a3[6], &a3[5], -1);   
-	g5->add_wedge(g5, &a3[6], &a3[1], -4);   
-	g5->add_wedge(g5, &a3[7], &a3[6], 1);   
-	g5->wprint(g5);
+	g5->ops->add_wedge(g5, &a3[0], &a3[1], 10);   
+	g5->ops->add_wedge(g5, &a3[0], &a3[7], 8);   
+	g5->ops->add_wedge(g5, &a3[1], &a3[5], 2);   
+	g5->ops->add_wedge(g5, &a3[2], &a3[1], 1);   
+	g5->ops->add_wedge(g5, &a3[2], &a3[3], 1);   
+	g5->ops->add_wedge(g5, &a3[3], &a3[4], 3);   
+	g5->ops->add_wedge(g5, &a3[4], &a3[5], -1);   
+	g5->ops->add_wedge(g5, &a3[5], &a3[2], -2);   
+	g5->ops->add_wedge(g5, &a3[6], &a3[5], -1);   
+	g5->ops->add_wedge(g5, &a3[6], &a3[1], -4);   
+	g5->ops->add_wedge(g5, &a3[7], &a3[6], 1);   
+	g5->ops->wprint(g5);
 
 	// Bellman Ford shortest path src node as 0
 	dist = bellman_ford(g5, &a3[0]);
@@ -836,11 +855,11 @@ void test_graph()
 	free_mem(dist);
 
 	// destroy graph
-	g1->destroy(g1);
-	g2->destroy(g2);
-	g3->destroy(g3);
-	g4->destroy(g4);
-	g5->destroy(g5);
+	g1->ops->destroy(g1);
+	g2->ops->destroy(g2);
+	g3->ops->destroy(g3);
+	g4->ops->destroy(g4);
+	g5->ops->destroy(g5);
 }
 
 /*! @brief  
@@ -0,0 +1,28 @@
+/*! @file log_decode.c
+    @brief 
+    Offline decoder of binary log files, prints them as text
+    Run as "log_decode.out <binary log file>"
+*/
+
+#include "common.h"
+
+/*! @brief  
+ *   Decode a binary log file to stdout
+ *  @param argc - Count cmd line arguments
+ *  @param argv - Pointer to cmd line arguments (argv[1] is the file)
+ *  @return 	- 0 on succesfull exit
+ */
+int main(int argc, char *argv[])
+{
+	if (argc != 2) {
+		fprintf(stderr, "usage: %s <binary log file>\n", argv[0]);
+		return 1;
+	}
+
+	if (logger_decode(argv[1], stdout) < 0) {
+		fprintf(stderr, "%s: not a binary log file\n", argv[1]);
+		return 1;
+	}
+
+	return 0;
+}